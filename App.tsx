@@ -1,4 +1,4 @@
-import React, { useEffect } from 'react';
+import React, { useEffect, Profiler, ProfilerOnRenderCallback } from 'react';
 import { StatusBar } from 'expo-status-bar';
 import { SafeAreaProvider } from 'react-native-safe-area-context';
 import { GestureHandlerRootView } from 'react-native-gesture-handler';
@@ -9,6 +9,17 @@ import AppNavigator from './src/navigation/AppNavigator';
 import { useStore } from './src/store';
 import { enableDebugLogging } from './src/utils/debugHelper';
 import { ThemeProvider } from './src/theme/ThemeContext';
+import { jankWatchdog } from './src/utils/jankWatchdog';
+import { tracing } from './src/utils/tracing';
+import { userActivity } from './src/services/scheduler/UserActivity';
+
+// Commits slower than a frame become render spans the jank watchdog can blame
+// (the Profiler only reports in development and profiling builds)
+const handleRender: ProfilerOnRenderCallback = (id, phase, actualDuration, baseDuration, startTime) => {
+  if (actualDuration >= 16) {
+    tracing.recordSpan(`render:${id}`, startTime, startTime + actualDuration, { phase });
+  }
+};
 
 export default function App() {
   // Initialize audio session on app start
@@ -32,13 +43,20 @@ export default function App() {
     
     // Enable debug logging for troubleshooting
     enableDebugLogging();
+    
+    // Measure event-loop lag and dropped frames
+    jankWatchdog.start();
+    return () => jankWatchdog.stop();
   }, []);
 
+  // Any touch counts as activity; onTouchStart sees touches without claiming the responder
   return (
-    <GestureHandlerRootView style={{ flex: 1 }}>
+    <GestureHandlerRootView style={{ flex: 1 }} onTouchStart={() => userActivity.markActive()}>
       <SafeAreaProvider>
         <ThemeProvider>
-          <AppNavigator />
+          <Profiler id="app" onRender={handleRender}>
+            <AppNavigator />
+          </Profiler>
           <StatusBar style="auto" />
         </ThemeProvider>
       </SafeAreaProvider>
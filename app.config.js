@@ -26,6 +26,16 @@ export default {
     favicon: "./assets/favicon.png"
   },
   scheme: "sonora",
+  plugins: [
+    [
+      "expo-media-library",
+      {
+        // The device library provider only reads audio
+        isAccessMediaLocationEnabled: false,
+        granularPermissions: ["audio"]
+      }
+    ]
+  ],
   expo: {
     scheme: "sonora",
     extra: {
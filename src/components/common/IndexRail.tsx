@@ -0,0 +1,88 @@
+/**
+ * Index Rail Component
+ * Vertical strip of section letters that jumps a list as a finger slides over it
+ */
+
+import React, { useRef, useState } from 'react';
+import { View, Text, StyleSheet, GestureResponderEvent } from 'react-native';
+import { useTheme } from '../../theme/ThemeContext';
+
+interface IndexRailProps {
+  labels: string[];
+  onSelect: (index: number) => void;
+  top?: number;
+  bottom?: number;
+}
+
+const IndexRail = ({ labels, onSelect, top = 8, bottom = 8 }: IndexRailProps) => {
+  const { theme } = useTheme();
+  const [height, setHeight] = useState(0);
+  const [activeIndex, setActiveIndex] = useState<number | null>(null);
+  const lastIndex = useRef<number | null>(null);
+  
+  // Map the touch to a label by position, and only jump when it moves onto another one
+  const handleTouch = (event: GestureResponderEvent) => {
+    if (height === 0 || labels.length === 0) return;
+    
+    const position = event.nativeEvent.locationY / height;
+    const index = Math.max(0, Math.min(labels.length - 1, Math.floor(position * labels.length)));
+    if (index !== lastIndex.current) {
+      lastIndex.current = index;
+      setActiveIndex(index);
+      onSelect(index);
+    }
+  };
+  
+  const handleRelease = () => {
+    lastIndex.current = null;
+    setActiveIndex(null);
+  };
+  
+  return (
+    <View
+      style={[styles.rail, { top, bottom }]}
+      onLayout={event => setHeight(event.nativeEvent.layout.height)}
+      onStartShouldSetResponder={() => true}
+      onMoveShouldSetResponder={() => true}
+      onResponderGrant={handleTouch}
+      onResponderMove={handleTouch}
+      onResponderRelease={handleRelease}
+      onResponderTerminate={handleRelease}
+    >
+      {/* Letters ignore touches so locationY is always relative to the rail */}
+      <View style={styles.labels} pointerEvents="none">
+        {labels.map((label, index) => (
+          <Text
+            key={label}
+            style={[
+              styles.label,
+              { color: index === activeIndex ? theme.text : theme.primary }
+            ]}
+          >
+            {label}
+          </Text>
+        ))}
+      </View>
+    </View>
+  );
+};
+
+const styles = StyleSheet.create({
+  rail: {
+    position: 'absolute',
+    right: 0,
+    width: 24,
+    justifyContent: 'center',
+  },
+  labels: {
+    flex: 1,
+    justifyContent: 'space-evenly',
+    alignItems: 'center',
+  },
+  label: {
+    fontSize: 11,
+    fontWeight: '600',
+  },
+});
+
+export default IndexRail;
\ No newline at end of file
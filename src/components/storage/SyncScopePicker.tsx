@@ -0,0 +1,312 @@
+/**
+ * Sync Scope Picker Component
+ * Browses OneDrive folders and sets which of them a sync includes or excludes
+ */
+
+import React, { useCallback, useEffect, useMemo, useRef, useState } from 'react';
+import { View, Text, StyleSheet, TouchableOpacity, ActivityIndicator, FlatList, Modal, Alert } from 'react-native';
+import { Ionicons } from '@expo/vector-icons';
+import { useSafeAreaInsets } from 'react-native-safe-area-context';
+
+import { OneDriveStorageProvider, DriveFolderPage } from '../../services/storage/OneDriveStorageProvider';
+import {
+  DriveFolder,
+  SyncScopeRule,
+  getEffectiveRules,
+  findGoverningRule,
+  estimateSyncScope
+} from '../../services/storage/SyncScopes';
+import { formatFileSize } from '../../utils/formatters';
+import { logger } from '../../utils/logger';
+import { useTheme } from '../../theme/ThemeContext';
+
+interface SyncScopePickerProps {
+  visible: boolean;
+  provider: OneDriveStorageProvider;
+  onClose: () => void;
+  onSaved: () => void;
+}
+
+const ROOT_KEY = 'root';
+
+const SyncScopePicker = ({ visible, provider, onClose, onSaved }: SyncScopePickerProps) => {
+  const { theme } = useTheme();
+  const insets = useSafeAreaInsets();
+  const [trail, setTrail] = useState<DriveFolder[]>([]);
+  const [page, setPage] = useState<DriveFolderPage>({ folders: [], nextLink: null });
+  const [loading, setLoading] = useState(false);
+  const [saving, setSaving] = useState(false);
+  const [rules, setRules] = useState<SyncScopeRule[]>([]);
+  const [defaultFolders, setDefaultFolders] = useState<DriveFolder[]>([]);
+  
+  // Listings already fetched while the picker is open, so going back is instant
+  const pageCache = useRef<Map<string, DriveFolderPage>>(new Map());
+  const currentKey = useRef(ROOT_KEY);
+  
+  const loadFolder = useCallback(async (folder: DriveFolder | null, nextLink: string | null = null) => {
+    const key = folder ? folder.id : ROOT_KEY;
+    currentKey.current = key;
+    
+    const cached = pageCache.current.get(key);
+    if (cached && !nextLink) {
+      setPage(cached);
+      return;
+    }
+    
+    try {
+      setLoading(true);
+      const next = await provider.listDriveFolders(folder ? folder.id : null, nextLink);
+      const merged = {
+        folders: nextLink ? [...(cached?.folders ?? []), ...next.folders] : next.folders,
+        nextLink: next.nextLink
+      };
+      pageCache.current.set(key, merged);
+      
+      // The user may have moved on while this page loaded
+      if (currentKey.current === key) {
+        setPage(merged);
+      }
+    } catch (error) {
+      logger.error('Error listing OneDrive folders', error);
+      Alert.alert('Error', 'Failed to list OneDrive folders');
+    } finally {
+      setLoading(false);
+    }
+  }, [provider]);
+  
+  // Start from the drive root with the saved rules each time the picker opens
+  useEffect(() => {
+    if (!visible) return;
+    
+    pageCache.current.clear();
+    setTrail([]);
+    setPage({ folders: [], nextLink: null });
+    setRules(provider.getSyncScopes());
+    loadFolder(null);
+    
+    provider.getDefaultSyncFolders()
+      .then(setDefaultFolders)
+      .catch(error => logger.warn('Failed to find the default OneDrive folders', error));
+  }, [visible, provider, loadFolder]);
+  
+  const effectiveRules = useMemo(() => getEffectiveRules(rules, defaultFolders), [rules, defaultFolders]);
+  const estimate = useMemo(() => estimateSyncScope(effectiveRules), [effectiveRules]);
+  
+  const openFolder = (folder: DriveFolder) => {
+    setTrail([...trail, folder]);
+    loadFolder(folder);
+  };
+  
+  const openTrail = (depth: number) => {
+    const nextTrail = trail.slice(0, depth);
+    setTrail(nextTrail);
+    loadFolder(nextTrail.length > 0 ? nextTrail[nextTrail.length - 1] : null);
+  };
+  
+  const loadMore = () => {
+    if (loading || !page.nextLink) return;
+    loadFolder(trail.length > 0 ? trail[trail.length - 1] : null, page.nextLink);
+  };
+  
+  // Cycle a folder through no rule, included and excluded
+  const toggleRule = (folder: DriveFolder) => {
+    const existing = rules.find(rule => rule.id === folder.id);
+    const others = rules.filter(rule => rule.id !== folder.id);
+    if (!existing) {
+      setRules([...others, { ...folder, mode: 'include' }]);
+    } else if (existing.mode === 'include') {
+      setRules([...others, { ...folder, mode: 'exclude' }]);
+    } else {
+      setRules(others);
+    }
+  };
+  
+  const handleSave = async () => {
+    try {
+      setSaving(true);
+      await provider.setSyncScopes(rules);
+      onSaved();
+    } catch (error) {
+      logger.error('Error saving OneDrive sync scopes', error);
+      Alert.alert('Error', 'Failed to save sync folders');
+    } finally {
+      setSaving(false);
+    }
+  };
+  
+  const renderFolder = ({ item }: { item: DriveFolder }) => {
+    const explicit = rules.find(rule => rule.id === item.id);
+    const governing = findGoverningRule(item.path, effectiveRules);
+    const synced = governing?.mode === 'include';
+    
+    let status = '';
+    if (explicit) {
+      status = explicit.mode === 'include' ? 'Included' : 'Excluded';
+    } else if (governing) {
+      status = synced ? 'Synced' : 'Not synced';
+    }
+    
+    return (
+      <View style={[styles.folderRow, { borderBottomColor: theme.border }]}>
+        <TouchableOpacity style={styles.folderInfo} onPress={() => openFolder(item)}>
+          <Ionicons name="folder-outline" size={22} color={synced ? theme.primary : theme.textSecondary} />
+          <View style={styles.folderText}>
+            <Text style={[styles.folderName, { color: theme.text }]} numberOfLines={1}>{item.name}</Text>
+            <Text style={[styles.folderDetails, { color: theme.textSecondary }]} numberOfLines={1}>
+              {item.childCount} items · {formatFileSize(item.size)}{status ? ` · ${status}` : ''}
+            </Text>
+          </View>
+        </TouchableOpacity>
+        
+        <TouchableOpacity style={styles.ruleButton} onPress={() => toggleRule(item)}>
+          <Ionicons
+            name={!explicit ? 'ellipse-outline' : explicit.mode === 'include' ? 'checkmark-circle' : 'remove-circle'}
+            size={26}
+            color={!explicit ? theme.textSecondary : explicit.mode === 'include' ? theme.primary : 'red'}
+          />
+        </TouchableOpacity>
+      </View>
+    );
+  };
+  
+  return (
+    <Modal visible={visible} animationType="slide" onRequestClose={onClose}>
+      <View style={[styles.container, { backgroundColor: theme.background, paddingTop: insets.top }]}>
+        <View style={[styles.header, { borderBottomColor: theme.border }]}>
+          <TouchableOpacity onPress={onClose} style={styles.headerButton}>
+            <Text style={[styles.headerButtonText, { color: theme.primary }]}>Cancel</Text>
+          </TouchableOpacity>
+          <Text style={[styles.headerTitle, { color: theme.text }]}>Sync Folders</Text>
+          <TouchableOpacity onPress={handleSave} style={styles.headerButton} disabled={saving}>
+            {saving ? (
+              <ActivityIndicator size="small" color={theme.primary} />
+            ) : (
+              <Text style={[styles.headerButtonText, { color: theme.primary }]}>Save</Text>
+            )}
+          </TouchableOpacity>
+        </View>
+        
+        <View style={styles.trail}>
+          <TouchableOpacity onPress={() => openTrail(0)}>
+            <Text style={[styles.trailText, { color: theme.primary }]}>OneDrive</Text>
+          </TouchableOpacity>
+          {trail.map((folder, index) => (
+            <TouchableOpacity key={folder.id} onPress={() => openTrail(index + 1)}>
+              <Text style={[styles.trailText, { color: index === trail.length - 1 ? theme.text : theme.primary }]}>
+                {' › '}{folder.name}
+              </Text>
+            </TouchableOpacity>
+          ))}
+        </View>
+        
+        <FlatList
+          data={page.folders}
+          keyExtractor={item => item.id}
+          renderItem={renderFolder}
+          onEndReached={loadMore}
+          onEndReachedThreshold={0.5}
+          ListEmptyComponent={loading ? null : (
+            <Text style={[styles.emptyText, { color: theme.textSecondary }]}>No folders here</Text>
+          )}
+          ListFooterComponent={loading ? <ActivityIndicator style={styles.loader} color={theme.primary} /> : null}
+        />
+        
+        <View style={[styles.footer, { backgroundColor: theme.cardBackground, borderTopColor: theme.border, paddingBottom: insets.bottom + 12 }]}>
+          <Text style={[styles.footerTitle, { color: theme.text }]}>
+            About {formatFileSize(estimate.bytes)} from {estimate.folders} {estimate.folders === 1 ? 'folder' : 'folders'}
+          </Text>
+          <Text style={[styles.footerText, { color: theme.textSecondary }]}>
+            {rules.some(rule => rule.mode === 'include')
+              ? 'Only included folders are synced, without their excluded subfolders.'
+              : 'No folder is included, so the sonora, music and Music folders are synced, without excluded subfolders.'}
+          </Text>
+        </View>
+      </View>
+    </Modal>
+  );
+};
+
+const styles = StyleSheet.create({
+  container: {
+    flex: 1,
+  },
+  header: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    justifyContent: 'space-between',
+    paddingHorizontal: 16,
+    paddingVertical: 12,
+    borderBottomWidth: StyleSheet.hairlineWidth,
+  },
+  headerButton: {
+    minWidth: 60,
+    alignItems: 'center',
+  },
+  headerButtonText: {
+    fontSize: 16,
+    fontWeight: '500',
+  },
+  headerTitle: {
+    fontSize: 18,
+    fontWeight: '600',
+  },
+  trail: {
+    flexDirection: 'row',
+    flexWrap: 'wrap',
+    paddingHorizontal: 16,
+    paddingVertical: 10,
+  },
+  trailText: {
+    fontSize: 14,
+  },
+  folderRow: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    paddingHorizontal: 16,
+    paddingVertical: 12,
+    borderBottomWidth: StyleSheet.hairlineWidth,
+  },
+  folderInfo: {
+    flex: 1,
+    flexDirection: 'row',
+    alignItems: 'center',
+  },
+  folderText: {
+    flex: 1,
+    marginLeft: 12,
+  },
+  folderName: {
+    fontSize: 16,
+  },
+  folderDetails: {
+    fontSize: 12,
+    marginTop: 2,
+  },
+  ruleButton: {
+    padding: 4,
+    marginLeft: 8,
+  },
+  emptyText: {
+    textAlign: 'center',
+    marginTop: 32,
+    fontSize: 14,
+  },
+  loader: {
+    marginVertical: 16,
+  },
+  footer: {
+    paddingHorizontal: 16,
+    paddingTop: 12,
+    borderTopWidth: StyleSheet.hairlineWidth,
+  },
+  footerTitle: {
+    fontSize: 16,
+    fontWeight: '500',
+  },
+  footerText: {
+    fontSize: 12,
+    marginTop: 4,
+  },
+});
+
+export default SyncScopePicker;
\ No newline at end of file
@@ -0,0 +1,799 @@
+/**
+ * Device Benchmark
+ * Runs the standard benchmark scenarios on the device itself against a
+ * synthetic, sandboxed library and saves the results as JSON
+ *
+ * Lab runs miss slow flash, throttled CPUs and aggressive memory killers, so
+ * the same scenarios run here on real hardware. Everything happens in an
+ * isolated catalog and search index under a sandbox directory; the user's
+ * library, caches and OneDrive session are never touched. Reports share one
+ * schema so device classes can be compared across the fleet.
+ */
+
+import { Platform } from 'react-native';
+import Constants from 'expo-constants';
+import MusicInfo from 'expo-music-info-2';
+import { Track } from '../types';
+import { logger } from '../utils/logger';
+import { tracing } from '../utils/tracing';
+import { jankWatchdog } from '../utils/jankWatchdog';
+import { parseJsonArrayInSlices } from '../utils/jsonChunks';
+import { ioAccounting, instrumentFileSystem } from '../utils/io';
+import { Catalog } from '../services/catalog/Catalog';
+import { SearchIndex, tokenize } from '../services/search/SearchIndex';
+import { taskScheduler, TaskPriority } from '../services/scheduler/TaskScheduler';
+import { ShardedDirectory } from '../services/storage/ShardedDirectory';
+import { OneDriveStorageProvider } from '../services/storage/OneDriveStorageProvider';
+import { createRandom, readHeapBytes, runPlaybackSoak } from './PlaybackSoak';
+import { runPlayerSchedulingBench } from './PlayerSchedulingBench';
+import { runMediaLibraryHarness } from './MediaLibraryHarness';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('benchmark');
+
+// Constants
+const REPORT_SCHEMA_VERSION = 1;
+const SANDBOX_DIR = `${FileSystem.documentDirectory}diagnostics/benchmark-sandbox/`;
+const REPORTS_DIR = `${FileSystem.documentDirectory}diagnostics/benchmarks/`;
+const MAX_SAVED_REPORTS = 20;
+const BASE64_CHUNK_SIZE = 0x8000;
+
+// Defaults
+const DEFAULT_TRACK_COUNT = 10000;
+const DEFAULT_FIXTURE_COUNT = 20;
+const DEFAULT_DRIVE_TRACK_COUNT = 2000;
+const DEFAULT_CACHE_LOOKUPS = 500;
+const QUERY_COUNT = 40;
+const QUERY_ROUNDS = 3;
+const CACHE_FILE_COUNT = 50;
+const CACHE_MISS_RATE = 0.1;
+const FIXTURE_SECONDS = 2;
+const IMPORT_BATCH_SIZE = 25;
+const DRIVE_TRACKS_PER_ALBUM = 12;
+const DRIVE_ALBUMS_PER_ARTIST = 3;
+
+export type BenchmarkScenario = 'catalog-load' | 'search' | 'import' | 'cache-resolve' | 'sync' | 'player' | 'soak' | 'media-library';
+
+export const BENCHMARK_SCENARIOS: BenchmarkScenario[] = ['catalog-load', 'search', 'import', 'cache-resolve', 'sync', 'player', 'soak', 'media-library'];
+
+export interface BenchmarkOptions {
+  trackCount?: number;
+  fixtureCount?: number;
+  driveTrackCount?: number;
+  cacheLookups?: number;
+  scenarios?: BenchmarkScenario[];
+  seed?: number;
+  onProgress?: (scenario: BenchmarkScenario, index: number, total: number) => void;
+}
+
+export interface TimingSummary {
+  count: number;
+  totalMs: number;
+  meanMs: number;
+  p50Ms: number;
+  p95Ms: number;
+  maxMs: number;
+}
+
+export interface BenchmarkScenarioResult {
+  name: BenchmarkScenario;
+  passed: boolean;
+  error?: string;
+  wallTimeMs: number;
+  timings: Record<string, TimingSummary>;
+  counts: Record<string, number>;
+  io: { calls: number; errors: number; bytesRead: number; bytesWritten: number; totalMs: number };
+  jank: { longTasks: number; maxLagMs: number; droppedFrames: number };
+  heapDeltaBytes: number | null;
+}
+
+export interface BenchmarkDeviceInfo {
+  platform: string;
+  osVersion: string;
+  model: string;
+  manufacturer?: string;
+  appVersion: string;
+  hermes: boolean;
+}
+
+export interface BenchmarkReport {
+  schemaVersion: number;
+  id: string;
+  startedAt: string;
+  device: BenchmarkDeviceInfo;
+  options: { trackCount: number; fixtureCount: number; driveTrackCount: number; cacheLookups: number; seed: number };
+  scenarios: BenchmarkScenarioResult[];
+  wallTimeMs: number;
+}
+
+interface ResolvedOptions {
+  trackCount: number;
+  fixtureCount: number;
+  driveTrackCount: number;
+  cacheLookups: number;
+  seed: number;
+}
+
+interface ScenarioContext {
+  options: ResolvedOptions;
+  random: () => number;
+  timings: Timings;
+  counts: Record<string, number>;
+  catalog?: Catalog;
+  fixtures?: string[];
+  cacheFiles?: string[];
+  cacheLayout?: ShardedDirectory;
+  graph?: FakeGraph;
+}
+
+interface Scenario {
+  // Preparation that is not part of the measurement
+  setup?: (context: ScenarioContext) => Promise<void>;
+  run: (context: ScenarioContext) => Promise<void>;
+}
+
+/**
+ * Samples per named step, summarized into percentiles
+ */
+class Timings {
+  private samples: Map<string, number[]> = new Map();
+  
+  public async time<T>(name: string, fn: () => Promise<T>): Promise<T> {
+    const start = performance.now();
+    try {
+      return await fn();
+    } finally {
+      this.record(name, performance.now() - start);
+    }
+  }
+  
+  public timeSync<T>(name: string, fn: () => T): T {
+    const start = performance.now();
+    try {
+      return fn();
+    } finally {
+      this.record(name, performance.now() - start);
+    }
+  }
+  
+  public record(name: string, ms: number): void {
+    const values = this.samples.get(name);
+    if (values) {
+      values.push(ms);
+    } else {
+      this.samples.set(name, [ms]);
+    }
+  }
+  
+  public summarize(): Record<string, TimingSummary> {
+    const result: Record<string, TimingSummary> = {};
+    this.samples.forEach((values, name) => {
+      const sorted = values.slice().sort((a, b) => a - b);
+      const total = sorted.reduce((sum, value) => sum + value, 0);
+      const at = (fraction: number) => sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * fraction))];
+      result[name] = {
+        count: sorted.length,
+        totalMs: round(total),
+        meanMs: round(total / sorted.length),
+        p50Ms: round(at(0.5)),
+        p95Ms: round(at(0.95)),
+        maxMs: round(sorted[sorted.length - 1])
+      };
+    });
+    return result;
+  }
+}
+
+/**
+ * In-app stand-in for the Graph drive endpoints the sync walks
+ * Folder listings are serialized up front, so requests cost what parsing a real response costs
+ */
+class FakeGraph {
+  public requests: number = 0;
+  public items: number = 0;
+  private bodies: Map<string, string> = new Map();
+  
+  constructor(trackCount: number, random: () => number) {
+    const folder = (id: string, name: string, childCount: number) => ({ id, name, folder: { childCount } });
+    const artistCount = Math.max(1, Math.ceil(trackCount / (DRIVE_TRACKS_PER_ALBUM * DRIVE_ALBUMS_PER_ARTIST)));
+    
+    const artists: any[] = [];
+    let trackIndex = 0;
+    for (let a = 0; a < artistCount && trackIndex < trackCount; a++) {
+      const albums: any[] = [];
+      for (let b = 0; b < DRIVE_ALBUMS_PER_ARTIST && trackIndex < trackCount; b++) {
+        const albumId = `album-${a}-${b}`;
+        const children: any[] = [{ id: `${albumId}-cover`, name: 'cover.jpg', size: 120000, file: { mimeType: 'image/jpeg' } }];
+        for (let t = 0; t < DRIVE_TRACKS_PER_ALBUM && trackIndex < trackCount; t++, trackIndex++) {
+          children.push({
+            id: `item-${trackIndex}`,
+            name: `Drive Artist ${a} - Track ${trackIndex}.mp3`,
+            size: 3000000 + Math.floor(random() * 6000000),
+            eTag: `"{${trackIndex}},1"`,
+            file: { mimeType: 'audio/mpeg' },
+            audio: {
+              title: `Track ${trackIndex}`,
+              artist: `Drive Artist ${a}`,
+              album: `Drive Album ${a}-${b}`,
+              duration: Math.round((120 + random() * 300) * 1000)
+            },
+            '@microsoft.graph.downloadUrl': `https://fake.graph.invalid/download/${trackIndex}`
+          });
+        }
+        this.setChildren(albumId, children);
+        albums.push(folder(albumId, `Drive Album ${a}-${b}`, children.length));
+      }
+      this.setChildren(`artist-${a}`, albums);
+      artists.push(folder(`artist-${a}`, `Drive Artist ${a}`, albums.length));
+    }
+    this.setChildren('music', artists);
+    
+    this.setChildren('root', [
+      folder('music', 'Music', artists.length),
+      folder('documents', 'Documents', 0),
+      folder('photos', 'Photos', 0),
+      { id: 'notes', name: 'notes.txt', size: 2048, file: { mimeType: 'text/plain' } }
+    ]);
+    this.setChildren('documents', []);
+    this.setChildren('photos', []);
+  }
+  
+  /**
+   * Folder a Graph children URL lists, the drive root or /items/{id}
+   */
+  public getFolderId(url: string): string {
+    const match = url.match(/\/(?:root|items\/([^/?]+))\/children/);
+    if (!match) {
+      throw new Error(`Fake Graph does not serve ${url}`);
+    }
+    return match[1] ?? 'root';
+  }
+  
+  /**
+   * Response body of GET /items/{id}/children
+   */
+  public async getChildren(folderId: string): Promise<string> {
+    this.requests++;
+    const body = this.bodies.get(folderId);
+    if (body === undefined) {
+      throw new Error(`Fake Graph has no folder ${folderId}`);
+    }
+    return body;
+  }
+  
+  private setChildren(folderId: string, children: any[]): void {
+    this.items += children.length;
+    this.bodies.set(folderId, JSON.stringify({ value: children }));
+  }
+}
+
+const round = (value: number): number => Math.round(value * 100) / 100;
+
+const bytesToBase64 = (bytes: Uint8Array): string => {
+  const chunks: string[] = [];
+  for (let i = 0; i < bytes.length; i += BASE64_CHUNK_SIZE) {
+    chunks.push(String.fromCharCode.apply(null, Array.from(bytes.subarray(i, i + BASE64_CHUNK_SIZE))));
+  }
+  return btoa(chunks.join(''));
+};
+
+/**
+ * A short 8 kHz mono WAV tone, a real decodable file for the import fixtures
+ */
+const createWavFixture = (seconds: number): string => {
+  const sampleRate = 8000;
+  const dataBytes = sampleRate * seconds * 2;
+  const view = new DataView(new ArrayBuffer(44 + dataBytes));
+  const ascii = (offset: number, text: string) => {
+    for (let i = 0; i < text.length; i++) view.setUint8(offset + i, text.charCodeAt(i));
+  };
+  
+  ascii(0, 'RIFF');
+  view.setUint32(4, 36 + dataBytes, true);
+  ascii(8, 'WAVE');
+  ascii(12, 'fmt ');
+  view.setUint32(16, 16, true);
+  view.setUint16(20, 1, true); // PCM
+  view.setUint16(22, 1, true); // mono
+  view.setUint32(24, sampleRate, true);
+  view.setUint32(28, sampleRate * 2, true);
+  view.setUint16(32, 2, true);
+  view.setUint16(34, 16, true);
+  ascii(36, 'data');
+  view.setUint32(40, dataBytes, true);
+  for (let i = 0; i < dataBytes / 2; i++) {
+    view.setInt16(44 + i * 2, Math.round(Math.sin((2 * Math.PI * 440 * i) / sampleRate) * 8000), true);
+  }
+  
+  return bytesToBase64(new Uint8Array(view.buffer));
+};
+
+/**
+ * Library of synthetic tracks with realistic artist and album reuse
+ */
+const createSyntheticTracks = (count: number, random: () => number): Track[] => {
+  const words = ['night', 'river', 'golden', 'echo', 'summer', 'paper', 'light', 'storm', 'velvet', 'ocean',
+    'silver', 'garden', 'midnight', 'fire', 'glass', 'shadow', 'city', 'dream', 'wild', 'winter'];
+  const pick = () => words[Math.floor(random() * words.length)];
+  const artistCount = Math.max(1, Math.floor(count / 20));
+  const albumCount = Math.max(1, Math.floor(count / 10));
+  
+  const tracks: Track[] = [];
+  for (let i = 0; i < count; i++) {
+    const album = Math.floor(random() * albumCount);
+    tracks.push({
+      id: `bench-${i}`,
+      title: `${pick()} ${pick()} ${i}`,
+      artist: `Artist ${album % artistCount} ${words[album % words.length]}`,
+      album: `Album ${album} ${words[(album * 7) % words.length]}`,
+      duration: Math.round((120 + random() * 300) * 1000),
+      uri: `${SANDBOX_DIR}library/${i}.mp3`,
+      source: 'local',
+      path: `${SANDBOX_DIR}library/${i}.mp3`
+    });
+  }
+  return tracks;
+};
+
+/**
+ * Word-prefix queries drawn from the library, plus a few that match nothing
+ */
+const createQueries = (tracks: Track[], random: () => number, count: number): string[] => {
+  const queries: string[] = [];
+  for (let i = 0; i < count; i++) {
+    if (i % 10 === 9) {
+      queries.push(`zq${i}x`);
+      continue;
+    }
+    const track = tracks[Math.floor(random() * tracks.length)];
+    const words = [...tokenize(track.title), ...tokenize(track.artist)];
+    const word = words[Math.floor(random() * words.length)] || 'a';
+    const prefix = word.slice(0, 2 + Math.floor(random() * Math.max(1, word.length - 1)));
+    queries.push(i % 3 === 0 && track.album ? `${prefix} ${tokenize(track.album)[0] || ''}`.trim() : prefix);
+  }
+  return queries;
+};
+
+const ensureDirectory = async (dir: string): Promise<void> => {
+  const info = await FileSystem.getInfoAsync(dir);
+  if (!info.exists) {
+    await FileSystem.makeDirectoryAsync(dir, { intermediates: true });
+  }
+};
+
+/**
+ * Catalog for scenarios that need a loaded library, shared with catalog-load when it ran
+ */
+const ensureCatalog = async (context: ScenarioContext): Promise<Catalog> => {
+  if (!context.catalog) {
+    const catalog = Catalog.createIsolated();
+    await taskScheduler.run(() => catalog.replaceAllInSlices(createSyntheticTracks(context.options.trackCount, context.random)), {
+      priority: TaskPriority.BACKGROUND,
+      label: 'benchmark-catalog'
+    });
+    context.catalog = catalog;
+  }
+  return context.catalog;
+};
+
+const SCENARIOS: Record<BenchmarkScenario, Scenario> = {
+  /**
+   * Persisted library JSON read, parsed and merged into a catalog, like a cold start
+   */
+  'catalog-load': {
+    run: async context => {
+      const { timings, counts } = context;
+      const path = `${SANDBOX_DIR}library.json`;
+      const json = JSON.stringify(createSyntheticTracks(context.options.trackCount, context.random));
+      
+      await timings.time('write', () => FileSystem.writeAsStringAsync(path, json));
+      const text = await timings.time('read', () => FileSystem.readAsStringAsync(path));
+      const parsed = await timings.time('parse', () => taskScheduler.run(() => parseJsonArrayInSlices<Track>(text), {
+        priority: TaskPriority.BACKGROUND,
+        label: 'benchmark-parse'
+      }));
+      
+      const catalog = Catalog.createIsolated();
+      await timings.time('merge', () => taskScheduler.run(() => catalog.replaceAllInSlices(parsed), {
+        priority: TaskPriority.BACKGROUND,
+        label: 'benchmark-merge'
+      }));
+      
+      const stats = catalog.getStats();
+      counts.tracks = stats.tracks;
+      counts.artists = stats.artists;
+      counts.albums = stats.albums;
+      counts.jsonChars = json.length;
+      context.catalog = catalog;
+    }
+  },
+  
+  /**
+   * Index build, snapshot save and load, then repeated prefix queries
+   */
+  search: {
+    setup: async context => {
+      await ensureCatalog(context);
+    },
+    run: async context => {
+      const { timings, counts } = context;
+      const catalog = context.catalog!;
+      const snapshotDir = `${SANDBOX_DIR}search/`;
+      const queries = createQueries(catalog.tracks(), context.random, QUERY_COUNT);
+      
+      const cold = SearchIndex.createIsolated(catalog, snapshotDir);
+      try {
+        await timings.time('cold-build', () => cold.search(queries[0]));
+        await timings.time('snapshot-save', () => cold.flush());
+      } finally {
+        cold.dispose();
+      }
+      
+      const warm = SearchIndex.createIsolated(catalog, snapshotDir);
+      try {
+        await timings.time('snapshot-load', () => warm.search(queries[0]));
+        
+        counts.results = 0;
+        for (let round = 0; round < QUERY_ROUNDS; round++) {
+          for (const query of queries) {
+            const results = await timings.time('query', () => warm.search(query));
+            counts.results += results.length;
+          }
+        }
+        
+        const stats = warm.getStats();
+        counts.documents = stats.documents;
+        counts.tokens = stats.tokens;
+        counts.queries = queries.length * QUERY_ROUNDS;
+      } finally {
+        warm.dispose();
+      }
+    }
+  },
+  
+  /**
+   * Copy fixtures into the library folder and read their tags, as a folder import does
+   */
+  import: {
+    setup: async context => {
+      const fixtureDir = `${SANDBOX_DIR}fixtures/`;
+      await ensureDirectory(fixtureDir);
+      
+      const wav = createWavFixture(FIXTURE_SECONDS);
+      const fixtures: string[] = [];
+      for (let i = 0; i < context.options.fixtureCount; i++) {
+        const path = `${fixtureDir}Fixture Artist ${i % 4} - Fixture Track ${i}.wav`;
+        await FileSystem.writeAsStringAsync(path, wav, { encoding: FileSystem.EncodingType.Base64 });
+        fixtures.push(path);
+      }
+      context.fixtures = fixtures;
+    },
+    run: async context => {
+      const { timings, counts } = context;
+      const importDir = `${SANDBOX_DIR}imported/`;
+      await ensureDirectory(importDir);
+      
+      const catalog = Catalog.createIsolated();
+      let batch: Track[] = [];
+      counts.withTags = 0;
+      
+      for (const source of context.fixtures!) {
+        const start = performance.now();
+        const fileName = source.slice(source.lastIndexOf('/') + 1);
+        const target = `${importDir}${fileName}`;
+        
+        await timings.time('copy', () => FileSystem.copyAsync({ from: source, to: target }));
+        const metadata = await timings.time('metadata', () => MusicInfo.getMusicInfoAsync(target, {
+          title: true,
+          artist: true,
+          album: true,
+          genre: true,
+          picture: true
+        }).catch(() => null));
+        if (metadata?.title || metadata?.artist) {
+          counts.withTags++;
+        }
+        
+        const baseName = fileName.replace(/\.[^.]+$/, '');
+        const separator = baseName.indexOf(' - ');
+        batch.push({
+          id: `bench-import-${fileName}`,
+          title: metadata?.title || (separator > 0 ? baseName.slice(separator + 3) : baseName),
+          artist: metadata?.artist || (separator > 0 ? baseName.slice(0, separator) : undefined),
+          album: metadata?.album,
+          uri: target,
+          source: 'local',
+          path: target
+        });
+        if (batch.length >= IMPORT_BATCH_SIZE) {
+          catalog.upsert(batch);
+          batch = [];
+        }
+        timings.record('file', performance.now() - start);
+      }
+      catalog.upsert(batch);
+      
+      counts.files = context.fixtures!.length;
+      counts.tracks = catalog.size;
+    }
+  },
+  
+  /**
+   * Cache lookups for tracks already downloaded, with some misses, as playback resolves them
+   * Files sit in the same sharded layout as the OneDrive cache
+   */
+  'cache-resolve': {
+    setup: async context => {
+      const cacheLayout = new ShardedDirectory(`${SANDBOX_DIR}cache/`);
+      
+      const body = createWavFixture(FIXTURE_SECONDS);
+      const cacheFiles: string[] = [];
+      for (let i = 0; i < CACHE_FILE_COUNT; i++) {
+        const path = cacheLayout.pathFor(`onedrive-bench-${i}.mp3`);
+        await cacheLayout.ensureDirectoryFor(path);
+        await FileSystem.writeAsStringAsync(path, body, { encoding: FileSystem.EncodingType.Base64 });
+        cacheFiles.push(path);
+      }
+      context.cacheFiles = cacheFiles;
+      context.cacheLayout = cacheLayout;
+    },
+    run: async context => {
+      const { timings, counts } = context;
+      const cacheFiles = context.cacheFiles!;
+      counts.hits = 0;
+      counts.misses = 0;
+      
+      for (let i = 0; i < context.options.cacheLookups; i++) {
+        const miss = context.random() < CACHE_MISS_RATE;
+        const path = miss
+          ? context.cacheLayout!.pathFor(`onedrive-missing-${i}.mp3`)
+          : cacheFiles[Math.floor(context.random() * cacheFiles.length)];
+        
+        const info = await timings.time(miss ? 'miss' : 'hit', () => FileSystem.getInfoAsync(path));
+        if (info.exists) {
+          counts.hits++;
+        } else {
+          counts.misses++;
+        }
+      }
+    }
+  },
+  
+  /**
+   * The OneDrive provider's own crawl against the fake Graph, then merge and persist, as a sync does
+   */
+  sync: {
+    setup: async context => {
+      context.graph = new FakeGraph(context.options.driveTrackCount, context.random);
+    },
+    run: async context => {
+      const { timings, counts } = context;
+      const graph = context.graph!;
+      
+      const provider = OneDriveStorageProvider.createIsolated(async url => {
+        const body = await timings.time('request', () => graph.getChildren(graph.getFolderId(url)));
+        return timings.timeSync('parse', () => JSON.parse(body));
+      });
+      const tracks = await timings.time('crawl', () => provider.listAudioFiles());
+      
+      const catalog = Catalog.createIsolated();
+      await timings.time('merge', () => taskScheduler.run(() => catalog.replaceAllInSlices(tracks), {
+        priority: TaskPriority.BACKGROUND,
+        label: 'benchmark-sync-merge'
+      }));
+      
+      const json = JSON.stringify(tracks);
+      await timings.time('persist', () => FileSystem.writeAsStringAsync(`${SANDBOX_DIR}onedrive-tracks.json`, json));
+      
+      counts.requests = graph.requests;
+      counts.driveItems = graph.items;
+      counts.tracks = catalog.size;
+    }
+  },
+  
+  /**
+   * Player scheduling on the simulated backend; counts are virtual milliseconds and tallies,
+   * identical on every device, while the wall time shows what the scheduling costs the CPU
+   */
+  player: {
+    run: async context => {
+      const result = await context.timings.time('bench', () => runPlayerSchedulingBench());
+      Object.assign(context.counts, result.metrics);
+      if (!result.passed) {
+        throw new Error(result.failures.join('; '));
+      }
+    }
+  },
+  
+  /**
+   * A simulated day of listening with skips, seeks and syncs; fails when sounds, timers,
+   * listeners or the heap keep growing
+   */
+  soak: {
+    run: async context => {
+      const result = await context.timings.time('soak', () => runPlaybackSoak({ seed: context.options.seed }));
+      Object.assign(context.counts, result.stats);
+      context.counts.simulatedMs = result.simulatedMs;
+      if (!result.passed) {
+        throw new Error(result.failures.join('; '));
+      }
+    }
+  },
+  
+  /**
+   * Media library provider against a fake native module: listing, paging and rescan diffs
+   */
+  'media-library': {
+    run: async context => {
+      const result = await context.timings.time('harness', () => runMediaLibraryHarness());
+      Object.assign(context.counts, result.metrics);
+      if (!result.passed) {
+        throw new Error(result.failures.join('; '));
+      }
+    }
+  }
+};
+
+const getDeviceInfo = (): BenchmarkDeviceInfo => {
+  const constants = Platform.constants as Record<string, any>;
+  return {
+    platform: Platform.OS,
+    osVersion: String(Platform.Version),
+    model: constants.Model || Constants.deviceName || 'unknown',
+    manufacturer: constants.Manufacturer,
+    appVersion: Constants.expoConfig?.version || 'unknown',
+    hermes: !!(global as any).HermesInternal
+  };
+};
+
+/**
+ * Run one scenario with I/O, jank and heap measured around it
+ */
+const runScenario = async (name: BenchmarkScenario, context: ScenarioContext): Promise<BenchmarkScenarioResult> => {
+  const scenario = SCENARIOS[name];
+  context.timings = new Timings();
+  context.counts = {};
+  
+  let error: string | undefined;
+  let wallTimeMs = 0;
+  let heapBefore: number | null = null;
+  
+  try {
+    await scenario.setup?.(context);
+    
+    ioAccounting.reset();
+    jankWatchdog.reset();
+    (global as any).gc?.();
+    heapBefore = readHeapBytes();
+    
+    const start = performance.now();
+    await tracing.trace(`benchmark.${name}`, () => scenario.run(context));
+    wallTimeMs = performance.now() - start;
+  } catch (scenarioError) {
+    error = scenarioError instanceof Error ? scenarioError.message : String(scenarioError);
+    logger.warn(`Benchmark scenario ${name} failed`, scenarioError);
+  }
+  
+  const heapAfter = readHeapBytes();
+  const io = { calls: 0, errors: 0, bytesRead: 0, bytesWritten: 0, totalMs: 0 };
+  Object.values(ioAccounting.getSnapshot().calls).forEach(entry => {
+    io.calls += entry.calls;
+    io.errors += entry.errors;
+    io.bytesRead += entry.bytesRead;
+    io.bytesWritten += entry.bytesWritten;
+    io.totalMs += entry.totalMs;
+  });
+  io.totalMs = round(io.totalMs);
+  const jank = jankWatchdog.getStats();
+  
+  return {
+    name,
+    passed: error === undefined,
+    error,
+    wallTimeMs: round(wallTimeMs),
+    timings: context.timings.summarize(),
+    counts: context.counts,
+    io,
+    jank: { longTasks: jank.longTasks, maxLagMs: round(jank.maxLagMs), droppedFrames: jank.droppedFrames },
+    heapDeltaBytes: heapBefore !== null && heapAfter !== null ? heapAfter - heapBefore : null
+  };
+};
+
+/**
+ * Run the benchmark scenarios and save the report
+ * Clears I/O accounting and jank totals between scenarios
+ */
+export const runDeviceBenchmarks = async (options: BenchmarkOptions = {}): Promise<{ report: BenchmarkReport; path: string }> => {
+  const resolved: ResolvedOptions = {
+    trackCount: options.trackCount ?? DEFAULT_TRACK_COUNT,
+    fixtureCount: options.fixtureCount ?? DEFAULT_FIXTURE_COUNT,
+    driveTrackCount: options.driveTrackCount ?? DEFAULT_DRIVE_TRACK_COUNT,
+    cacheLookups: options.cacheLookups ?? DEFAULT_CACHE_LOOKUPS,
+    seed: options.seed ?? 1
+  };
+  const scenarios = options.scenarios ?? BENCHMARK_SCENARIOS;
+  const startedAt = new Date();
+  const wallStart = performance.now();
+  
+  const context: ScenarioContext = {
+    options: resolved,
+    random: createRandom(resolved.seed),
+    timings: new Timings(),
+    counts: {}
+  };
+  
+  const results: BenchmarkScenarioResult[] = [];
+  await FileSystem.deleteAsync(SANDBOX_DIR, { idempotent: true });
+  await ensureDirectory(SANDBOX_DIR);
+  try {
+    for (let i = 0; i < scenarios.length; i++) {
+      options.onProgress?.(scenarios[i], i, scenarios.length);
+      results.push(await runScenario(scenarios[i], context));
+      
+      // Let the UI and pending timers catch up between scenarios
+      await new Promise(resolve => setTimeout(resolve, 0));
+    }
+  } finally {
+    await FileSystem.deleteAsync(SANDBOX_DIR, { idempotent: true }).catch(error => {
+      logger.warn('Failed to remove benchmark sandbox', error);
+    });
+  }
+  
+  const device = getDeviceInfo();
+  const report: BenchmarkReport = {
+    schemaVersion: REPORT_SCHEMA_VERSION,
+    id: `${startedAt.toISOString().replace(/[:.]/g, '-')}-${device.platform}`,
+    startedAt: startedAt.toISOString(),
+    device,
+    options: resolved,
+    scenarios: results,
+    wallTimeMs: round(performance.now() - wallStart)
+  };
+  
+  const path = await saveBenchmarkReport(report);
+  const failed = results.filter(result => !result.passed).map(result => result.name);
+  logger.info(`Device benchmark finished in ${Math.round(report.wallTimeMs)}ms${failed.length ? `, failed: ${failed.join(', ')}` : ''}`);
+  return { report, path };
+};
+
+/**
+ * Write a report as JSON, keeping the most recent reports only
+ */
+export const saveBenchmarkReport = async (report: BenchmarkReport): Promise<string> => {
+  try {
+    await ensureDirectory(REPORTS_DIR);
+    const path = `${REPORTS_DIR}${report.id}.json`;
+    await FileSystem.writeAsStringAsync(path, JSON.stringify(report, null, 2));
+    
+    const saved = await listBenchmarkReports();
+    for (const old of saved.slice(MAX_SAVED_REPORTS)) {
+      await FileSystem.deleteAsync(old, { idempotent: true });
+    }
+    return path;
+  } catch (error) {
+    logger.error('Failed to save benchmark report', error);
+    throw error;
+  }
+};
+
+/**
+ * Saved report paths, newest first
+ */
+export const listBenchmarkReports = async (): Promise<string[]> => {
+  const info = await FileSystem.getInfoAsync(REPORTS_DIR);
+  if (!info.exists) return [];
+  
+  const files = await FileSystem.readDirectoryAsync(REPORTS_DIR);
+  return files
+    .filter(file => file.endsWith('.json'))
+    .sort()
+    .reverse()
+    .map(file => `${REPORTS_DIR}${file}`);
+};
+
+/**
+ * Read a saved report as its JSON text, e.g. for sharing
+ */
+export const readBenchmarkReport = (path: string): Promise<string> => {
+  return FileSystem.readAsStringAsync(path);
+};
\ No newline at end of file
@@ -0,0 +1,289 @@
+/**
+ * Media Library Harness
+ * Checks the media library provider's listing, paging and change diffs against a fake native module
+ *
+ * The fake serves a fixed set of assets in pages with opaque cursors and
+ * records every call, so a regression in paging, filename parsing or the
+ * rescan diff shows up as a failure without touching the device's library.
+ */
+
+import { Track } from '../types';
+import { logger } from '../utils/logger';
+import { instrumentAsyncStorage } from '../utils/io';
+import {
+  MediaLibraryStorageProvider,
+  MediaLibraryModule,
+  MediaLibraryAsset,
+  MediaLibraryPage,
+  MediaLibraryPermission,
+  MediaLibraryChange
+} from '../services/storage/MediaLibraryStorageProvider';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('diagnostics');
+
+// Constants
+const MEDIA_LIBRARY_ENABLED_STORAGE_KEY = '@sonora/media_library_enabled';
+const PROVIDER_PAGE_SIZE = 500;
+const LIBRARY_SIZE = 1234;
+const REMOVED_ASSETS = 10;
+const ADDED_ASSETS = 5;
+const MOVED_ASSETS = 3;
+const CHANGE_WAIT_MS = 1500; // longer than the provider's rescan debounce
+
+export interface MediaLibraryHarnessReport {
+  passed: boolean;
+  failures: string[];
+  metrics: Record<string, number>;
+}
+
+/**
+ * In-memory stand-in for ExpoMediaLibrary
+ */
+class FakeMediaLibrary implements MediaLibraryModule {
+  public assets: MediaLibraryAsset[] = [];
+  public granted = true;
+  public pageRequests = 0;
+  public infoRequests = 0;
+  private listener: (() => void) | null = null;
+  
+  async getPermissionsAsync(): Promise<MediaLibraryPermission> {
+    return { granted: this.granted };
+  }
+  
+  async requestPermissionsAsync(): Promise<MediaLibraryPermission> {
+    return { granted: this.granted, canAskAgain: false };
+  }
+  
+  async getAssetsAsync(options: { first: number; after?: string; mediaType: string[] }): Promise<MediaLibraryPage> {
+    this.pageRequests++;
+    const start = options.after ? Number(options.after) : 0;
+    const end = Math.min(start + options.first, this.assets.length);
+    return {
+      assets: this.assets.slice(start, end),
+      endCursor: String(end),
+      hasNextPage: end < this.assets.length,
+      totalCount: this.assets.length
+    };
+  }
+  
+  async getAssetInfoAsync(assetId: string): Promise<MediaLibraryAsset & { localUri?: string }> {
+    this.infoRequests++;
+    const asset = this.assets.find(candidate => candidate.id === assetId);
+    if (!asset) throw new Error(`No asset ${assetId}`);
+    return { ...asset, localUri: `file:///media/${asset.id}.m4a` };
+  }
+  
+  addListener(eventName: string, listener: () => void): { remove: () => void } {
+    this.listener = listener;
+    return { remove: () => { this.listener = null; } };
+  }
+  
+  notifyChanged(): void {
+    this.listener?.();
+  }
+}
+
+const createAsset = (index: number, uriScheme: string = 'file:///music/'): MediaLibraryAsset => ({
+  id: `asset-${index}`,
+  filename: `Artist ${index % 40} - Song ${index}.mp3`,
+  uri: `${uriScheme}${index}.mp3`,
+  mediaType: 'audio',
+  duration: 180 + (index % 120)
+});
+
+const wait = (ms: number) => new Promise(resolve => setTimeout(resolve, ms));
+
+/**
+ * Connect a provider to a fresh fake library
+ */
+const createHarness = async (assetCount: number) => {
+  const module = new FakeMediaLibrary();
+  for (let i = 0; i < assetCount; i++) {
+    module.assets.push(createAsset(i));
+  }
+  const provider = new MediaLibraryStorageProvider(module);
+  const connected = await provider.connect();
+  return { module, provider, connected };
+};
+
+/**
+ * A full listing pages through every asset once and parses "Artist - Title" names
+ */
+const checkListing = async (metrics: Record<string, number>, failures: string[]) => {
+  const { module, provider, connected } = await createHarness(LIBRARY_SIZE);
+  try {
+    if (!connected) {
+      failures.push('Provider did not connect to a granted library');
+      return;
+    }
+    
+    const tracks = await provider.listAudioFiles();
+    const expectedPages = Math.ceil(LIBRARY_SIZE / PROVIDER_PAGE_SIZE);
+    metrics.listedTracks = tracks.length;
+    metrics.listingPages = module.pageRequests;
+    
+    if (tracks.length !== LIBRARY_SIZE) {
+      failures.push(`Listed ${tracks.length} tracks, expected ${LIBRARY_SIZE}`);
+    }
+    if (module.pageRequests !== expectedPages) {
+      failures.push(`Listing took ${module.pageRequests} pages, expected ${expectedPages}`);
+    }
+    
+    const sample = await provider.getAudioFile('media-asset-7');
+    if (!sample || sample.artist !== 'Artist 7' || sample.title !== 'Song 7') {
+      failures.push(`Parsed "${sample?.artist} / ${sample?.title}" from "Artist 7 - Song 7.mp3"`);
+    }
+    if (sample?.duration !== 187000) {
+      failures.push(`Duration ${sample?.duration}ms, expected 187000ms`);
+    }
+  } finally {
+    await provider.disconnect();
+  }
+};
+
+/**
+ * A library change rescans once and reports only what was added, moved or removed
+ */
+const checkChangeDiff = async (metrics: Record<string, number>, failures: string[]) => {
+  const { module, provider, connected } = await createHarness(LIBRARY_SIZE);
+  try {
+    if (!connected) {
+      failures.push('Provider did not connect to a granted library');
+      return;
+    }
+    
+    const changes: MediaLibraryChange[] = [];
+    provider.onTracksChanged(change => changes.push(change));
+    
+    module.assets.splice(0, REMOVED_ASSETS);
+    for (let i = 0; i < ADDED_ASSETS; i++) {
+      module.assets.push(createAsset(LIBRARY_SIZE + i));
+    }
+    for (let i = 0; i < MOVED_ASSETS; i++) {
+      const asset = module.assets[i * 100];
+      module.assets[i * 100] = { ...asset, uri: `file:///moved/${asset.id}.mp3` };
+    }
+    
+    // A burst of events collapses into one rescan
+    const pagesBefore = module.pageRequests;
+    module.notifyChanged();
+    module.notifyChanged();
+    module.notifyChanged();
+    await wait(CHANGE_WAIT_MS);
+    
+    const added = changes.reduce((sum, change) => sum + change.added.length, 0);
+    const removed = changes.reduce((sum, change) => sum + change.removedIds.length, 0);
+    const rescanPages = module.pageRequests - pagesBefore;
+    metrics.changeEvents = changes.length;
+    metrics.changeAdded = added;
+    metrics.changeRemoved = removed;
+    metrics.rescanPages = rescanPages;
+    
+    if (changes.length !== 1) {
+      failures.push(`${changes.length} change events after one burst, expected 1`);
+    }
+    if (added !== ADDED_ASSETS + MOVED_ASSETS) {
+      failures.push(`${added} tracks reported added, expected ${ADDED_ASSETS + MOVED_ASSETS}`);
+    }
+    if (removed !== REMOVED_ASSETS) {
+      failures.push(`${removed} tracks reported removed, expected ${REMOVED_ASSETS}`);
+    }
+    if (rescanPages !== Math.ceil(module.assets.length / PROVIDER_PAGE_SIZE)) {
+      failures.push(`Rescan took ${rescanPages} pages`);
+    }
+    
+    const moved = await provider.getAudioFile(`media-${module.assets[0].id}`);
+    if (moved?.uri !== module.assets[0].uri) {
+      failures.push(`Moved asset still points at ${moved?.uri}`);
+    }
+    
+    // A rescan with nothing changed must stay silent
+    module.notifyChanged();
+    await wait(CHANGE_WAIT_MS);
+    if (changes.length !== 1) {
+      failures.push('An unchanged library reported a change');
+    }
+  } finally {
+    await provider.disconnect();
+  }
+};
+
+/**
+ * Denied access leaves the provider disconnected without listing anything
+ */
+const checkPermissionDenied = async (metrics: Record<string, number>, failures: string[]) => {
+  const module = new FakeMediaLibrary();
+  module.granted = false;
+  module.assets.push(createAsset(0));
+  const provider = new MediaLibraryStorageProvider(module);
+  
+  if (await provider.connect()) {
+    failures.push('Provider connected without permission');
+  }
+  if (module.pageRequests > 0) {
+    failures.push('Provider listed assets without permission');
+  }
+};
+
+/**
+ * Assets without a plain file URI resolve through the asset info
+ */
+const checkUriResolution = async (metrics: Record<string, number>, failures: string[]) => {
+  const module = new FakeMediaLibrary();
+  module.assets.push(createAsset(0, 'ph://'), createAsset(1));
+  const provider = new MediaLibraryStorageProvider(module);
+  await provider.connect();
+  
+  try {
+    const [remote, local] = await Promise.all([
+      provider.getAudioFile('media-asset-0'),
+      provider.getAudioFile('media-asset-1')
+    ]) as [Track, Track];
+    
+    const remoteUri = await provider.getAudioFileUri(remote);
+    if (remoteUri !== 'file:///media/asset-0.m4a') {
+      failures.push(`ph:// asset resolved to ${remoteUri}`);
+    }
+    
+    const infoBefore = module.infoRequests;
+    await provider.getAudioFileUri(local);
+    if (module.infoRequests !== infoBefore) {
+      failures.push('A file:// asset was resolved through the native module');
+    }
+  } finally {
+    await provider.disconnect();
+  }
+};
+
+/**
+ * Run every check; the user's media library setting is restored afterwards
+ */
+export const runMediaLibraryHarness = async (): Promise<MediaLibraryHarnessReport> => {
+  const metrics: Record<string, number> = {};
+  const failures: string[] = [];
+  
+  // connect and disconnect write the real setting
+  const enabled = await AsyncStorage.getItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY);
+  
+  try {
+    const checks = [checkListing, checkChangeDiff, checkPermissionDenied, checkUriResolution];
+    for (const run of checks) {
+      try {
+        await run(metrics, failures);
+      } catch (error) {
+        failures.push(`${run.name} failed: ${error instanceof Error ? error.message : String(error)}`);
+      }
+    }
+  } finally {
+    if (enabled === null) {
+      await AsyncStorage.removeItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY);
+    } else {
+      await AsyncStorage.setItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY, enabled);
+    }
+  }
+  
+  const report: MediaLibraryHarnessReport = { passed: failures.length === 0, failures, metrics };
+  logger.info(`Media library harness ${report.passed ? 'passed' : 'failed'}`, failures);
+  return report;
+};
\ No newline at end of file
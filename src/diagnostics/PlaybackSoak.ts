@@ -0,0 +1,322 @@
+/**
+ * Playback Soak Harness
+ * Runs an isolated player through many hours of simulated listening on the
+ * simulated backend, and checks that sounds, timers, listeners and heap stay bounded
+ *
+ * Time is virtual: sounds and the player's own timers only advance when the
+ * harness steps the clock, so 24 hours of playback, skips, seeks and library
+ * syncs complete in seconds to minutes of wall time.
+ */
+
+import { Track } from '../types';
+import { logger } from '../utils/logger';
+import { PlayerService } from '../services/player/PlayerService';
+import { SimulatedBackend } from '../services/player/SimulatedBackend';
+
+// Defaults
+const DEFAULT_SIMULATED_HOURS = 24;
+const DEFAULT_STEP_MS = 2000;
+const DEFAULT_TRACK_COUNT = 40;
+
+// Growth limits
+const MAX_LIVE_SOUNDS = 2; // current and preloaded
+const MAX_INTERVAL_GROWTH = 1;
+const MAX_HEAP_GROWTH_PER_HOUR = 256 * 1024;
+const WARMUP_FRACTION = 0.25;
+
+// Chance of each user action per simulated second
+const ACTION_RATES = {
+  skip: 1 / 600,
+  seek: 1 / 400,
+  pauseResume: 1 / 900,
+  pickTrack: 1 / 1200,
+  sync: 1 / 3600
+};
+
+export interface SoakOptions {
+  simulatedHours?: number;
+  stepMs?: number;
+  trackCount?: number;
+  seed?: number;
+  onProgress?: (fraction: number) => void;
+}
+
+export interface SoakSample {
+  simulatedHour: number;
+  liveSounds: number;
+  liveIntervals: number;
+  pendingTimeouts: number;
+  statusListeners: number;
+  heapBytes: number | null;
+}
+
+export interface SoakStats {
+  plays: number;
+  autoAdvances: number;
+  skips: number;
+  seeks: number;
+  pauses: number;
+  syncs: number;
+  soundsCreated: number;
+  useAfterUnload: number;
+  errors: number;
+}
+
+export interface SoakReport {
+  passed: boolean;
+  failures: string[];
+  samples: SoakSample[];
+  stats: SoakStats;
+  simulatedMs: number;
+  wallTimeMs: number;
+}
+
+/**
+ * Small seeded PRNG so runs are reproducible
+ */
+export const createRandom = (seed: number): (() => number) => {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+};
+
+/**
+ * Allocated JS heap, when the engine exposes it (Hermes)
+ */
+export const readHeapBytes = (): number | null => {
+  const hermes = (global as any).HermesInternal;
+  const stats = hermes?.getInstrumentedStats?.();
+  if (stats && typeof stats.js_allocatedBytes === 'number') {
+    return stats.js_allocatedBytes;
+  }
+  return null;
+};
+
+/**
+ * Least squares slope of heap bytes per simulated hour
+ */
+const heapSlopePerHour = (samples: SoakSample[]): number | null => {
+  const points = samples.filter(sample => sample.heapBytes !== null);
+  if (points.length < 3) return null;
+  
+  const meanX = points.reduce((sum, p) => sum + p.simulatedHour, 0) / points.length;
+  const meanY = points.reduce((sum, p) => sum + (p.heapBytes as number), 0) / points.length;
+  let numerator = 0;
+  let denominator = 0;
+  for (const p of points) {
+    numerator += (p.simulatedHour - meanX) * ((p.heapBytes as number) - meanY);
+    denominator += (p.simulatedHour - meanX) ** 2;
+  }
+  return denominator > 0 ? numerator / denominator : null;
+};
+
+/**
+ * Build a library of fake tracks with 2 to 7 minute durations
+ */
+const createFakeTracks = (count: number, random: () => number, generation: number): Track[] => {
+  const tracks: Track[] = [];
+  for (let i = 0; i < count; i++) {
+    tracks.push({
+      id: `soak-${i}`,
+      title: `Soak Track ${i} (sync ${generation})`,
+      artist: `Soak Artist ${i % 5}`,
+      album: `Soak Album ${i % 8}`,
+      duration: Math.round(120 + random() * 300),
+      uri: `soak://track/${i}`,
+      source: 'local',
+      path: `soak://track/${i}`,
+      artwork: 'soak://artwork'
+    });
+  }
+  return tracks;
+};
+
+/**
+ * Run the soak and report whether resource usage stayed bounded
+ */
+export const runPlaybackSoak = async (options: SoakOptions = {}): Promise<SoakReport> => {
+  const simulatedHours = options.simulatedHours ?? DEFAULT_SIMULATED_HOURS;
+  const stepMs = options.stepMs ?? DEFAULT_STEP_MS;
+  const trackCount = options.trackCount ?? DEFAULT_TRACK_COUNT;
+  const random = createRandom(options.seed ?? 1);
+  
+  const durations = new Map<string, number>();
+  const backend = new SimulatedBackend({
+    durationFor: uri => durations.get(`soak-${uri.slice(uri.lastIndexOf('/') + 1)}`) ?? 180000,
+    loadLatencyMs: () => 0
+  });
+  const clock = backend.clock;
+  
+  const player = PlayerService.createIsolated({
+    backend,
+    resolveUri: async track => track.path || track.uri,
+    warmUri: async track => track.path || track.uri,
+    continueUri: () => null,
+    extractMetadata: async () => {}
+  });
+  
+  const stats: SoakStats = {
+    plays: 0,
+    autoAdvances: 0,
+    skips: 0,
+    seeks: 0,
+    pauses: 0,
+    syncs: 0,
+    soundsCreated: 0,
+    useAfterUnload: 0,
+    errors: 0
+  };
+  const samples: SoakSample[] = [];
+  const failures: string[] = [];
+  
+  let syncGeneration = 0;
+  let queue = createFakeTracks(trackCount, random, syncGeneration);
+  queue.forEach(track => durations.set(track.id, (track.duration as number) * 1000));
+  let currentIndex = 0;
+  let needsAdvance = false;
+  let paused = false;
+  
+  const upcoming = (): Track[] => {
+    return [1, 2, 3].map(offset => queue[(currentIndex + offset) % queue.length]);
+  };
+  
+  // Mirrors what the player store does on every play: a fresh status closure
+  const playAt = async (index: number): Promise<void> => {
+    currentIndex = index % queue.length;
+    paused = false;
+    stats.plays++;
+    await player.play(queue[currentIndex]);
+    player.setOnPlaybackStatusUpdate(status => {
+      if (status.isLoaded && status.didJustFinish) {
+        needsAdvance = true;
+      }
+    });
+    await player.setUpcomingTracks(upcoming());
+  };
+  
+  player.setOnTrackAdvanced(track => {
+    stats.autoAdvances++;
+    currentIndex = queue.findIndex(t => t.id === track.id);
+    player.setUpcomingTracks(upcoming());
+  });
+  
+  const takeSample = (simulatedMs: number): void => {
+    (global as any).gc?.();
+    samples.push({
+      simulatedHour: simulatedMs / 3600000,
+      liveSounds: backend.getLiveSounds(),
+      liveIntervals: clock.getIntervalCount(),
+      pendingTimeouts: clock.getTimeoutCount(),
+      statusListeners: backend.countListeners(),
+      heapBytes: readHeapBytes()
+    });
+  };
+  
+  const totalMs = simulatedHours * 3600000;
+  const sampleEveryMs = Math.max(stepMs, totalMs / 96);
+  const stepSeconds = stepMs / 1000;
+  const wallStart = Date.now();
+  let simulatedMs = 0;
+  let nextSampleAt = 0;
+  
+  try {
+    await playAt(0);
+    
+    while (simulatedMs < totalMs) {
+      await clock.advance(stepMs);
+      simulatedMs += stepMs;
+      
+      try {
+        if (needsAdvance) {
+          needsAdvance = false;
+          await playAt(currentIndex + 1);
+        } else if (random() < ACTION_RATES.skip * stepSeconds) {
+          stats.skips++;
+          await playAt(currentIndex + 1);
+        } else if (random() < ACTION_RATES.pickTrack * stepSeconds) {
+          await playAt(Math.floor(random() * queue.length));
+        } else if (random() < ACTION_RATES.seek * stepSeconds) {
+          stats.seeks++;
+          const duration = durations.get(queue[currentIndex].id) ?? 0;
+          await player.seekTo(Math.floor(random() * duration));
+        } else if (random() < ACTION_RATES.pauseResume * stepSeconds) {
+          stats.pauses++;
+          paused = !paused;
+          await (paused ? player.pause() : player.resume());
+        } else if (random() < ACTION_RATES.sync * stepSeconds) {
+          // A library sync replaces every track object while playback continues
+          stats.syncs++;
+          syncGeneration++;
+          queue = createFakeTracks(trackCount, random, syncGeneration);
+          queue.forEach(track => durations.set(track.id, (track.duration as number) * 1000));
+          await player.setUpcomingTracks(upcoming());
+        }
+      } catch (error) {
+        stats.errors++;
+        logger.warn('Soak action failed', error);
+      }
+      
+      if (simulatedMs >= nextSampleAt) {
+        takeSample(simulatedMs);
+        nextSampleAt += sampleEveryMs;
+        options.onProgress?.(simulatedMs / totalMs);
+        
+        // Yield so the UI stays responsive during long soaks
+        await new Promise(resolve => setTimeout(resolve, 0));
+      }
+    }
+    
+    takeSample(simulatedMs);
+  } finally {
+    await player.cleanup();
+  }
+  
+  stats.soundsCreated = backend.created;
+  stats.useAfterUnload = backend.useAfterUnload;
+  
+  // Evaluate growth
+  const maxLiveSounds = Math.max(...samples.map(sample => sample.liveSounds));
+  if (maxLiveSounds > MAX_LIVE_SOUNDS) {
+    failures.push(`Live sounds reached ${maxLiveSounds}, expected at most ${MAX_LIVE_SOUNDS}`);
+  }
+  if (backend.getLiveSounds() > 0) {
+    failures.push(`${backend.getLiveSounds()} sounds still loaded after cleanup`);
+  }
+  
+  const intervalGrowth = samples[samples.length - 1].liveIntervals - samples[0].liveIntervals;
+  if (intervalGrowth > MAX_INTERVAL_GROWTH) {
+    failures.push(`Live intervals grew by ${intervalGrowth} during the soak`);
+  }
+  
+  const maxListeners = Math.max(...samples.map(sample => sample.statusListeners));
+  if (maxListeners > MAX_LIVE_SOUNDS) {
+    failures.push(`Status listeners reached ${maxListeners}`);
+  }
+  
+  if (stats.useAfterUnload > 0) {
+    failures.push(`${stats.useAfterUnload} operations on unloaded sounds`);
+  }
+  
+  const steadyState = samples.slice(Math.floor(samples.length * WARMUP_FRACTION));
+  const slope = heapSlopePerHour(steadyState);
+  if (slope !== null && slope > MAX_HEAP_GROWTH_PER_HOUR) {
+    failures.push(`Heap grew by ${Math.round(slope / 1024)} KB per simulated hour`);
+  }
+  
+  const report: SoakReport = {
+    passed: failures.length === 0,
+    failures,
+    samples,
+    stats,
+    simulatedMs,
+    wallTimeMs: Date.now() - wallStart
+  };
+  
+  logger.info(`Playback soak ${report.passed ? 'passed' : 'failed'} after ${simulatedHours}h simulated in ${report.wallTimeMs}ms`, failures);
+  return report;
+};
\ No newline at end of file
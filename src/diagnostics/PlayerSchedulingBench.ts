@@ -0,0 +1,399 @@
+/**
+ * Player Scheduling Bench
+ * Measures how the player schedules loads and transitions, on the simulated backend
+ *
+ * Every case runs an isolated player on a virtual clock, so results are exact
+ * and identical from run to run: a change that adds a load to the tap path or
+ * a gap between tracks shows up as a number, not as noise. Latencies are in
+ * virtual milliseconds and assume the backend's default load and network model.
+ */
+
+import { Track } from '../types';
+import { logger } from '../utils/logger';
+import { PlayerService } from '../services/player/PlayerService';
+import { SimulatedBackend, SimulatedBackendOptions, SimulatedEvent } from '../services/player/SimulatedBackend';
+
+// Simulated load and network model
+const LOCAL_LOAD_MS = 40;
+const STREAM_LOAD_MS = 300;
+const STREAM_BITRATE_KBPS = 320;
+const FAST_BANDWIDTH_KBPS = 4000;
+const SLOW_BANDWIDTH_KBPS = 256;
+
+// Case parameters
+const TRACK_DURATION_MS = 8000;
+const STREAM_DURATION_MS = 60000;
+const HEAD_DURATION_MS = 10000;
+const PRESS_DURATION_MS = 120; // touch-down to onPress on a quick tap
+const GAPLESS_TRACKS = 4;
+const SKIP_STORM_TAPS = 30;
+const SKIP_STORM_INTERVAL_MS = 25; // shorter than a load, so loads overlap
+const EARLY_CONTINUATION_MS = 3000;
+const LATE_CONTINUATION_MS = 15000;
+const POLL_STEP_MS = 50;
+const MAX_WAIT_MS = 120000;
+
+// Regression limits, anything on the tap or transition path that loads shows up above these
+const MAX_WARMED_TAP_MS = 10;
+const MAX_CACHED_TAP_MS = LOCAL_LOAD_MS + 10;
+const MAX_GAPLESS_GAP_MS = 10;
+const MAX_LIVE_SOUNDS = 2; // current and preloaded
+
+export interface SchedulingBenchReport {
+  passed: boolean;
+  failures: string[];
+  metrics: Record<string, number>;
+}
+
+interface Harness {
+  backend: SimulatedBackend;
+  player: PlayerService;
+}
+
+const createHarness = (
+  options: SimulatedBackendOptions,
+  continueUri: (track: Track, uri: string) => Promise<string> | null = () => null
+): Harness => {
+  const backend = new SimulatedBackend({
+    loadLatencyMs: (uri, isStream) => isStream ? STREAM_LOAD_MS : LOCAL_LOAD_MS,
+    streamBitrateKbps: STREAM_BITRATE_KBPS,
+    bandwidthKbps: FAST_BANDWIDTH_KBPS,
+    ...options
+  });
+  const player = PlayerService.createIsolated({
+    backend,
+    resolveUri: async track => track.uri || track.path || '',
+    // Like the storage providers, only local files are loaded ahead of a tap
+    warmUri: async track => track.source === 'local' ? track.uri : null,
+    continueUri,
+    extractMetadata: async () => {}
+  });
+  return { backend, player };
+};
+
+const createTrack = (id: string, uri: string, durationMs: number): Track => ({
+  id,
+  title: `Bench Track ${id}`,
+  artist: 'Bench Artist',
+  duration: durationMs,
+  uri,
+  source: /^https?:/.test(uri) ? 'onedrive' : 'local',
+  path: uri,
+  artwork: 'bench://artwork'
+});
+
+/**
+ * Advance the clock until an event matches, null if none does within the wait
+ */
+const waitForEvent = async (
+  backend: SimulatedBackend,
+  match: (event: SimulatedEvent) => boolean,
+  maxMs: number = MAX_WAIT_MS
+): Promise<SimulatedEvent | null> => {
+  const deadline = backend.clock.now() + maxMs;
+  let found = backend.events.find(match);
+  while (!found && backend.clock.now() < deadline) {
+    await backend.clock.advance(POLL_STEP_MS);
+    found = backend.events.find(match);
+  }
+  return found ?? null;
+};
+
+/**
+ * Virtual time from play() to the track becoming audible
+ */
+const measureTap = async (harness: Harness, track: Track, warm: boolean): Promise<number | null> => {
+  const { backend, player } = harness;
+  const clock = backend.clock;
+  
+  if (warm) {
+    player.warmUp(track);
+    await clock.advance(PRESS_DURATION_MS);
+    player.releaseWarmUp(track);
+  }
+  
+  const start = clock.now();
+  const playing = player.play(track);
+  const audible = await waitForEvent(backend, event => event.type === 'audible' && event.uri === track.uri && event.at >= start);
+  await playing;
+  return audible ? audible.at - start : null;
+};
+
+/**
+ * Tap-to-audio for a cached file, a warmed cached file and a stream
+ */
+const benchTapLatency = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const cases: { name: string; uri: string; warm: boolean; limit: number | null }[] = [
+    { name: 'cached', uri: 'file:///bench/cached.mp3', warm: false, limit: MAX_CACHED_TAP_MS },
+    { name: 'warmed', uri: 'file:///bench/warmed.mp3', warm: true, limit: MAX_WARMED_TAP_MS },
+    { name: 'stream', uri: 'https://bench.invalid/stream.mp3', warm: false, limit: null }
+  ];
+  
+  for (const tap of cases) {
+    const harness = createHarness({ durationFor: () => STREAM_DURATION_MS });
+    try {
+      const latency = await measureTap(harness, createTrack(tap.name, tap.uri, STREAM_DURATION_MS), tap.warm);
+      if (latency === null) {
+        failures.push(`${tap.name} tap never became audible`);
+        continue;
+      }
+      
+      metrics[`tap.${tap.name}Ms`] = latency;
+      if (tap.limit !== null && latency > tap.limit) {
+        failures.push(`${tap.name} tap took ${latency}ms, expected at most ${tap.limit}ms`);
+      }
+    } finally {
+      await harness.player.cleanup();
+    }
+  }
+};
+
+/**
+ * Silence between consecutive tracks played from the queue window
+ */
+const benchGapless = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const harness = createHarness({ durationFor: () => TRACK_DURATION_MS });
+  const { backend, player } = harness;
+  const tracks = Array.from({ length: GAPLESS_TRACKS }, (_, i) =>
+    createTrack(`gapless-${i}`, `file:///bench/gapless-${i}.mp3`, TRACK_DURATION_MS)
+  );
+  
+  let current = 0;
+  player.setOnTrackAdvanced(track => {
+    current = tracks.findIndex(candidate => candidate.id === track.id);
+    player.setUpcomingTracks(tracks.slice(current + 1));
+  });
+  
+  try {
+    await backend.clock.runUntil(player.play(tracks[0]));
+    await backend.clock.runUntil(player.setUpcomingTracks(tracks.slice(1)));
+    
+    const last = tracks[tracks.length - 1];
+    const finished = await waitForEvent(backend, event => event.type === 'finished' && event.uri === last.uri);
+    if (!finished) {
+      failures.push(`Queue stopped at track ${current + 1} of ${tracks.length}`);
+      return;
+    }
+    
+    let maxGap = 0;
+    for (let i = 0; i < tracks.length - 1; i++) {
+      const end = backend.events.find(event => event.type === 'finished' && event.uri === tracks[i].uri);
+      const next = backend.events.find(event => event.type === 'audible' && event.uri === tracks[i + 1].uri);
+      if (!end || !next) {
+        failures.push(`No transition recorded from gapless track ${i}`);
+        continue;
+      }
+      maxGap = Math.max(maxGap, next.at - end.at);
+    }
+    
+    metrics['gapless.maxGapMs'] = maxGap;
+    if (maxGap > MAX_GAPLESS_GAP_MS) {
+      failures.push(`Gap between tracks reached ${maxGap}ms, expected at most ${MAX_GAPLESS_GAP_MS}ms`);
+    }
+  } finally {
+    await player.cleanup();
+  }
+};
+
+/**
+ * Taps faster than sounds load, as when skipping through a playlist
+ */
+const benchSkipStorm = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const harness = createHarness({ durationFor: () => STREAM_DURATION_MS });
+  const { backend, player } = harness;
+  const clock = backend.clock;
+  const tracks = Array.from({ length: 12 }, (_, i) =>
+    createTrack(`storm-${i}`, `file:///bench/storm-${i}.mp3`, STREAM_DURATION_MS)
+  );
+  
+  let errors = 0;
+  const plays: Promise<void>[] = [];
+  let lastTapped = tracks[0];
+  
+  try {
+    for (let i = 0; i < SKIP_STORM_TAPS; i++) {
+      const index = i % tracks.length;
+      lastTapped = tracks[index];
+      // Mirrors the store: play, then hand over the tracks that follow
+      plays.push(player.play(lastTapped)
+        .then(() => player.setUpcomingTracks([tracks[(index + 1) % tracks.length]]))
+        .catch(() => {
+          errors++;
+        }));
+      await clock.advance(SKIP_STORM_INTERVAL_MS);
+    }
+    
+    await clock.runUntil(Promise.all(plays));
+    await clock.advance(1000);
+    
+    const status = await player.getStatus();
+    metrics['skipStorm.soundsCreated'] = backend.created;
+    metrics['skipStorm.liveSounds'] = backend.getLiveSounds();
+    metrics['skipStorm.errors'] = errors;
+    
+    if (status.currentTrack?.id !== lastTapped.id) {
+      failures.push(`After a skip storm ${status.currentTrack?.id ?? 'nothing'} is current, expected ${lastTapped.id}`);
+    }
+    if (backend.getLiveSounds() > MAX_LIVE_SOUNDS) {
+      failures.push(`${backend.getLiveSounds()} sounds loaded after a skip storm, expected at most ${MAX_LIVE_SOUNDS}`);
+    }
+    if (backend.countListeners() > MAX_LIVE_SOUNDS) {
+      failures.push(`${backend.countListeners()} status listeners attached after a skip storm`);
+    }
+  } finally {
+    await player.cleanup();
+  }
+  
+  metrics['skipStorm.useAfterUnload'] = backend.useAfterUnload;
+  if (backend.useAfterUnload > 0) {
+    failures.push(`${backend.useAfterUnload} operations on unloaded sounds during a skip storm`);
+  }
+  if (backend.getLiveSounds() > 0) {
+    failures.push(`${backend.getLiveSounds()} sounds still loaded after cleanup`);
+  }
+};
+
+/**
+ * A stream played through on a fast and on a slow connection
+ */
+const benchStreamStalls = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const connections: { name: string; bandwidthKbps: number }[] = [
+    { name: 'fast', bandwidthKbps: FAST_BANDWIDTH_KBPS },
+    { name: 'slow', bandwidthKbps: SLOW_BANDWIDTH_KBPS }
+  ];
+  
+  for (const connection of connections) {
+    const harness = createHarness({ durationFor: () => STREAM_DURATION_MS, bandwidthKbps: connection.bandwidthKbps });
+    const { backend, player } = harness;
+    const track = createTrack(`stream-${connection.name}`, `https://bench.invalid/${connection.name}.mp3`, STREAM_DURATION_MS);
+    
+    try {
+      const start = backend.clock.now();
+      await backend.clock.runUntil(player.play(track));
+      const finished = await waitForEvent(backend, event => event.type === 'finished' && event.uri === track.uri, STREAM_DURATION_MS * 4);
+      if (!finished) {
+        failures.push(`Stream on a ${connection.name} connection never finished`);
+        continue;
+      }
+      
+      metrics[`stream.${connection.name}.stalls`] = backend.stalls;
+      metrics[`stream.${connection.name}.overrunMs`] = finished.at - start - STREAM_DURATION_MS;
+      if (connection.bandwidthKbps > STREAM_BITRATE_KBPS && backend.stalls > 0) {
+        failures.push(`Stream stalled ${backend.stalls} times on a ${connection.name} connection`);
+      }
+    } finally {
+      await player.cleanup();
+    }
+  }
+};
+
+/**
+ * A cached head handed over to the complete file, before and after the head runs out
+ */
+const benchHeadHandoff = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const cases: { name: string; continuationMs: number }[] = [
+    { name: 'early', continuationMs: EARLY_CONTINUATION_MS },
+    { name: 'late', continuationMs: LATE_CONTINUATION_MS }
+  ];
+  
+  for (const handoff of cases) {
+    const headUri = `file:///bench/${handoff.name}.head.mp3`;
+    const fullUri = `file:///bench/${handoff.name}.mp3`;
+    let continuedAt = 0;
+    
+    const harness = createHarness(
+      { durationFor: uri => uri === headUri ? HEAD_DURATION_MS : STREAM_DURATION_MS },
+      (track, uri) => {
+        if (uri !== headUri) return null;
+        return new Promise(resolve => harness.backend.clock.setTimeout(() => {
+          continuedAt = harness.backend.clock.now();
+          resolve(fullUri);
+        }, handoff.continuationMs));
+      }
+    );
+    const { backend, player } = harness;
+    const track = createTrack(handoff.name, headUri, STREAM_DURATION_MS);
+    
+    try {
+      await backend.clock.runUntil(player.play(track));
+      const audible = await waitForEvent(backend, event => event.type === 'audible' && event.uri === fullUri);
+      if (!audible) {
+        failures.push(`The ${handoff.name} head was never handed over`);
+        continue;
+      }
+      
+      const status = await player.getStatus();
+      const expectedPosition = Math.min(handoff.continuationMs, HEAD_DURATION_MS);
+      metrics[`handoff.${handoff.name}Ms`] = audible.at - continuedAt;
+      metrics[`handoff.${handoff.name}PositionMs`] = status.position;
+      
+      if (status.currentTrack?.id !== track.id) {
+        failures.push(`The ${handoff.name} handoff left ${status.currentTrack?.id ?? 'nothing'} current`);
+      }
+      if (Math.abs(status.position - expectedPosition) > LOCAL_LOAD_MS + POLL_STEP_MS) {
+        failures.push(`The ${handoff.name} handoff resumed at ${status.position}ms, expected about ${expectedPosition}ms`);
+      }
+    } finally {
+      await player.cleanup();
+    }
+  }
+};
+
+/**
+ * A head whose rest fails to arrive after it ran out, the queue must still move on
+ */
+const benchFailedHandoff = async (metrics: Record<string, number>, failures: string[]): Promise<void> => {
+  const headUri = 'file:///bench/failed.head.mp3';
+  let failedAt = 0;
+  const harness = createHarness(
+    { durationFor: uri => uri === headUri ? HEAD_DURATION_MS : TRACK_DURATION_MS },
+    (track, uri) => {
+      if (uri !== headUri) return null;
+      return new Promise((resolve, reject) => harness.backend.clock.setTimeout(
+        () => {
+          failedAt = harness.backend.clock.now();
+          reject(new Error('Bench continuation failed'));
+        },
+        LATE_CONTINUATION_MS
+      ));
+    }
+  );
+  const { backend, player } = harness;
+  const track = createTrack('failed', headUri, STREAM_DURATION_MS);
+  const following = createTrack('failed-next', 'file:///bench/failed-next.mp3', TRACK_DURATION_MS);
+  
+  try {
+    await backend.clock.runUntil(player.play(track));
+    await backend.clock.runUntil(player.setUpcomingTracks([following]));
+    
+    const audible = await waitForEvent(backend, event => event.type === 'audible' && event.uri === following.uri);
+    if (!audible) {
+      failures.push('Playback hung after a head whose rest failed to arrive');
+      return;
+    }
+    metrics['handoff.failedAdvanceMs'] = audible.at - failedAt;
+  } finally {
+    await player.cleanup();
+  }
+};
+
+/**
+ * Run every case and report metrics and regressions
+ */
+export const runPlayerSchedulingBench = async (): Promise<SchedulingBenchReport> => {
+  const metrics: Record<string, number> = {};
+  const failures: string[] = [];
+  
+  const cases = [benchTapLatency, benchGapless, benchSkipStorm, benchStreamStalls, benchHeadHandoff, benchFailedHandoff];
+  for (const run of cases) {
+    try {
+      await run(metrics, failures);
+    } catch (error) {
+      failures.push(`${run.name} failed: ${error instanceof Error ? error.message : String(error)}`);
+    }
+  }
+  
+  const report: SchedulingBenchReport = { passed: failures.length === 0, failures, metrics };
+  logger.info(`Player scheduling bench ${report.passed ? 'passed' : 'failed'}`, failures);
+  return report;
+};
\ No newline at end of file
@@ -20,12 +20,15 @@ import PlayerScreen from '../screens/PlayerScreen';
 import PlaylistDetailScreen from '../screens/PlaylistDetailScreen';
 import StorageProvidersScreen from '../screens/StorageProvidersScreen';
 import PlayingTabScreen from '../screens/PlayingTabScreen';
+import DiagnosticsScreen from '../screens/DiagnosticsScreen';
+import DriveBrowserScreen from '../screens/DriveBrowserScreen';
 
 // Import components
 import NowPlayingBar from '../components/player/NowPlayingBar';
 import CustomTabBar from '../components/navigation/CustomTabBar';
 import FloatingActionButton from '../components/common/FloatingActionButton';
 import { useTheme } from '../theme/ThemeContext';
+import { userActivity } from '../services/scheduler/UserActivity';
 import { StatusBar } from 'expo-status-bar';
 import { usePlayerStore } from '../store/playerStore';
 import { useStore } from '../store';
@@ -36,6 +39,8 @@ export type RootStackParamList = {
   Player: undefined;
   PlaylistDetail: { playlistId: string };
   StorageProviders: undefined;
+  Diagnostics: undefined;
+  DriveBrowser: { folderId?: string; name?: string } | undefined;
 };
 
 export type MainTabParamList = {
@@ -165,6 +170,7 @@ const AppNavigator = () => {
   return (
     <NavigationContainer
       linking={linking}
+      onStateChange={() => userActivity.markActive()}
       theme={{
         dark: isDarkMode,
         colors: {
@@ -280,6 +286,32 @@ const AppNavigator = () => {
             headerTintColor: theme.text,
           }}
         />
+        <Stack.Screen 
+          name="Diagnostics" 
+          component={DiagnosticsScreen} 
+          options={{ 
+            headerShown: true,
+            title: 'Diagnostics',
+            headerStyle: {
+              backgroundColor: theme.background,
+              borderBottomColor: theme.border,
+            },
+            headerTintColor: theme.text,
+          }}
+        />
+        <Stack.Screen 
+          name="DriveBrowser" 
+          component={DriveBrowserScreen} 
+          options={({ route }) => ({ 
+            headerShown: true,
+            title: route.params?.name ?? 'OneDrive',
+            headerStyle: {
+              backgroundColor: theme.background,
+              borderBottomColor: theme.border,
+            },
+            headerTintColor: theme.text,
+          })}
+        />
       </Stack.Navigator>
     </NavigationContainer>
   );
@@ -0,0 +1,362 @@
+/**
+ * Diagnostics Screen
+ * Hidden screen for running the on-device benchmarks and sharing their JSON results,
+ * and for inspecting recent stalls of the JS thread
+ */
+
+import React, { useEffect, useState } from 'react';
+import {
+  View,
+  Text,
+  StyleSheet,
+  ScrollView,
+  TouchableOpacity,
+  ActivityIndicator,
+  Share,
+  Alert
+} from 'react-native';
+import { Ionicons } from '@expo/vector-icons';
+
+import { useTheme } from '../theme/ThemeContext';
+import { logger } from '../utils/logger';
+import { jankWatchdog, StallRecord } from '../utils/jankWatchdog';
+import { catalog } from '../services/catalog/Catalog';
+import { searchIndex } from '../services/search/SearchIndex';
+import {
+  runDeviceBenchmarks,
+  listBenchmarkReports,
+  readBenchmarkReport,
+  BenchmarkReport,
+  BenchmarkOptions
+} from '../diagnostics/DeviceBenchmark';
+
+// Library sizes to benchmark against
+const SCALES: Record<string, BenchmarkOptions> = {
+  small: { trackCount: 2000, fixtureCount: 10, driveTrackCount: 500, cacheLookups: 200 },
+  standard: {},
+  large: { trackCount: 50000, fixtureCount: 40, driveTrackCount: 10000, cacheLookups: 1000 }
+};
+
+// Newest stalls listed on screen, the shared jank report has all of them
+const SHOWN_STALLS = 10;
+
+const DiagnosticsScreen = () => {
+  const { theme } = useTheme();
+  const [scale, setScale] = useState('standard');
+  const [isRunning, setIsRunning] = useState(false);
+  const [progress, setProgress] = useState('');
+  const [report, setReport] = useState<BenchmarkReport | null>(null);
+  const [reportPath, setReportPath] = useState<string | null>(null);
+  const [savedReports, setSavedReports] = useState<string[]>([]);
+  const [stalls, setStalls] = useState<StallRecord[]>(() => jankWatchdog.getRecentStalls());
+
+  useEffect(() => {
+    listBenchmarkReports()
+      .then(setSavedReports)
+      .catch(error => logger.warn('Failed to list benchmark reports', error));
+  }, []);
+
+  // Run every scenario at the selected scale
+  const handleRun = async () => {
+    try {
+      setIsRunning(true);
+      setReport(null);
+      const result = await runDeviceBenchmarks({
+        ...SCALES[scale],
+        onProgress: (scenario, index, total) => setProgress(`${scenario} (${index + 1}/${total})`)
+      });
+      setReport(result.report);
+      setReportPath(result.path);
+      setSavedReports(await listBenchmarkReports());
+      setStalls(jankWatchdog.getRecentStalls());
+    } catch (error) {
+      logger.error('Device benchmark failed', error);
+      Alert.alert('Error', 'Benchmark run failed');
+    } finally {
+      setIsRunning(false);
+      setProgress('');
+    }
+  };
+
+  // Share a saved report's JSON so it can be collected with other devices'
+  const handleShare = async (path: string) => {
+    try {
+      const json = await readBenchmarkReport(path);
+      await Share.share({ message: json, title: path.slice(path.lastIndexOf('/') + 1) });
+    } catch (error) {
+      logger.error('Failed to share benchmark report', error);
+      Alert.alert('Error', 'Failed to share benchmark report');
+    }
+  };
+
+  // Share the stall report with the spans each stall was charged to
+  const handleShareJank = async () => {
+    try {
+      await Share.share({ message: jankWatchdog.formatReport(), title: 'Jank report' });
+    } catch (error) {
+      logger.error('Failed to share jank report', error);
+      Alert.alert('Error', 'Failed to share jank report');
+    }
+  };
+
+  // Render a section header
+  const renderSectionHeader = (title: string) => (
+    <View style={[styles.sectionHeader, { backgroundColor: theme.surface }]}>
+      <Text style={[styles.sectionHeaderText, { color: theme.textSecondary }]}>{title}</Text>
+    </View>
+  );
+
+  // Render live app diagnostics
+  const renderAppState = () => {
+    const catalogStats = catalog.getStats();
+    const indexStats = searchIndex.getStats();
+    const jank = jankWatchdog.getStats();
+    const rows = [
+      ['Catalog', `${catalogStats.tracks} tracks, ${catalogStats.artists} artists, ${catalogStats.albums} albums`],
+      ['Search index', `${indexStats.documents} documents, ${indexStats.tokens} tokens${indexStats.ready ? '' : ' (loading)'}`],
+      ['Jank', `${jank.longTasks} long tasks, max lag ${Math.round(jank.maxLagMs)}ms`]
+    ];
+
+    return rows.map(([label, value]) => (
+      <View key={label} style={[styles.row, { borderBottomColor: theme.border }]}>
+        <Text style={[styles.rowLabel, { color: theme.text }]}>{label}</Text>
+        <Text style={[styles.rowValue, { color: theme.textSecondary }]}>{value}</Text>
+      </View>
+    ));
+  };
+
+  // Render the newest stalls first, each with the spans that were running during it
+  const renderStalls = () => {
+    if (stalls.length === 0) {
+      return (
+        <View style={[styles.row, { borderBottomColor: theme.border }]}>
+          <Text style={[styles.rowValue, { color: theme.textSecondary }]}>No stalls recorded</Text>
+        </View>
+      );
+    }
+
+    return stalls.slice(-SHOWN_STALLS).reverse().map(stall => {
+      const blame = [...stall.openSpans, ...stall.overlappingSpans];
+      return (
+        <View key={stall.at} style={[styles.row, { borderBottomColor: theme.border }]}>
+          <View style={styles.resultHeader}>
+            <Text style={[styles.rowLabel, { color: theme.text }]}>{`${Math.round(stall.durationMs)}ms`}</Text>
+            <Text style={[styles.rowValue, { color: theme.textSecondary }]}>
+              {new Date(stall.at).toLocaleTimeString()}
+            </Text>
+          </View>
+          <Text style={[styles.detail, { color: theme.textSecondary }]} numberOfLines={2}>
+            {blame.length > 0 ? blame.join(', ') : 'No active span'}
+          </Text>
+        </View>
+      );
+    });
+  };
+
+  // Render one scenario's result with its main timings
+  const renderResults = (result: BenchmarkReport) => result.scenarios.map(scenario => (
+    <View key={scenario.name} style={[styles.row, { borderBottomColor: theme.border }]}>
+      <View style={styles.resultHeader}>
+        <Text style={[styles.rowLabel, { color: theme.text }]}>{scenario.name}</Text>
+        <Text style={[styles.rowValue, { color: scenario.passed ? theme.textSecondary : theme.error }]}>
+          {scenario.passed ? `${Math.round(scenario.wallTimeMs)}ms` : 'failed'}
+        </Text>
+      </View>
+      {scenario.error && (
+        <Text style={[styles.detail, { color: theme.error }]}>{scenario.error}</Text>
+      )}
+      {Object.entries(scenario.timings).map(([name, timing]) => (
+        <Text key={name} style={[styles.detail, { color: theme.textSecondary }]}>
+          {timing.count > 1
+            ? `${name}: p50 ${timing.p50Ms}ms, p95 ${timing.p95Ms}ms (${timing.count}x)`
+            : `${name}: ${timing.totalMs}ms`}
+        </Text>
+      ))}
+      <Text style={[styles.detail, { color: theme.textSecondary }]}>
+        {`I/O ${scenario.io.calls} calls, ${Math.round(scenario.io.totalMs)}ms · ${scenario.jank.longTasks} long tasks`}
+      </Text>
+    </View>
+  ));
+
+  return (
+    <ScrollView style={[styles.container, { backgroundColor: theme.background }]}>
+      {renderSectionHeader('App')}
+      {renderAppState()}
+
+      {renderSectionHeader(`Recent Stalls · ${stalls.length}`)}
+      {renderStalls()}
+      <View style={styles.stallActions}>
+        <TouchableOpacity style={styles.stallButton} onPress={() => setStalls(jankWatchdog.getRecentStalls())}>
+          <Ionicons name="refresh" size={18} color={theme.primary} />
+          <Text style={[styles.shareText, { color: theme.primary }]}>Refresh</Text>
+        </TouchableOpacity>
+        <TouchableOpacity style={styles.stallButton} onPress={handleShareJank}>
+          <Ionicons name="share-outline" size={18} color={theme.primary} />
+          <Text style={[styles.shareText, { color: theme.primary }]}>Share Jank Report</Text>
+        </TouchableOpacity>
+      </View>
+
+      {renderSectionHeader('Benchmark')}
+      <View style={styles.controls}>
+        <Text style={[styles.description, { color: theme.textSecondary }]}>
+          Runs catalog load, search, fixture import, cache resolve, a simulated sync, player scheduling, a simulated day of playback and the device library provider against a sandboxed synthetic library.
+          Your own library is not affected.
+        </Text>
+        <View style={styles.optionsContainer}>
+          {Object.keys(SCALES).map(option => (
+            <TouchableOpacity
+              key={option}
+              style={[styles.optionButton, { backgroundColor: scale === option ? theme.primary : theme.surface }]}
+              onPress={() => setScale(option)}
+              disabled={isRunning}
+            >
+              <Text style={[styles.optionText, { color: scale === option ? '#fff' : theme.textSecondary }]}>{option}</Text>
+            </TouchableOpacity>
+          ))}
+        </View>
+        <TouchableOpacity
+          style={[styles.runButton, { backgroundColor: theme.primary, opacity: isRunning ? 0.6 : 1 }]}
+          onPress={handleRun}
+          disabled={isRunning}
+        >
+          {isRunning ? (
+            <ActivityIndicator size="small" color="#fff" />
+          ) : (
+            <Ionicons name="speedometer-outline" size={20} color="#fff" />
+          )}
+          <Text style={styles.runButtonText}>{isRunning ? progress || 'Preparing...' : 'Run Benchmarks'}</Text>
+        </TouchableOpacity>
+      </View>
+
+      {report && (
+        <>
+          {renderSectionHeader(`Results · ${report.device.model}`)}
+          {renderResults(report)}
+          {reportPath && (
+            <TouchableOpacity style={styles.shareButton} onPress={() => handleShare(reportPath)}>
+              <Ionicons name="share-outline" size={18} color={theme.primary} />
+              <Text style={[styles.shareText, { color: theme.primary }]}>Share JSON</Text>
+            </TouchableOpacity>
+          )}
+        </>
+      )}
+
+      {savedReports.length > 0 && (
+        <>
+          {renderSectionHeader('Saved Reports')}
+          {savedReports.map(path => (
+            <TouchableOpacity
+              key={path}
+              style={[styles.row, styles.savedRow, { borderBottomColor: theme.border }]}
+              onPress={() => handleShare(path)}
+            >
+              <Text style={[styles.rowValue, { color: theme.text }]} numberOfLines={1}>
+                {path.slice(path.lastIndexOf('/') + 1)}
+              </Text>
+              <Ionicons name="share-outline" size={18} color={theme.textSecondary} />
+            </TouchableOpacity>
+          ))}
+        </>
+      )}
+    </ScrollView>
+  );
+};
+
+const styles = StyleSheet.create({
+  container: {
+    flex: 1,
+  },
+  sectionHeader: {
+    paddingVertical: 8,
+    paddingHorizontal: 16,
+    borderBottomWidth: 1,
+  },
+  sectionHeaderText: {
+    fontSize: 14,
+    fontWeight: '600',
+    textTransform: 'uppercase',
+  },
+  row: {
+    paddingVertical: 12,
+    paddingHorizontal: 16,
+    borderBottomWidth: 1,
+  },
+  savedRow: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    justifyContent: 'space-between',
+  },
+  resultHeader: {
+    flexDirection: 'row',
+    justifyContent: 'space-between',
+    marginBottom: 4,
+  },
+  rowLabel: {
+    fontSize: 16,
+    fontWeight: '500',
+  },
+  rowValue: {
+    fontSize: 14,
+    flexShrink: 1,
+  },
+  detail: {
+    fontSize: 12,
+    marginTop: 2,
+  },
+  controls: {
+    padding: 16,
+  },
+  description: {
+    fontSize: 14,
+    marginBottom: 12,
+  },
+  optionsContainer: {
+    flexDirection: 'row',
+    flexWrap: 'wrap',
+    marginBottom: 8,
+  },
+  optionButton: {
+    paddingVertical: 6,
+    paddingHorizontal: 12,
+    borderRadius: 16,
+    marginRight: 8,
+    marginBottom: 8,
+  },
+  optionText: {
+    fontSize: 14,
+  },
+  runButton: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    justifyContent: 'center',
+    paddingVertical: 12,
+    borderRadius: 8,
+  },
+  runButtonText: {
+    color: '#fff',
+    fontSize: 16,
+    fontWeight: '500',
+    marginLeft: 8,
+  },
+  shareButton: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    justifyContent: 'center',
+    padding: 16,
+  },
+  shareText: {
+    fontSize: 16,
+    marginLeft: 6,
+  },
+  stallActions: {
+    flexDirection: 'row',
+    justifyContent: 'space-around',
+  },
+  stallButton: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    padding: 16,
+  },
+});
+
+export default DiagnosticsScreen;
\ No newline at end of file
@@ -0,0 +1,341 @@
+/**
+ * Drive Browser Screen
+ * Lists a OneDrive folder page by page, so music can be played before a sync has finished
+ */
+
+import React, { useCallback, useEffect, useRef, useState } from 'react';
+import { View, Text, StyleSheet, FlatList, TouchableOpacity, ActivityIndicator, Alert, ViewToken } from 'react-native';
+import { useRoute, useNavigation, RouteProp } from '@react-navigation/native';
+import { StackNavigationProp } from '@react-navigation/stack';
+import { Ionicons } from '@expo/vector-icons';
+
+import { useStore } from '../store';
+import { Track, Playlist } from '../types';
+import { DriveFolder } from '../services/storage/SyncScopes';
+import { RootStackParamList } from '../navigation/AppNavigator';
+import { logger } from '../utils/logger';
+import { useTheme } from '../theme/ThemeContext';
+import { formatFileSize, formatTime as formatDuration, extractCleanTitle } from '../utils/formatters';
+import { userActivity } from '../services/scheduler/UserActivity';
+import { headPrefetcher } from '../services/prefetch/HeadPrefetcher';
+
+type DriveBrowserRouteProp = RouteProp<RootStackParamList, 'DriveBrowser'>;
+
+type BrowserRow =
+  | { kind: 'folder'; folder: DriveFolder }
+  | { kind: 'track'; track: Track; index: number };
+
+// Rows count as visible once mostly on screen and not just scrolled past
+const VIEWABILITY_CONFIG = { itemVisiblePercentThreshold: 50, minimumViewTime: 250 };
+
+const DriveBrowserScreen = () => {
+  const route = useRoute<DriveBrowserRouteProp>();
+  const navigation = useNavigation<StackNavigationProp<RootStackParamList>>();
+  const { browseRemoteFolder, playPlaylist, warmUpTrack, releaseWarmUp } = useStore();
+  const { theme } = useTheme();
+  const [folders, setFolders] = useState<DriveFolder[]>([]);
+  const [tracks, setTracks] = useState<Track[]>([]);
+  const [nextLink, setNextLink] = useState<string | null>(null);
+  const [isLoading, setIsLoading] = useState(true);
+  const [isLoadingMore, setIsLoadingMore] = useState(false);
+  const [isStartingFolder, setIsStartingFolder] = useState(false);
+
+  // Root of the drive when no folder is given
+  const folderId = route.params?.folderId ?? null;
+  const folderName = route.params?.name ?? 'OneDrive';
+
+  // A page request can still be running when the next one is asked for
+  const loadingPage = useRef(false);
+
+  // Fetch the first seconds of the rows on screen so a tap starts instantly
+  const handleViewableItemsChanged = useRef(({ viewableItems }: { viewableItems: ViewToken[] }) => {
+    const visible = viewableItems
+      .map(token => token.item as BrowserRow)
+      .filter(row => row.kind === 'track')
+      .map(row => (row as { track: Track }).track);
+    headPrefetcher.request('visible', visible);
+  }).current;
+
+  // Stop fetching for rows that are no longer on screen
+  useEffect(() => {
+    return () => headPrefetcher.request('visible', []);
+  }, []);
+
+  // Load the first page of the folder
+  useEffect(() => {
+    const loadFolder = async () => {
+      try {
+        setIsLoading(true);
+        loadingPage.current = true;
+        const page = await browseRemoteFolder(folderId);
+        setFolders(page.folders);
+        setTracks(page.tracks);
+        setNextLink(page.nextLink);
+      } catch (error) {
+        logger.error('Error browsing OneDrive folder', error);
+        Alert.alert('Error', 'Failed to load this OneDrive folder');
+      } finally {
+        loadingPage.current = false;
+        setIsLoading(false);
+      }
+    };
+
+    loadFolder();
+  }, [folderId]);
+
+  // Load the next page when the list nears its end
+  const handleEndReached = useCallback(async () => {
+    if (!nextLink || loadingPage.current) return;
+
+    try {
+      setIsLoadingMore(true);
+      loadingPage.current = true;
+      const page = await browseRemoteFolder(folderId, nextLink);
+      setFolders(current => [...current, ...page.folders]);
+      setTracks(current => [...current, ...page.tracks]);
+      setNextLink(page.nextLink);
+    } catch (error) {
+      logger.error('Error loading more of a OneDrive folder', error);
+    } finally {
+      loadingPage.current = false;
+      setIsLoadingMore(false);
+    }
+  }, [folderId, nextLink]);
+
+  // Play the folder's audio files as an ad-hoc queue
+  // A tapped row starts right away with the files listed so far, Play Folder lists the rest first
+  const handlePlayFolder = async (startIndex = 0, listAll = false) => {
+    if (listAll && loadingPage.current) return;
+
+    try {
+      setIsStartingFolder(true);
+
+      let queue = tracks;
+      let link = listAll ? nextLink : null;
+      if (link) {
+        loadingPage.current = true;
+        const moreFolders: DriveFolder[] = [];
+        while (link) {
+          const page = await browseRemoteFolder(folderId, link);
+          moreFolders.push(...page.folders);
+          queue = [...queue, ...page.tracks];
+          link = page.nextLink;
+        }
+        setFolders(current => [...current, ...moreFolders]);
+        setTracks(queue);
+        setNextLink(null);
+      }
+
+      if (queue.length === 0) {
+        Alert.alert('No Music', 'This folder has no audio files');
+        return;
+      }
+
+      const now = new Date();
+      const folderQueue: Playlist = {
+        id: `onedrive-folder-${folderId || 'root'}`,
+        name: folderName,
+        tracks: queue,
+        createdAt: now,
+        updatedAt: now
+      };
+      await playPlaylist(folderQueue, startIndex);
+    } catch (error) {
+      logger.error('Error playing OneDrive folder', error);
+      Alert.alert('Error', 'Failed to play this folder');
+    } finally {
+      if (listAll) {
+        loadingPage.current = false;
+      }
+      setIsStartingFolder(false);
+    }
+  };
+
+  // Render folder or track row
+  const renderRow = ({ item }: { item: BrowserRow }) => {
+    if (item.kind === 'folder') {
+      const { folder } = item;
+      return (
+        <TouchableOpacity
+          style={[styles.row, { backgroundColor: theme.cardBackground, borderBottomColor: theme.border }]}
+          onPress={() => navigation.push('DriveBrowser', { folderId: folder.id, name: folder.name })}
+        >
+          <View style={[styles.iconContainer, { backgroundColor: theme.surface }]}>
+            <Ionicons name="folder" size={22} color={theme.primary} />
+          </View>
+          <View style={styles.rowInfo}>
+            <Text style={[styles.rowTitle, { color: theme.text }]} numberOfLines={1}>{folder.name}</Text>
+            <Text style={[styles.rowDetails, { color: theme.textSecondary }]} numberOfLines={1}>
+              {folder.childCount} items • {formatFileSize(folder.size)}
+            </Text>
+          </View>
+          <Ionicons name="chevron-forward" size={20} color={theme.textSecondary} />
+        </TouchableOpacity>
+      );
+    }
+
+    const { track, index } = item;
+    return (
+      <TouchableOpacity
+        style={[styles.row, { backgroundColor: theme.cardBackground, borderBottomColor: theme.border }]}
+        onPressIn={() => warmUpTrack(track)}
+        onPressOut={() => releaseWarmUp(track)}
+        onPress={() => handlePlayFolder(index)}
+        disabled={isStartingFolder}
+      >
+        <View style={[styles.iconContainer, { backgroundColor: theme.surface }]}>
+          <Ionicons name="musical-note" size={22} color={theme.primary} />
+        </View>
+        <View style={styles.rowInfo}>
+          <Text style={[styles.rowTitle, { color: theme.text }]} numberOfLines={1}>
+            {extractCleanTitle(track.title, track.artist)}
+          </Text>
+          <Text style={[styles.rowDetails, { color: theme.textSecondary }]} numberOfLines={1}>
+            {track.artist || 'Unknown artist'}
+            {track.duration ? ` • ${formatDuration(track.duration)}` : ''}
+          </Text>
+        </View>
+      </TouchableOpacity>
+    );
+  };
+
+  if (isLoading) {
+    return (
+      <View style={[styles.loadingContainer, { backgroundColor: theme.background }]}>
+        <ActivityIndicator size="large" color={theme.primary} />
+        <Text style={[styles.loadingText, { color: theme.textSecondary }]}>Loading {folderName}...</Text>
+      </View>
+    );
+  }
+
+  const rows: BrowserRow[] = [
+    ...folders.map(folder => ({ kind: 'folder' as const, folder })),
+    ...tracks.map((track, index) => ({ kind: 'track' as const, track, index }))
+  ];
+
+  return (
+    <View style={[styles.container, { backgroundColor: theme.background }]}>
+      {tracks.length > 0 && (
+        <View style={[styles.actions, { borderBottomColor: theme.border }]}>
+          <TouchableOpacity
+            style={[styles.playButton, { backgroundColor: theme.primary }]}
+            onPress={() => handlePlayFolder(0, true)}
+            disabled={isStartingFolder}
+          >
+            {isStartingFolder ? (
+              <ActivityIndicator size="small" color="#fff" />
+            ) : (
+              <Ionicons name="play" size={20} color="#fff" />
+            )}
+            <Text style={styles.playButtonText}>Play Folder</Text>
+          </TouchableOpacity>
+          <Text style={[styles.actionsText, { color: theme.textSecondary }]}>
+            {tracks.length}{nextLink ? '+' : ''} {tracks.length === 1 ? 'track' : 'tracks'}
+          </Text>
+        </View>
+      )}
+
+      <FlatList
+        data={rows}
+        renderItem={renderRow}
+        keyExtractor={(row) => row.kind === 'folder' ? row.folder.id : row.track.id}
+        onEndReached={handleEndReached}
+        onEndReachedThreshold={0.5}
+        onScrollBeginDrag={() => userActivity.markActive()}
+        onViewableItemsChanged={handleViewableItemsChanged}
+        viewabilityConfig={VIEWABILITY_CONFIG}
+        contentContainerStyle={styles.listContent}
+        ListFooterComponent={isLoadingMore ? <ActivityIndicator style={styles.footerLoader} color={theme.primary} /> : null}
+        ListEmptyComponent={
+          <View style={styles.emptyContainer}>
+            <Ionicons name="folder-open-outline" size={64} color={theme.primary} />
+            <Text style={[styles.emptyText, { color: theme.textSecondary }]}>No folders or audio files here</Text>
+          </View>
+        }
+      />
+    </View>
+  );
+};
+
+const styles = StyleSheet.create({
+  container: {
+    flex: 1,
+  },
+  loadingContainer: {
+    flex: 1,
+    justifyContent: 'center',
+    alignItems: 'center',
+  },
+  loadingText: {
+    fontSize: 16,
+    marginTop: 16,
+  },
+  actions: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    padding: 16,
+    borderBottomWidth: 1,
+  },
+  playButton: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    paddingVertical: 8,
+    paddingHorizontal: 16,
+    borderRadius: 20,
+  },
+  playButtonText: {
+    color: '#fff',
+    fontWeight: '500',
+    marginLeft: 8,
+  },
+  actionsText: {
+    fontSize: 14,
+    marginLeft: 16,
+  },
+  listContent: {
+    flexGrow: 1,
+  },
+  row: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    paddingVertical: 12,
+    paddingHorizontal: 16,
+    borderBottomWidth: 1,
+  },
+  iconContainer: {
+    width: 40,
+    height: 40,
+    borderRadius: 4,
+    justifyContent: 'center',
+    alignItems: 'center',
+    marginRight: 12,
+  },
+  rowInfo: {
+    flex: 1,
+    justifyContent: 'center',
+  },
+  rowTitle: {
+    fontSize: 16,
+    fontWeight: '500',
+    marginBottom: 2,
+  },
+  rowDetails: {
+    fontSize: 14,
+  },
+  footerLoader: {
+    marginVertical: 16,
+  },
+  emptyContainer: {
+    flex: 1,
+    justifyContent: 'center',
+    alignItems: 'center',
+    padding: 24,
+  },
+  emptyText: {
+    fontSize: 16,
+    marginTop: 16,
+    textAlign: 'center',
+  },
+});
+
+export default DriveBrowserScreen;
\ No newline at end of file
@@ -3,7 +3,7 @@
  * Main screen for browsing music library
  */
 
-import React, { useEffect, useState } from 'react';
+import React, { useEffect, useRef, useState } from 'react';
 import { View, Text, StyleSheet, FlatList, TouchableOpacity, ActivityIndicator, RefreshControl, Image, Alert } from 'react-native';
 import { useNavigation } from '@react-navigation/native';
 import { StackNavigationProp } from '@react-navigation/stack';
@@ -18,17 +18,48 @@ import { logger } from '../utils/logger';
 import { useTheme } from '../theme/ThemeContext';
 import { formatTime as formatDuration, extractCleanTitle } from '../utils/formatters';
 import FloatingActionButton from '../components/common/FloatingActionButton';
+import IndexRail from '../components/common/IndexRail';
+import { buildSectionedListInSlices, getSectionedRowLayout, SectionedList, SectionedRow } from '../utils/sectionIndex';
 import { usePlayerStore } from '../store/playerStore';
+import { userActivity } from '../services/scheduler/UserActivity';
+import { taskScheduler, TaskPriority, TaskCancelledError } from '../services/scheduler/TaskScheduler';
+
+// Rows have fixed heights so section offsets can be computed instead of measured
+const TRACK_ROW_HEIGHT = 80;
+const SECTION_HEADER_HEIGHT = 28;
+const SECTION_LAYOUT = { itemHeight: TRACK_ROW_HEIGHT, headerHeight: SECTION_HEADER_HEIGHT };
+const EMPTY_SECTIONED_LIST: SectionedList<Track> = { rows: [], rowOffsets: new Float64Array(1), sections: [] };
 
 const LibraryScreen = () => {
   const navigation = useNavigation<StackNavigationProp<RootStackParamList>>();
-  const { tracks, playlists, isLibraryLoading, loadLibrary, playTrack, playPlaylist, importLocalTracksFromFolder } = useStore();
+  const { tracks, tracksOrderVersion, playlists, isLibraryLoading, loadLibrary, playTrack, playPlaylist, warmUpTrack, releaseWarmUp, importLocalTracksFromFolder } = useStore();
   const { theme } = useTheme();
   const [refreshing, setRefreshing] = useState(false);
   const [activeTab, setActiveTab] = useState<'tracks' | 'playlists'>('tracks');
   const insets = useSafeAreaInsets();
   const playerState = usePlayerStore(state => state.playerState);
   const hasTrack = !!playerState.currentTrack;
+  const trackListRef = useRef<FlatList<SectionedRow<Track>>>(null);
+  const [sectionedTracks, setSectionedTracks] = useState<SectionedList<Track>>(EMPTY_SECTIONED_LIST);
+
+  // Sort tracks into lettered sections only when tracks come and go or a title or artist changes
+  // Rows are live catalog views, so other updates such as reloaded artwork show without a re-sort
+  // The sort runs in slices on the task scheduler; the previous list stays on screen until it finishes
+  useEffect(() => {
+    const build = taskScheduler.schedule(
+      () => buildSectionedListInSlices(tracks, track => extractCleanTitle(track.title, track.artist), SECTION_LAYOUT),
+      { priority: TaskPriority.USER_BLOCKING, label: 'library-sections' }
+    );
+    build.promise
+      .then(setSectionedTracks)
+      .catch(error => {
+        // A newer build replaced this one
+        if (!(error instanceof TaskCancelledError)) {
+          logger.error('Error sorting library tracks', error);
+        }
+      });
+    return build.cancel;
+  }, [tracks.length, tracksOrderVersion]);
 
   // Load library on component mount
   useEffect(() => {
@@ -79,6 +110,8 @@ const LibraryScreen = () => {
     return (
       <TouchableOpacity 
         style={[styles.trackItem, { backgroundColor: theme.cardBackground, borderBottomColor: theme.border }]} 
+        onPressIn={() => warmUpTrack(item)}
+        onPressOut={() => releaseWarmUp(item)}
         onPress={() => handleTrackPress(item)}
       >
         <View style={[styles.trackIconContainer, { backgroundColor: theme.surface }]}>
@@ -99,7 +132,7 @@ const LibraryScreen = () => {
             {item.album ? ` • ${item.album}` : ''}
           </Text>
           <Text style={[styles.trackSource, { color: theme.textSecondary }]} numberOfLines={1}>
-            {item.source === 'local' ? 'Local' : 'OneDrive'}
+            {item.source === 'onedrive' ? 'OneDrive' : item.source === 'media-library' ? 'Device' : 'Local'}
             {item.duration ? ` • ${formatDuration(item.duration)}` : ''}
           </Text>
         </View>
@@ -110,6 +143,26 @@ const LibraryScreen = () => {
     );
   };
 
+  // Render section header or track row
+  const renderTrackRow = ({ item }: { item: SectionedRow<Track> }) => {
+    if (item.type === 'header') {
+      return (
+        <View style={[styles.sectionHeader, { backgroundColor: theme.surface }]}>
+          <Text style={[styles.sectionHeaderText, { color: theme.textSecondary }]}>{item.label}</Text>
+        </View>
+      );
+    }
+    return renderTrackItem({ item: item.item });
+  };
+
+  // Jump straight to a section, only the rows around it are rendered
+  const handleSectionSelect = (index: number) => {
+    const section = sectionedTracks.sections[index];
+    if (section) {
+      trackListRef.current?.scrollToOffset({ offset: section.offset, animated: false });
+    }
+  };
+
   // Render playlist item
   const renderPlaylistItem = ({ item }: { item: Playlist }) => (
     <TouchableOpacity 
@@ -134,7 +187,8 @@ const LibraryScreen = () => {
 
   // Render empty state
   const renderEmptyState = () => {
-    if (isLibraryLoading) {
+    // Tracks whose first sort hasn't finished yet
+    if (isLibraryLoading || (activeTab === 'tracks' && tracks.length > 0)) {
       return (
         <View style={styles.emptyContainer}>
           <ActivityIndicator size="large" color={theme.primary} />
@@ -212,26 +266,40 @@ const LibraryScreen = () => {
 
       {/* Content */}
       {activeTab === 'tracks' ? (
-        <FlatList
-          data={tracks}
-          renderItem={renderTrackItem}
-          keyExtractor={(item) => item.id}
-          contentContainerStyle={tracks.length === 0 ? { flex: 1 } : null}
-          ListEmptyComponent={renderEmptyState}
-          refreshControl={
-            <RefreshControl 
-              refreshing={refreshing} 
-              onRefresh={handleRefresh} 
-              tintColor={theme.primary}
-              colors={[theme.primary]}
+        <View style={styles.trackListContainer}>
+          <FlatList
+            ref={trackListRef}
+            data={sectionedTracks.rows}
+            renderItem={renderTrackRow}
+            keyExtractor={(row) => row.type === 'header' ? `section-${row.label}` : row.item.id}
+            getItemLayout={(_, index) => getSectionedRowLayout(sectionedTracks, index)}
+            extraData={tracks}
+            onScrollBeginDrag={() => userActivity.markActive()}
+            contentContainerStyle={tracks.length === 0 ? { flex: 1 } : null}
+            ListEmptyComponent={renderEmptyState}
+            refreshControl={
+              <RefreshControl 
+                refreshing={refreshing} 
+                onRefresh={handleRefresh} 
+                tintColor={theme.primary}
+                colors={[theme.primary]}
+              />
+            }
+          />
+          {sectionedTracks.sections.length > 1 && (
+            <IndexRail
+              labels={sectionedTracks.sections.map(section => section.label)}
+              onSelect={handleSectionSelect}
+              bottom={hasTrack ? 150 : 90}
             />
-          }
-        />
+          )}
+        </View>
       ) : (
         <FlatList
           data={playlists}
           renderItem={renderPlaylistItem}
           keyExtractor={(item) => item.id}
+          onScrollBeginDrag={() => userActivity.markActive()}
           contentContainerStyle={playlists.length === 0 ? { flex: 1 } : null}
           ListEmptyComponent={renderEmptyState}
           refreshControl={
@@ -282,10 +350,24 @@ const styles = StyleSheet.create({
   activeTabText: {
     fontWeight: 'bold',
   },
+  trackListContainer: {
+    flex: 1,
+  },
+  sectionHeader: {
+    height: SECTION_HEADER_HEIGHT,
+    justifyContent: 'center',
+    paddingHorizontal: 12,
+  },
+  sectionHeaderText: {
+    fontSize: 14,
+    fontWeight: 'bold',
+  },
   trackItem: {
     flexDirection: 'row',
     alignItems: 'center',
-    padding: 12,
+    height: TRACK_ROW_HEIGHT,
+    paddingHorizontal: 12,
+    paddingRight: 28, // clear of the index rail
     borderBottomWidth: 1,
   },
   trackIconContainer: {
@@ -98,7 +98,7 @@ const PlayerScreen = () => {
           {currentTrack.artist || 'Unknown artist'}
         </Text>
         <Text style={styles.source}>
-          Source: {currentTrack.source === 'local' ? 'Local Storage' : 'OneDrive'}
+          Source: {currentTrack.source === 'onedrive' ? 'OneDrive' : currentTrack.source === 'media-library' ? 'Device Library' : 'Local Storage'}
         </Text>
       </View>
       
@@ -3,7 +3,7 @@
  * Displays details and tracks for a specific playlist
  */
 
-import React, { useEffect, useState } from 'react';
+import React, { useEffect, useRef, useState } from 'react';
 import { 
   View, 
   Text, 
@@ -11,7 +11,8 @@ import {
   FlatList, 
   TouchableOpacity, 
   ActivityIndicator,
-  Image
+  Image,
+  ViewToken
 } from 'react-native';
 import { useRoute, useNavigation, RouteProp } from '@react-navigation/native';
 import { Ionicons } from '@expo/vector-icons';
@@ -20,9 +21,14 @@ import { useStore } from '../store';
 import { Track, Playlist } from '../types';
 import { logger } from '../utils/logger';
 import { RootStackParamList } from '../navigation/AppNavigator';
+import { userActivity } from '../services/scheduler/UserActivity';
+import { headPrefetcher } from '../services/prefetch/HeadPrefetcher';
 
 type PlaylistDetailRouteProp = RouteProp<RootStackParamList, 'PlaylistDetail'>;
 
+// Rows count as visible once mostly on screen and not just scrolled past
+const VIEWABILITY_CONFIG = { itemVisiblePercentThreshold: 50, minimumViewTime: 250 };
+
 /**
  * Format duration in milliseconds to mm:ss format
  */
@@ -39,13 +45,23 @@ const formatDuration = (durationMs?: number): string => {
 const PlaylistDetailScreen = () => {
   const route = useRoute<PlaylistDetailRouteProp>();
   const navigation = useNavigation();
-  const { playlists, playTrack, playPlaylist } = useStore();
+  const { playlists, playTrack, playPlaylist, warmUpTrack, releaseWarmUp } = useStore();
   const [playlist, setPlaylist] = useState<Playlist | null>(null);
   const [isLoading, setIsLoading] = useState(true);
 
   // Get playlist ID from route params
   const { playlistId } = route.params;
 
+  // Fetch the first seconds of the rows on screen so a tap starts instantly
+  const handleViewableItemsChanged = useRef(({ viewableItems }: { viewableItems: ViewToken[] }) => {
+    headPrefetcher.request('visible', viewableItems.map(token => token.item as Track));
+  }).current;
+
+  // Stop fetching for rows that are no longer on screen
+  useEffect(() => {
+    return () => headPrefetcher.request('visible', []);
+  }, []);
+
   // Load playlist data
   useEffect(() => {
     const loadPlaylist = () => {
@@ -100,6 +116,8 @@ const PlaylistDetailScreen = () => {
     return (
       <TouchableOpacity 
         style={styles.trackItem} 
+        onPressIn={() => warmUpTrack(item)}
+        onPressOut={() => releaseWarmUp(item)}
         onPress={() => handleTrackPress(item, index)}
       >
         <Text style={styles.trackNumber}>{index + 1}</Text>
@@ -181,6 +199,9 @@ const PlaylistDetailScreen = () => {
         data={playlist.tracks}
         renderItem={renderTrackItem}
         keyExtractor={(item) => item.id}
+        onScrollBeginDrag={() => userActivity.markActive()}
+        onViewableItemsChanged={handleViewableItemsChanged}
+        viewabilityConfig={VIEWABILITY_CONFIG}
         contentContainerStyle={styles.listContent}
         ListEmptyComponent={
           <View style={styles.emptyContainer}>
@@ -3,7 +3,7 @@
  * Allows users to search for tracks in their music library
  */
 
-import React, { useState, useEffect } from 'react';
+import React, { useState, useEffect, useMemo } from 'react';
 import { 
   View, 
   Text, 
@@ -13,7 +13,8 @@ import {
   TouchableOpacity, 
   ActivityIndicator,
   Keyboard,
-  Image 
+  Image,
+  Alert
 } from 'react-native';
 import { Ionicons } from '@expo/vector-icons';
 import { useSafeAreaInsets } from 'react-native-safe-area-context';
@@ -22,6 +23,15 @@ import { useStore } from '../store';
 import { Track } from '../types';
 import { logger } from '../utils/logger';
 import { useTheme } from '../theme/ThemeContext';
+import { userActivity } from '../services/scheduler/UserActivity';
+import { tracing } from '../utils/tracing';
+import { storageManager } from '../services/storage/StorageManager';
+import { catalog } from '../services/catalog/Catalog';
+import { searchIndex } from '../services/search/SearchIndex';
+
+// Server-side search only runs for settled, specific queries
+const REMOTE_SEARCH_MIN_LENGTH = 3;
+const REMOTE_SEARCH_DEBOUNCE_MS = 800;
 
 /**
  * Format duration in milliseconds to mm:ss format
@@ -37,15 +47,24 @@ const formatDuration = (durationMs?: number): string => {
 };
 
 const SearchScreen = () => {
-  const { tracks, playTrack } = useStore();
+  const { tracks, playTrack, warmUpTrack, releaseWarmUp, ingestRemoteTrack } = useStore();
   const { theme } = useTheme();
   const [searchQuery, setSearchQuery] = useState('');
   const [searchResults, setSearchResults] = useState<Track[]>([]);
+  const [remoteResults, setRemoteResults] = useState<Track[]>([]);
   const [isSearching, setIsSearching] = useState(false);
+  const [isSearchingRemote, setIsSearchingRemote] = useState(false);
   const insets = useSafeAreaInsets();
 
+  // Load the persisted search index while the user starts typing
+  useEffect(() => {
+    searchIndex.warmUp();
+  }, []);
+
   // Perform search when query changes
   useEffect(() => {
+    let cancelled = false;
+
     const performSearch = async () => {
       if (!searchQuery.trim()) {
         setSearchResults([]);
@@ -54,41 +73,104 @@ const SearchScreen = () => {
 
       setIsSearching(true);
       try {
-        // Filter tracks based on search query
-        const query = searchQuery.toLowerCase();
-        const results = tracks.filter(track => 
-          track.title.toLowerCase().includes(query) ||
-          (track.artist && track.artist.toLowerCase().includes(query)) ||
-          (track.album && track.album.toLowerCase().includes(query))
-        );
-
-        setSearchResults(results);
+        const results = await tracing.trace('search', () => searchIndex.search(searchQuery), { queryLength: searchQuery.length });
+        if (!cancelled) {
+          setSearchResults(results);
+          setIsSearching(false);
+        }
       } catch (error) {
+        if (cancelled) {
+          // Superseded by a newer query, which owns the loading state
+          return;
+        }
         logger.error('Error performing search', error);
-      } finally {
         setIsSearching(false);
       }
     };
 
-    // Debounce search to avoid excessive filtering
+    // Debounce search to avoid excessive lookups while typing
     const debounceTimeout = setTimeout(performSearch, 300);
-    return () => clearTimeout(debounceTimeout);
+    return () => {
+      cancelled = true;
+      clearTimeout(debounceTimeout);
+    };
   }, [searchQuery, tracks]);
 
+  // Ask the connected providers' servers for matches the library hasn't indexed
+  useEffect(() => {
+    const query = searchQuery.trim();
+    setRemoteResults([]);
+    if (query.length < REMOTE_SEARCH_MIN_LENGTH) {
+      setIsSearchingRemote(false);
+      return;
+    }
+
+    let cancelled = false;
+    const debounceTimeout = setTimeout(async () => {
+      setIsSearchingRemote(true);
+      try {
+        const results = await tracing.trace('search-remote', () => storageManager.searchRemote(query), { queryLength: query.length });
+        if (!cancelled) {
+          setRemoteResults(results);
+        }
+      } catch (error) {
+        logger.error('Error performing remote search', error);
+      } finally {
+        if (!cancelled) {
+          setIsSearchingRemote(false);
+        }
+      }
+    }, REMOTE_SEARCH_DEBOUNCE_MS);
+
+    return () => {
+      cancelled = true;
+      clearTimeout(debounceTimeout);
+    };
+  }, [searchQuery]);
+
+  // Library matches first, then remote matches the library search didn't already return
+  const mergedResults = useMemo(() => {
+    if (remoteResults.length === 0) return searchResults;
+
+    const seen = new Set(searchResults.map(track => track.id));
+    const merged = [...searchResults];
+    for (const track of remoteResults) {
+      if (seen.has(track.id)) continue;
+      seen.add(track.id);
+      merged.push(catalog.get(track.id) || track);
+    }
+    return merged;
+  }, [searchResults, remoteResults]);
+
   // Handle track press
-  const handleTrackPress = (track: Track) => {
-    playTrack(track);
+  const handleTrackPress = async (track: Track) => {
     Keyboard.dismiss();
+
+    // Remote results join the library when they are first played
+    if (!catalog.get(track.id)) {
+      try {
+        track = await ingestRemoteTrack(track);
+      } catch (error) {
+        logger.error(`Error adding search result to library: ${track.title}`, error);
+        Alert.alert('Error', 'Failed to add this track to your library');
+        return;
+      }
+    }
+
+    playTrack(track);
   };
 
   // Clear search query
   const handleClearSearch = () => {
     setSearchQuery('');
     setSearchResults([]);
+    setRemoteResults([]);
   };
 
   // Render track item
   const renderTrackItem = ({ item }: { item: Track }) => {
+    const inLibrary = !!catalog.get(item.id);
+    
     // Extract clean title (without artist prefix)
     let cleanTitle = item.title;
     if (cleanTitle.includes('-') && item.artist && cleanTitle.startsWith(item.artist)) {
@@ -98,6 +180,8 @@ const SearchScreen = () => {
     return (
       <TouchableOpacity 
         style={[styles.trackItem, { borderBottomColor: theme.border }]} 
+        onPressIn={() => warmUpTrack(item)}
+        onPressOut={() => releaseWarmUp(item)}
         onPress={() => handleTrackPress(item)}
       >
         <View style={[styles.trackIconContainer, { backgroundColor: theme.surface }]}>
@@ -118,12 +202,13 @@ const SearchScreen = () => {
             {item.album ? ` • ${item.album}` : ''}
           </Text>
           <Text style={[styles.trackSource, { color: theme.textSecondary }]}>
-            {item.source === 'local' ? 'Local' : 'OneDrive'}
+            {item.source === 'onedrive' ? 'OneDrive' : item.source === 'media-library' ? 'Device' : 'Local'}
             {item.duration ? ` • ${formatDuration(item.duration)}` : ''}
+            {inLibrary ? '' : ' • Not in library'}
           </Text>
         </View>
         <TouchableOpacity style={styles.trackAction}>
-          <Ionicons name="play" size={20} color={theme.primary} />
+          <Ionicons name={inLibrary ? 'play' : 'cloud-download-outline'} size={20} color={theme.primary} />
         </TouchableOpacity>
       </TouchableOpacity>
     );
@@ -131,7 +216,7 @@ const SearchScreen = () => {
 
   // Render empty state
   const renderEmptyState = () => {
-    if (isSearching) {
+    if (isSearching || isSearchingRemote) {
       return (
         <View style={styles.emptyContainer}>
           <ActivityIndicator size="large" color={theme.primary} />
@@ -140,7 +225,7 @@ const SearchScreen = () => {
       );
     }
 
-    if (searchQuery.trim() && !searchResults.length) {
+    if (searchQuery.trim() && !mergedResults.length) {
       return (
         <View style={styles.emptyContainer}>
           <Ionicons name="search-outline" size={64} color={theme.primary} />
@@ -190,10 +275,11 @@ const SearchScreen = () => {
 
       {/* Results list */}
       <FlatList
-        data={searchResults}
+        data={mergedResults}
         renderItem={renderTrackItem}
         keyExtractor={(item) => item.id}
-        contentContainerStyle={[styles.listContent, searchResults.length === 0 ? { flex: 1 } : null]}
+        onScrollBeginDrag={() => userActivity.markActive()}
+        contentContainerStyle={[styles.listContent, mergedResults.length === 0 ? { flex: 1 } : null]}
         ListEmptyComponent={renderEmptyState}
       />
     </View>
@@ -3,7 +3,7 @@
  * Allows users to configure app preferences
  */
 
-import React, { useState } from 'react';
+import React, { useCallback, useRef, useState } from 'react';
 import { 
   View, 
   Text, 
@@ -15,18 +15,66 @@ import {
 } from 'react-native';
 import { Ionicons } from '@expo/vector-icons';
 import { useSafeAreaInsets } from 'react-native-safe-area-context';
+import { useNavigation, useFocusEffect } from '@react-navigation/native';
+import { StackNavigationProp } from '@react-navigation/stack';
 
+import { RootStackParamList } from '../navigation/AppNavigator';
 import { useStore } from '../store';
 import { AppSettings, LogLevel } from '../types';
 import { logger } from '../utils/logger';
+import { formatFileSize } from '../utils/formatters';
+import { dataBudget, DataBudgetLevel, DataUsageSnapshot } from '../services/network/DataBudget';
 import { useTheme } from '../theme/ThemeContext';
 import ThemeToggle from '../components/theme/ThemeToggle';
 
+// Taps on the version needed to open the hidden diagnostics screen
+const DIAGNOSTICS_TAP_COUNT = 7;
+const DIAGNOSTICS_TAP_WINDOW_MS = 3000;
+
+// Monthly cellular budgets offered, in MB
+const CELLULAR_BUDGETS: Record<string, number> = {
+  'none': 0,
+  '500 MB': 500,
+  '1 GB': 1024,
+  '2 GB': 2048,
+  '5 GB': 5120,
+  '10 GB': 10240
+};
+
+// What the data policy currently does on cellular
+const DATA_LEVEL_DESCRIPTIONS: Record<DataBudgetLevel, string> = {
+  [DataBudgetLevel.NORMAL]: 'Within budget',
+  [DataBudgetLevel.STREAM_ONLY]: 'Near budget: streaming without caching',
+  [DataBudgetLevel.NO_PREFETCH]: 'Near budget: streaming only, no prefetch',
+  [DataBudgetLevel.CACHED_ONLY]: 'Budget used: playing downloaded tracks only'
+};
+
 const SettingsScreen = () => {
   const { settings, updateSettings } = useStore();
   const [isLoading, setIsLoading] = useState(false);
   const { theme, isDarkMode } = useTheme();
   const insets = useSafeAreaInsets();
+  const navigation = useNavigation<StackNavigationProp<RootStackParamList>>();
+  const versionTaps = useRef<number[]>([]);
+  const [dataUsage, setDataUsage] = useState<DataUsageSnapshot>(() => dataBudget.getSnapshot());
+
+  // Follow data usage while the screen is visible
+  useFocusEffect(
+    useCallback(() => {
+      setDataUsage(dataBudget.getSnapshot());
+      return dataBudget.onChange(setDataUsage);
+    }, [])
+  );
+
+  // Open diagnostics after repeated taps on the version
+  const handleVersionPress = () => {
+    const now = Date.now();
+    versionTaps.current = [...versionTaps.current.filter(at => now - at < DIAGNOSTICS_TAP_WINDOW_MS), now];
+    if (versionTaps.current.length >= DIAGNOSTICS_TAP_COUNT) {
+      versionTaps.current = [];
+      navigation.navigate('Diagnostics');
+    }
+  };
 
   // Handle theme change
   const handleThemeChange = async (theme: 'light' | 'dark' | 'system') => {
@@ -54,6 +102,52 @@ const SettingsScreen = () => {
     }
   };
 
+  // Handle cellular data budget change
+  const handleCellularBudgetChange = async (label: string) => {
+    try {
+      setIsLoading(true);
+      await updateSettings({ cellularDataBudgetMb: CELLULAR_BUDGETS[label] });
+    } catch (error) {
+      logger.error('Error updating cellular data budget', error);
+      Alert.alert('Error', 'Failed to update cellular data budget');
+    } finally {
+      setIsLoading(false);
+    }
+  };
+
+  // Render this month's data usage
+  const renderDataUsage = () => {
+    const budget = dataUsage.cellularBudgetBytes;
+    const fraction = budget > 0 ? Math.min(1, dataUsage.cellularBytes / budget) : 0;
+
+    return (
+      <View style={[styles.settingItem, { borderBottomColor: theme.border }]}>
+        <Text style={[styles.settingTitle, { color: theme.text }]}>This Month</Text>
+        <Text style={[styles.settingValue, { color: theme.textSecondary }]}>
+          Cellular {formatFileSize(dataUsage.cellularBytes)}{budget > 0 ? ` of ${formatFileSize(budget)}` : ''} · Wi-Fi {formatFileSize(dataUsage.wifiBytes)}
+        </Text>
+        {budget > 0 && (
+          <>
+            <View style={[styles.usageBar, { backgroundColor: theme.surface }]}>
+              <View
+                style={[
+                  styles.usageBarFill,
+                  {
+                    width: `${Math.round(fraction * 100)}%`,
+                    backgroundColor: dataUsage.level >= DataBudgetLevel.NO_PREFETCH ? theme.error : theme.primary
+                  }
+                ]}
+              />
+            </View>
+            <Text style={[styles.settingValue, { color: theme.textSecondary }]}>
+              {DATA_LEVEL_DESCRIPTIONS[dataUsage.level]}
+            </Text>
+          </>
+        )}
+      </View>
+    );
+  };
+
   // Render a section header
   const renderSectionHeader = (title: string) => (
     <View style={[styles.sectionHeader, { backgroundColor: theme.surface }]}>
@@ -156,12 +250,24 @@ const SettingsScreen = () => {
         handleDownloadStrategyChange
       )}
 
+      {/* Data Usage */}
+      {renderSectionHeader('Data Usage')}
+      {renderDataUsage()}
+      {renderSettingItem(
+        'Monthly Cellular Budget',
+        Object.keys(CELLULAR_BUDGETS).find(label => CELLULAR_BUDGETS[label] === settings.cellularDataBudgetMb) || `${settings.cellularDataBudgetMb} MB`,
+        Object.keys(CELLULAR_BUDGETS),
+        handleCellularBudgetChange
+      )}
+
       {/* About */}
       {renderSectionHeader('About')}
       <View style={styles.aboutContainer}>
         <Ionicons name="musical-notes" size={48} color={theme.primary} />
         <Text style={[styles.appName, { color: theme.text }]}>Sonora</Text>
-        <Text style={[styles.appVersion, { color: theme.textSecondary }]}>Version 1.0.0</Text>
+        <TouchableOpacity onPress={handleVersionPress} activeOpacity={1}>
+          <Text style={[styles.appVersion, { color: theme.textSecondary }]}>Version 1.0.0</Text>
+        </TouchableOpacity>
         <Text style={[styles.appDescription, { color: theme.textSecondary }]}>
           A music player app for local and OneDrive music libraries
         </Text>
@@ -218,6 +324,16 @@ const styles = StyleSheet.create({
   optionText: {
     fontSize: 14,
   },
+  usageBar: {
+    height: 6,
+    borderRadius: 3,
+    overflow: 'hidden',
+    marginBottom: 8,
+  },
+  usageBarFill: {
+    height: 6,
+    borderRadius: 3,
+  },
   aboutContainer: {
     padding: 24,
     alignItems: 'center',
@@ -7,17 +7,24 @@ import React, { useEffect, useState } from 'react';
 import { View, Text, StyleSheet, TouchableOpacity, ActivityIndicator, Alert, ScrollView } from 'react-native';
 import { Ionicons } from '@expo/vector-icons';
 import { useSafeAreaInsets } from 'react-native-safe-area-context';
+import { useNavigation } from '@react-navigation/native';
+import { StackNavigationProp } from '@react-navigation/stack';
 
 import { useStore } from '../store';
 import { storageManager } from '../services/storage/StorageManager';
-import { StorageProviderInterface } from '../services/storage/StorageProvider';
+import { StorageProviderInterface, isSessionState } from '../services/storage/StorageProvider';
 import { OneDriveStorageProvider } from '../services/storage/OneDriveStorageProvider';
+import { LocalStorageProvider } from '../services/storage/LocalStorageProvider';
+import { SyncScopeRule, DEFAULT_SYNC_FOLDER_NAMES } from '../services/storage/SyncScopes';
+import SyncScopePicker from '../components/storage/SyncScopePicker';
 import { logger } from '../utils/logger';
 import { SyncStatus } from '../config/onedrive';
 import { useTheme } from '../theme/ThemeContext';
+import { RootStackParamList } from '../navigation/AppNavigator';
 
 const StorageProvidersScreen = () => {
-  const { importLocalTracks, importLocalTracksFromFolder } = useStore();
+  const navigation = useNavigation<StackNavigationProp<RootStackParamList>>();
+  const { importLocalTracks, importLocalTracksFromFolder, rescanLocalFolder } = useStore();
   const [providers, setProviders] = useState<StorageProviderInterface[]>([]);
   const [loading, setLoading] = useState(true);
   const [connectingProvider, setConnectingProvider] = useState<string | null>(null);
@@ -25,6 +32,9 @@ const StorageProvidersScreen = () => {
   const [lastSyncTime, setLastSyncTime] = useState<Date | null>(null);
   const [oneDriveConnected, setOneDriveConnected] = useState(false);
   const [isDownloading, setIsDownloading] = useState(false);
+  const [hasLocalFolder, setHasLocalFolder] = useState(false);
+  const [syncScopes, setSyncScopes] = useState<SyncScopeRule[]>([]);
+  const [showScopePicker, setShowScopePicker] = useState(false);
   const { theme } = useTheme();
 
   // Add insets hook
@@ -39,12 +49,17 @@ const StorageProvidersScreen = () => {
         const allProviders = storageManager.getAllProviders();
         setProviders(allProviders);
         
+        // A remembered folder can be rescanned without picking it again
+        const localProvider = storageManager.getProvider('local') as LocalStorageProvider;
+        if (localProvider) {
+          setHasLocalFolder(!!(await localProvider.getFolderRoot()));
+        }
+        
         // Get OneDrive provider to check connection status
         const oneDriveProvider = storageManager.getProvider('onedrive') as OneDriveStorageProvider;
         if (oneDriveProvider) {
-          // Check connection status
-          const isConnected = await oneDriveProvider.isConnected();
-          setOneDriveConnected(isConnected);
+          // Connection status is kept current by the state subscription below
+          setOneDriveConnected(isSessionState(oneDriveProvider.getConnectionState()));
           
           // Set up sync status change callback
           oneDriveProvider.setSyncStatusChangeCallback(setSyncStatus);
@@ -55,6 +70,7 @@ const StorageProvidersScreen = () => {
           // Get last sync time if available
           const settings = oneDriveProvider.getSyncSettings();
           setLastSyncTime(settings.lastSyncTime);
+          setSyncScopes(oneDriveProvider.getSyncScopes());
         }
       } catch (error) {
         logger.error('Error loading storage providers', error);
@@ -67,6 +83,19 @@ const StorageProvidersScreen = () => {
     loadProviders();
   }, []);
 
+  // Follow OneDrive connection state transitions instead of polling isConnected
+  useEffect(() => {
+    const oneDriveProvider = storageManager.getProvider('onedrive');
+    if (!oneDriveProvider) {
+      return;
+    }
+
+    setOneDriveConnected(isSessionState(oneDriveProvider.getConnectionState()));
+    return oneDriveProvider.onConnectionStateChange((state) => {
+      setOneDriveConnected(isSessionState(state));
+    });
+  }, []);
+
   // Handle connect to provider
   const handleConnectProvider = async (providerId: string) => {
     try {
@@ -78,12 +107,17 @@ const StorageProvidersScreen = () => {
         const allProviders = storageManager.getAllProviders();
         setProviders(allProviders);
         
-        // If OneDrive, update connection status
+        // If OneDrive, refresh the last sync time
         if (providerId === 'onedrive') {
-          setOneDriveConnected(true);
           const oneDriveProvider = storageManager.getProvider('onedrive') as OneDriveStorageProvider;
           const settings = oneDriveProvider.getSyncSettings();
           setLastSyncTime(settings.lastSyncTime);
+          
+          // Browsing reaches music right away, a full sync can take a while
+          Alert.alert('OneDrive Connected', 'Browse your folders and play music while your library syncs.', [
+            { text: 'Later', style: 'cancel' },
+            { text: 'Browse', onPress: () => navigation.navigate('DriveBrowser') }
+          ]);
         }
       } else {
         Alert.alert('Connection Failed', 'Could not connect to the storage provider');
@@ -106,10 +140,10 @@ const StorageProvidersScreen = () => {
       const allProviders = storageManager.getAllProviders();
       setProviders(allProviders);
       
-      // If OneDrive, reset connection status
+      // If OneDrive, reset sync info
       if (providerId === 'onedrive') {
-        setOneDriveConnected(false);
         setLastSyncTime(null);
+        setSyncScopes([]);
       }
     } catch (error) {
       logger.error(`Error disconnecting from provider: ${providerId}`, error);
@@ -139,6 +173,11 @@ const StorageProvidersScreen = () => {
       setConnectingProvider('local');
       const tracks = await importLocalTracksFromFolder();
       
+      const localProvider = storageManager.getProvider('local') as LocalStorageProvider;
+      if (localProvider) {
+        setHasLocalFolder(!!(await localProvider.getFolderRoot()));
+      }
+      
       if (tracks.length > 0) {
         Alert.alert('Success', `Successfully imported ${tracks.length} music files from folder`);
       } else {
@@ -152,6 +191,22 @@ const StorageProvidersScreen = () => {
     }
   };
 
+  // Handle rescan of the remembered local folder
+  const handleRescanLocalFolder = async () => {
+    try {
+      setConnectingProvider('local');
+      const tracks = await rescanLocalFolder();
+      Alert.alert('Rescan Complete', tracks.length > 0
+        ? `Found ${tracks.length} new music files`
+        : 'No new music files were found');
+    } catch (error) {
+      logger.error('Error rescanning folder', error);
+      Alert.alert('Error', 'Failed to rescan music folder');
+    } finally {
+      setConnectingProvider(null);
+    }
+  };
+
   // Handle sync now button
   const handleSyncNow = async () => {
     try {
@@ -177,6 +232,33 @@ const StorageProvidersScreen = () => {
     }
   };
 
+  // Folder rules apply from the next sync, offer to run it now
+  const handleSyncScopesSaved = () => {
+    const oneDriveProvider = storageManager.getProvider('onedrive') as OneDriveStorageProvider;
+    setSyncScopes(oneDriveProvider.getSyncScopes());
+    setShowScopePicker(false);
+    
+    Alert.alert('Sync Folders Saved', 'The library changes at the next sync.', [
+      { text: 'Later', style: 'cancel' },
+      { text: 'Sync Now', onPress: handleSyncNow }
+    ]);
+  };
+
+  // Describe which folders a OneDrive sync covers
+  const getSyncScopeNote = () => {
+    const included = syncScopes.filter(rule => rule.mode === 'include');
+    const excluded = syncScopes.filter(rule => rule.mode === 'exclude');
+    const folders = included.length > 0
+      ? included.map(rule => rule.path)
+      : DEFAULT_SYNC_FOLDER_NAMES.map(name => `/${name}`);
+    
+    let note = `OneDrive will search for audio files in these folders:${folders.map(path => `\n• ${path}`).join('')}`;
+    if (excluded.length > 0) {
+      note += `\nExcept:${excluded.map(rule => `\n• ${rule.path}`).join('')}`;
+    }
+    return note;
+  };
+
   // Handle download all non-local songs
   const handleDownloadAllSongs = async () => {
     try {
@@ -242,12 +324,13 @@ const StorageProvidersScreen = () => {
     const isConnecting = connectingProvider === provider.getId();
     const isLocal = provider.getId() === 'local';
     const isOneDrive = provider.getId() === 'onedrive';
+    const isMediaLibrary = provider.getId() === 'media-library';
     
     return (
       <View key={provider.getId()} style={[styles.providerItem, { backgroundColor: theme.cardBackground, shadowColor: theme.text }]}>
         <View style={[styles.providerIconContainer, { backgroundColor: theme.surface }]}>
           <Ionicons 
-            name={isLocal ? 'phone-portrait-outline' : 'cloud-outline'} 
+            name={isLocal ? 'phone-portrait-outline' : isMediaLibrary ? 'musical-notes-outline' : 'cloud-outline'} 
             size={24} 
             color={theme.primary} 
           />
@@ -258,7 +341,9 @@ const StorageProvidersScreen = () => {
           <Text style={[styles.providerDescription, { color: theme.textSecondary }]}>
             {isLocal 
               ? 'Access music stored on your device' 
-              : 'Access music stored in your OneDrive'}
+              : isMediaLibrary
+                ? 'Use the music your device has already indexed, without copying files'
+                : 'Access music stored in your OneDrive'}
           </Text>
           
           {isOneDrive && oneDriveConnected && (
@@ -270,10 +355,7 @@ const StorageProvidersScreen = () => {
           
           {isOneDrive && (
             <Text style={[styles.providerNoteText, { color: theme.textSecondary }]}>
-              OneDrive will search for audio files in these folders:
-              {'\n'}• root/sonora
-              {'\n'}• root/music
-              {'\n'}• root/Music
+              {getSyncScopeNote()}
             </Text>
           )}
         </View>
@@ -299,6 +381,15 @@ const StorageProvidersScreen = () => {
                   <Ionicons name="folder-outline" size={16} color="#fff" style={styles.actionButtonIcon} />
                   <Text style={styles.actionButtonText}>Import Folder</Text>
                 </TouchableOpacity>
+                {hasLocalFolder && (
+                  <TouchableOpacity 
+                    style={[styles.actionButton, { marginTop: 8, backgroundColor: theme.primary }]}
+                    onPress={handleRescanLocalFolder}
+                  >
+                    <Ionicons name="refresh-outline" size={16} color="#fff" style={styles.actionButtonIcon} />
+                    <Text style={styles.actionButtonText}>Rescan Folder</Text>
+                  </TouchableOpacity>
+                )}
               </>
             ) : isOneDrive ? (
               // OneDrive provider actions
@@ -323,6 +414,22 @@ const StorageProvidersScreen = () => {
                       {syncStatus === SyncStatus.SYNCING ? 'Syncing...' : 'Sync Now'}
                     </Text>
                   </TouchableOpacity>
+                  
+                  <TouchableOpacity 
+                    style={[styles.actionButton, { marginTop: 8, backgroundColor: theme.primary }]}
+                    onPress={() => setShowScopePicker(true)}
+                  >
+                    <Ionicons name="folder-open-outline" size={16} color="#fff" style={styles.actionButtonIcon} />
+                    <Text style={styles.actionButtonText}>Sync Folders</Text>
+                  </TouchableOpacity>
+                  
+                  <TouchableOpacity 
+                    style={[styles.actionButton, { marginTop: 8, backgroundColor: theme.primary }]}
+                    onPress={() => navigation.navigate('DriveBrowser')}
+                  >
+                    <Ionicons name="albums-outline" size={16} color="#fff" style={styles.actionButtonIcon} />
+                    <Text style={styles.actionButtonText}>Browse</Text>
+                  </TouchableOpacity>
                 </>
               ) : (
                 // Not connected action
@@ -334,6 +441,15 @@ const StorageProvidersScreen = () => {
                   <Text style={styles.actionButtonText}>Connect</Text>
                 </TouchableOpacity>
               )
+            ) : isSessionState(provider.getConnectionState()) ? (
+              // Other connected providers (device library)
+              <TouchableOpacity 
+                style={[styles.actionButton, { backgroundColor: theme.primary }]}
+                onPress={() => handleDisconnectProvider(provider.getId())}
+              >
+                <Ionicons name="log-out-outline" size={16} color="#fff" style={styles.actionButtonIcon} />
+                <Text style={styles.actionButtonText}>Disconnect</Text>
+              </TouchableOpacity>
             ) : (
               // Other provider types (if any)
               <TouchableOpacity 
@@ -420,6 +536,15 @@ const StorageProvidersScreen = () => {
           Sonora can play music from multiple sources. Connect to OneDrive to access your cloud music, or import music from your device's local storage.
         </Text>
       </View>
+      
+      {oneDriveConnected && (
+        <SyncScopePicker
+          visible={showScopePicker}
+          provider={storageManager.getProvider('onedrive') as OneDriveStorageProvider}
+          onClose={() => setShowScopePicker(false)}
+          onSaved={handleSyncScopesSaved}
+        />
+      )}
     </ScrollView>
   );
 };
@@ -0,0 +1,779 @@
+/**
+ * Track Catalog
+ * Compact in-memory representation of the music library
+ *
+ * Tracks are addressed by integer surrogate keys. Hot display fields live in
+ * column arrays, artist and album names are interned, and cold fields (paths,
+ * artwork) are kept out of the rows. Paths stay resident since every play and
+ * cache lookup needs them. Artwork is held by the catalog alone: providers
+ * drop it, a row's artwork is read from its file the first time it is shown,
+ * and inline artwork beyond a small LRU is dropped and read again later.
+ * TrackRecord exposes a row through the regular Track interface.
+ *
+ * Keys of removed tracks are reused, so the columns stay as large as the
+ * library. A removed track's view is detached first and keeps its last values,
+ * so it never shows the track that takes the key over.
+ *
+ * Every mutation is published on an ordered change feed (insert, update,
+ * delete with the fields that changed), numbered by a monotonic generation,
+ * so derived structures can update incrementally and resume after a gap.
+ */
+
+import { Track } from '../../types';
+import { logger } from '../../utils/logger';
+
+const INITIAL_CAPACITY = 256;
+const NO_STRING = -1;
+const SOURCES: Track['source'][] = ['local', 'onedrive', 'media-library'];
+
+// Inline artwork (base64 data URIs) is large, keep only the most recently used ones in memory
+const MAX_INLINE_ARTWORK = 200;
+
+// Changes kept for subscribers resuming from an earlier generation
+const MAX_CHANGE_LOG = 5000;
+
+// Fields kept out of the columns; path and uri stay resident, artwork is read on demand and inline artwork is evicted
+interface ColdFields {
+  path?: string;
+  uri?: string; // only stored when it differs from path
+  artwork?: string;
+  artworkUnloaded?: boolean; // not looked up yet or evicted, read through the cold field loader when shown
+}
+
+export type ColdFieldLoader = (track: Track) => Promise<Partial<Pick<Track, 'path' | 'uri' | 'artwork'>> | null>;
+
+export type CatalogChangeType = 'insert' | 'update' | 'delete';
+
+export interface CatalogChange {
+  generation: number;
+  type: CatalogChangeType;
+  id: string;
+  key: number;
+  // Fields whose value changed; every field for inserts, none for deletes
+  fields: (keyof Track)[];
+}
+
+export interface CatalogChangeBatch {
+  changes: CatalogChange[];
+  // Generation of the last change in the batch, the value to resume from
+  generation: number;
+  // The requested generation is no longer in the log, rebuild from the current catalog
+  reset: boolean;
+}
+
+/**
+ * Called once per batch of changes, after the mutating call returns
+ */
+export type CatalogChangeListener = (batch: CatalogChangeBatch) => void;
+
+const ALL_FIELDS: (keyof Track)[] = ['title', 'artist', 'album', 'duration', 'source', 'uri', 'path', 'artwork'];
+
+/**
+ * 32-bit FNV-1a hash of a string
+ */
+export const hashString = (value: string, seed: number = 0x811c9dc5): number => {
+  let hash = seed;
+  for (let i = 0; i < value.length; i++) {
+    hash ^= value.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+};
+
+/**
+ * Interning pool for repeated strings such as artist and album names
+ */
+class StringPool {
+  private indexByValue = new Map<string, number>();
+  private values: string[] = [];
+  
+  intern(value: string | undefined): number {
+    if (value === undefined || value === null) return NO_STRING;
+    
+    let index = this.indexByValue.get(value);
+    if (index === undefined) {
+      index = this.values.length;
+      this.values.push(value);
+      this.indexByValue.set(value, index);
+    }
+    return index;
+  }
+  
+  get(index: number): string | undefined {
+    return index === NO_STRING ? undefined : this.values[index];
+  }
+  
+  get size(): number {
+    return this.values.length;
+  }
+}
+
+/**
+ * Track-compatible view over one catalog row
+ * Reads and writes go straight to the catalog columns
+ */
+export class TrackRecord implements Track {
+  // The track's last values once it left the catalog, whose key may then belong to another track
+  private detached: Track | null = null;
+  
+  constructor(private readonly catalog: Catalog, readonly key: number) {}
+  
+  get id(): string { return this.detached ? this.detached.id : this.catalog.getId(this.key); }
+  
+  get title(): string { return this.detached ? this.detached.title : this.catalog.getTitle(this.key); }
+  set title(value: string) { this.write({ title: value }); }
+  
+  get artist(): string | undefined { return this.detached ? this.detached.artist : this.catalog.getArtist(this.key); }
+  set artist(value: string | undefined) { this.write({ artist: value }); }
+  
+  get album(): string | undefined { return this.detached ? this.detached.album : this.catalog.getAlbum(this.key); }
+  set album(value: string | undefined) { this.write({ album: value }); }
+  
+  get duration(): number | undefined { return this.detached ? this.detached.duration : this.catalog.getDuration(this.key); }
+  set duration(value: number | undefined) { this.write({ duration: value }); }
+  
+  get source(): Track['source'] { return this.detached ? this.detached.source : this.catalog.getSource(this.key); }
+  
+  get uri(): string { return this.detached ? this.detached.uri : this.catalog.getUri(this.key); }
+  set uri(value: string) { this.write({ uri: value }); }
+  
+  get path(): string | undefined { return this.detached ? this.detached.path : this.catalog.getPath(this.key); }
+  set path(value: string | undefined) { this.write({ path: value }); }
+  
+  get artwork(): string | undefined { return this.detached ? this.detached.artwork : this.catalog.getArtwork(this.key); }
+  set artwork(value: string | undefined) { this.write({ artwork: value }); }
+  
+  /**
+   * Stop reading the row, called by the catalog when the track is removed
+   */
+  detach(fields: Track): void {
+    this.detached = fields;
+  }
+  
+  /**
+   * Materialize a plain Track (used by JSON.stringify and object spreads)
+   */
+  toJSON(): Track {
+    return this.detached ? { ...this.detached } : this.catalog.materialize(this.key);
+  }
+  
+  private write(changes: Partial<Track>): void {
+    if (this.detached) {
+      Object.assign(this.detached, changes);
+    } else {
+      this.catalog.update(this.key, changes);
+    }
+  }
+}
+
+/**
+ * Convert a track view into a plain object, leaving plain tracks untouched
+ * Needed before spreading, since the view's fields live on its prototype
+ */
+export const toPlainTrack = (track: Track): Track => {
+  return track instanceof TrackRecord ? track.toJSON() : track;
+};
+
+export class Catalog {
+  private static instance: Catalog;
+  
+  private keyById = new Map<string, number>();
+  private ids: string[] = [];
+  private titles: string[] = [];
+  private artistRefs = new Int32Array(INITIAL_CAPACITY);
+  private albumRefs = new Int32Array(INITIAL_CAPACITY);
+  private durations = new Float64Array(INITIAL_CAPACITY);
+  private sources = new Uint8Array(INITIAL_CAPACITY);
+  private contentHashes = new Uint32Array(INITIAL_CAPACITY);
+  private cold = new Map<number, ColdFields>();
+  private records: (TrackRecord | undefined)[] = [];
+  // Keys of removed tracks, handed out again before the columns grow
+  private freeKeys: number[] = [];
+  private liveKeys: number[] = [];
+  private liveKeysDirty = false;
+  
+  private artists = new StringPool();
+  private albums = new StringPool();
+  
+  // Keys with inline artwork in least-recently-used order
+  private inlineArtwork = new Map<number, true>();
+  private coldFieldLoader: ColdFieldLoader | null = null;
+  private pendingColdLoads = new Set<number>();
+  
+  // Change feed for derived structures
+  private generation = 0;
+  private fingerprint = 0;
+  private changeLog: CatalogChange[] = [];
+  // Each subscriber's cursor: the last generation delivered to it
+  private changeListeners = new Map<CatalogChangeListener, number>();
+  private flushScheduled = false;
+  
+  private constructor() {}
+  
+  public static getInstance(): Catalog {
+    if (!Catalog.instance) {
+      Catalog.instance = new Catalog();
+    }
+    return Catalog.instance;
+  }
+  
+  /**
+   * Create a catalog separate from the app's library
+   * Used by diagnostics harnesses so they never touch real tracks
+   */
+  public static createIsolated(): Catalog {
+    return new Catalog();
+  }
+  
+  /**
+   * Register a loader that reads artwork the catalog doesn't hold when a row shows it
+   */
+  public setColdFieldLoader(loader: ColdFieldLoader | null): void {
+    this.coldFieldLoader = loader;
+  }
+  
+  /**
+   * Subscribe to the change feed
+   * With sinceGeneration, changes after it are replayed first (or a reset batch
+   * is sent when they have left the log), so a subscriber can resume where it stopped
+   * Returns an unsubscribe function
+   */
+  public subscribe(listener: CatalogChangeListener, sinceGeneration?: number): () => void {
+    this.changeListeners.set(listener, Math.min(sinceGeneration ?? this.generation, this.generation));
+    if (sinceGeneration !== undefined && sinceGeneration < this.generation) {
+      this.scheduleFlush();
+    }
+    
+    return () => {
+      this.changeListeners.delete(listener);
+    };
+  }
+  
+  /**
+   * Changes after a generation, or null when the log no longer reaches back that far
+   */
+  public getChangesSince(generation: number): CatalogChange[] | null {
+    if (generation >= this.generation) return [];
+    
+    const oldest = this.changeLog.length > 0 ? this.changeLog[0].generation : this.generation + 1;
+    if (generation + 1 < oldest) return null;
+    
+    return this.changeLog.slice(generation + 1 - oldest);
+  }
+  
+  /**
+   * Generation of the latest change, increases monotonically within a session
+   */
+  public getGeneration(): number {
+    return this.generation;
+  }
+  
+  /**
+   * Order-independent hash of every live track's ID and searchable fields
+   * Unlike the generation it survives a rebuild, so persisted derived data can be validated with it
+   */
+  public getFingerprint(): number {
+    return (this.fingerprint ^ this.size) >>> 0;
+  }
+  
+  /**
+   * Hash of a row's ID and searchable fields (title, artist, album)
+   */
+  public getContentHash(key: number): number {
+    return this.contentHashes[key];
+  }
+  
+  /**
+   * Number of live tracks
+   */
+  public get size(): number {
+    return this.keyById.size;
+  }
+  
+  /**
+   * Replace the whole catalog with the given tracks
+   * Tracks that keep their ID keep their key, so existing views stay valid
+   */
+  public replaceAll(tracks: Track[]): Track[] {
+    const incoming = new Set(tracks.map(track => track.id));
+    for (const id of Array.from(this.keyById.keys())) {
+      if (!incoming.has(id)) {
+        this.remove(id);
+      }
+    }
+    return this.upsert(tracks);
+  }
+  
+  /**
+   * Insert or update tracks and return their catalog views
+   */
+  public upsert(tracks: Track[]): Track[] {
+    const result: Track[] = [];
+    for (const track of tracks) {
+      const plain = toPlainTrack(track);
+      let key = this.keyById.get(plain.id);
+      
+      if (key === undefined) {
+        key = this.allocate(plain);
+      } else {
+        this.update(key, plain);
+      }
+      
+      result.push(this.record(key));
+    }
+    return result;
+  }
+  
+  /**
+   * Time-sliceable variant of replaceAll for use with the task scheduler
+   */
+  public *replaceAllInSlices(tracks: Track[], chunkSize = 500): Generator<void, Track[], unknown> {
+    const incoming = new Set(tracks.map(track => track.id));
+    for (const id of Array.from(this.keyById.keys())) {
+      if (!incoming.has(id)) {
+        this.remove(id);
+      }
+    }
+    yield;
+    
+    const result: Track[] = [];
+    for (let i = 0; i < tracks.length; i += chunkSize) {
+      result.push(...this.upsert(tracks.slice(i, i + chunkSize)));
+      yield;
+    }
+    return result;
+  }
+  
+  /**
+   * Remove a track by ID
+   */
+  public remove(id: string): boolean {
+    const key = this.keyById.get(id);
+    if (key === undefined) return false;
+    
+    this.fingerprint = (this.fingerprint - this.contentHashes[key]) >>> 0;
+    this.recordChange('delete', key, []);
+    
+    // Views handed out keep the track's values once the key is reused
+    this.records[key]?.detach(this.materialize(key));
+    
+    this.keyById.delete(id);
+    this.cold.delete(key);
+    this.inlineArtwork.delete(key);
+    this.pendingColdLoads.delete(key);
+    this.records[key] = undefined;
+    this.ids[key] = '';
+    this.titles[key] = '';
+    this.freeKeys.push(key);
+    this.liveKeysDirty = true;
+    return true;
+  }
+  
+  /**
+   * Get the view for a track ID
+   */
+  public get(id: string): Track | undefined {
+    const key = this.keyById.get(id);
+    return key === undefined ? undefined : this.record(key);
+  }
+  
+  /**
+   * Get the views of all live tracks in insertion order
+   */
+  public tracks(): Track[] {
+    this.compactLiveKeys();
+    return this.liveKeys.map(key => this.record(key));
+  }
+  
+  /**
+   * Look up the surrogate key of a track ID
+   */
+  public keyOf(id: string): number | undefined {
+    return this.keyById.get(id);
+  }
+  
+  /**
+   * Remove all tracks
+   * Views held elsewhere are detached, so they cannot alias a track that reuses their key
+   */
+  public clear(): void {
+    for (const id of Array.from(this.keyById.keys())) {
+      this.remove(id);
+    }
+    this.liveKeys = [];
+    this.liveKeysDirty = false;
+  }
+  
+  /**
+   * Rough statistics for diagnostics
+   */
+  public getStats(): { tracks: number; artists: number; albums: number; coldEntries: number; inlineArtwork: number } {
+    return {
+      tracks: this.size,
+      artists: this.artists.size,
+      albums: this.albums.size,
+      coldEntries: this.cold.size,
+      inlineArtwork: this.inlineArtwork.size
+    };
+  }
+  
+  // Column accessors used by TrackRecord
+  
+  public getId(key: number): string {
+    return this.ids[key];
+  }
+  
+  public getTitle(key: number): string {
+    return this.titles[key];
+  }
+  
+  public getArtist(key: number): string | undefined {
+    return this.artists.get(this.artistRefs[key]);
+  }
+  
+  public getAlbum(key: number): string | undefined {
+    return this.albums.get(this.albumRefs[key]);
+  }
+  
+  public getDuration(key: number): number | undefined {
+    const duration = this.durations[key];
+    return Number.isNaN(duration) ? undefined : duration;
+  }
+  
+  public getSource(key: number): Track['source'] {
+    return SOURCES[this.sources[key]];
+  }
+  
+  public getPath(key: number): string | undefined {
+    return this.cold.get(key)?.path;
+  }
+  
+  public getUri(key: number): string {
+    const fields = this.cold.get(key);
+    return fields?.uri ?? fields?.path ?? '';
+  }
+  
+  public getArtwork(key: number): string | undefined {
+    const artwork = this.cold.get(key)?.artwork;
+    
+    if (artwork !== undefined) {
+      if (this.inlineArtwork.has(key)) {
+        // Refresh LRU position
+        this.inlineArtwork.delete(key);
+        this.inlineArtwork.set(key, true);
+      }
+      return artwork;
+    }
+    
+    if (this.cold.get(key)?.artworkUnloaded) {
+      this.loadColdFields(key);
+    }
+    return undefined;
+  }
+  
+  /**
+   * Apply a partial update to a row
+   * Only fields whose value differs are written and published
+   */
+  public update(key: number, changes: Partial<Track>): void {
+    const fields = this.applyChanges(key, changes);
+    if (fields.length > 0) {
+      this.recordChange('update', key, fields);
+    }
+  }
+  
+  /**
+   * Build a plain Track object for a row
+   */
+  public materialize(key: number): Track {
+    return {
+      id: this.getId(key),
+      title: this.getTitle(key),
+      artist: this.getArtist(key),
+      album: this.getAlbum(key),
+      duration: this.getDuration(key),
+      uri: this.getUri(key),
+      artwork: this.cold.get(key)?.artwork,
+      source: this.getSource(key),
+      path: this.getPath(key)
+    };
+  }
+  
+  /**
+   * Allocate a row for a track, reusing a removed track's key when there is one
+   */
+  private allocate(track: Track): number {
+    let key: number;
+    if (this.freeKeys.length > 0) {
+      // The freed key must leave the live list before it is appended again
+      this.compactLiveKeys();
+      key = this.freeKeys.pop()!;
+      this.ids[key] = track.id;
+      this.titles[key] = track.title;
+    } else {
+      key = this.ids.length;
+      this.ensureCapacity(key + 1);
+      this.ids.push(track.id);
+      this.titles.push(track.title);
+    }
+    
+    this.keyById.set(track.id, key);
+    this.liveKeys.push(key);
+    this.artistRefs[key] = NO_STRING;
+    this.albumRefs[key] = NO_STRING;
+    this.durations[key] = NaN;
+    this.sources[key] = 0;
+    this.contentHashes[key] = 0;
+    
+    this.applyChanges(key, track);
+    
+    // Providers don't keep artwork, so a track usually arrives without it
+    const cold = this.cold.get(key) ?? {};
+    if (cold.artwork === undefined) {
+      cold.artworkUnloaded = true;
+      this.cold.set(key, cold);
+    }
+    
+    this.updateContentHash(key);
+    this.recordChange('insert', key, ALL_FIELDS);
+    return key;
+  }
+  
+  /**
+   * Write changed fields into the columns and return which ones changed
+   */
+  private applyChanges(key: number, changes: Partial<Track>): (keyof Track)[] {
+    const fields: (keyof Track)[] = [];
+    
+    if ('title' in changes && changes.title !== undefined && changes.title !== this.titles[key]) {
+      this.titles[key] = changes.title;
+      fields.push('title');
+    }
+    if ('artist' in changes) {
+      const ref = this.artists.intern(changes.artist);
+      if (ref !== this.artistRefs[key]) {
+        this.artistRefs[key] = ref;
+        fields.push('artist');
+      }
+    }
+    if ('album' in changes) {
+      const ref = this.albums.intern(changes.album);
+      if (ref !== this.albumRefs[key]) {
+        this.albumRefs[key] = ref;
+        fields.push('album');
+      }
+    }
+    if ('duration' in changes && !Object.is(changes.duration ?? NaN, this.durations[key])) {
+      this.durations[key] = changes.duration ?? NaN;
+      fields.push('duration');
+    }
+    if ('source' in changes && changes.source !== undefined) {
+      const source = Math.max(0, SOURCES.indexOf(changes.source));
+      if (source !== this.sources[key]) {
+        this.sources[key] = source;
+        fields.push('source');
+      }
+    }
+    
+    const cold = this.cold.get(key);
+    const coldChanged: (keyof Track)[] = [];
+    if ('path' in changes && changes.path !== cold?.path) coldChanged.push('path');
+    if ('uri' in changes && changes.uri !== this.getUri(key)) coldChanged.push('uri');
+    // Undefined artwork means the sender doesn't hold it, which leaves the row's artwork alone
+    if (changes.artwork !== undefined && (changes.artwork !== cold?.artwork || cold?.artworkUnloaded)) coldChanged.push('artwork');
+    if (coldChanged.length > 0) {
+      this.updateColdFields(key, changes);
+      fields.push(...coldChanged);
+    }
+    
+    if (fields.includes('title') || fields.includes('artist') || fields.includes('album')) {
+      this.updateContentHash(key);
+    }
+    return fields;
+  }
+  
+  /**
+   * Recompute a row's content hash and fold it into the fingerprint
+   */
+  private updateContentHash(key: number): void {
+    let hash = hashString(this.ids[key]);
+    hash = hashString(this.titles[key], hash);
+    hash = hashString(`\u0001${this.getArtist(key) ?? ''}`, hash);
+    hash = hashString(`\u0001${this.getAlbum(key) ?? ''}`, hash);
+    
+    this.fingerprint = (this.fingerprint - this.contentHashes[key] + hash) >>> 0;
+    this.contentHashes[key] = hash;
+  }
+  
+  /**
+   * Append a change to the log; subscribers get it in one batch after the current call stack
+   */
+  private recordChange(type: CatalogChangeType, key: number, fields: (keyof Track)[]): void {
+    const change: CatalogChange = { generation: ++this.generation, type, id: this.ids[key], key, fields };
+    
+    this.changeLog.push(change);
+    if (this.changeLog.length > MAX_CHANGE_LOG * 2) {
+      this.changeLog = this.changeLog.slice(-MAX_CHANGE_LOG);
+    }
+    
+    if (this.changeListeners.size > 0) {
+      this.scheduleFlush();
+    }
+  }
+  
+  private scheduleFlush(): void {
+    if (this.flushScheduled) return;
+    this.flushScheduled = true;
+    Promise.resolve().then(() => this.flushChanges());
+  }
+  
+  /**
+   * Deliver everything past each subscriber's cursor from the log, in order
+   * A subscriber that fell behind the log gets a reset batch instead
+   */
+  private flushChanges(): void {
+    this.flushScheduled = false;
+    
+    for (const [listener, cursor] of Array.from(this.changeListeners.entries())) {
+      if (cursor >= this.generation || !this.changeListeners.has(listener)) continue;
+      
+      const changes = this.getChangesSince(cursor);
+      const batch: CatalogChangeBatch = changes
+        ? { changes, generation: this.generation, reset: false }
+        : { changes: [], generation: this.generation, reset: true };
+      this.changeListeners.set(listener, this.generation);
+      
+      try {
+        listener(batch);
+      } catch (error) {
+        logger.error('Error in catalog change listener', error);
+      }
+    }
+  }
+  
+  /**
+   * Store cold fields, deduplicating uri/path and bounding inline artwork
+   */
+  private updateColdFields(key: number, changes: Partial<Track>): void {
+    const fields: ColdFields = { ...this.cold.get(key) };
+    const currentUri = fields.uri ?? fields.path;
+    
+    if ('path' in changes) {
+      fields.path = changes.path;
+    }
+    
+    const uri = 'uri' in changes ? changes.uri : currentUri;
+    fields.uri = uri && uri !== fields.path ? uri : undefined;
+    
+    if (changes.artwork !== undefined) {
+      fields.artwork = changes.artwork;
+      fields.artworkUnloaded = false;
+      this.inlineArtwork.delete(key);
+      
+      if (changes.artwork) {
+        if (changes.artwork.startsWith('data:') || changes.artwork.length > 1024) {
+          this.inlineArtwork.set(key, true);
+          this.evictInlineArtwork();
+        }
+      }
+    }
+    
+    this.cold.set(key, fields);
+  }
+  
+  /**
+   * Drop the least recently used inline artwork beyond the budget
+   * The row remembers the eviction, so the artwork is reloaded through the cold field loader when viewed again
+   */
+  private evictInlineArtwork(): void {
+    while (this.inlineArtwork.size > MAX_INLINE_ARTWORK) {
+      const oldest = this.inlineArtwork.keys().next().value as number;
+      this.inlineArtwork.delete(oldest);
+      
+      const fields = this.cold.get(oldest);
+      if (fields) {
+        fields.artwork = undefined;
+        fields.artworkUnloaded = true;
+      }
+    }
+  }
+  
+  /**
+   * Load artwork the catalog doesn't hold in the background
+   * Each lookup runs once; a track without artwork is not looked up again until it is evicted or reinserted
+   */
+  private loadColdFields(key: number): void {
+    if (!this.coldFieldLoader || this.pendingColdLoads.has(key)) return;
+    
+    this.pendingColdLoads.add(key);
+    const track = this.record(key);
+    
+    this.coldFieldLoader(track)
+      .then(fields => {
+        if (fields && this.records[key] === track) {
+          this.update(key, fields);
+        }
+      })
+      .catch(error => {
+        logger.warn(`Failed to load cold fields for track: ${track.title}`, error);
+      })
+      .finally(() => {
+        // A removed track's key may already be loading for the track that reused it
+        if (this.records[key] === track) {
+          this.pendingColdLoads.delete(key);
+          const fields = this.cold.get(key);
+          if (fields?.artworkUnloaded) {
+            fields.artworkUnloaded = false;
+          }
+        }
+      });
+  }
+  
+  /**
+   * Drop removed keys from the live list
+   */
+  private compactLiveKeys(): void {
+    if (!this.liveKeysDirty) return;
+    this.liveKeys = this.liveKeys.filter(key => this.keyById.get(this.ids[key]) === key);
+    this.liveKeysDirty = false;
+  }
+  
+  /**
+   * Get or create the view for a row
+   */
+  private record(key: number): TrackRecord {
+    let record = this.records[key];
+    if (!record) {
+      record = new TrackRecord(this, key);
+      this.records[key] = record;
+    }
+    return record;
+  }
+  
+  /**
+   * Grow the typed columns geometrically
+   */
+  private ensureCapacity(required: number): void {
+    if (required <= this.sources.length) return;
+    
+    let capacity = this.sources.length;
+    while (capacity < required) {
+      capacity *= 2;
+    }
+    
+    const grow = <T extends Int32Array | Uint32Array | Float64Array | Uint8Array>(column: T, create: (size: number) => T): T => {
+      const next = create(capacity);
+      next.set(column);
+      return next;
+    };
+    
+    this.artistRefs = grow(this.artistRefs, size => new Int32Array(size));
+    this.albumRefs = grow(this.albumRefs, size => new Int32Array(size));
+    this.durations = grow(this.durations, size => new Float64Array(size));
+    this.sources = grow(this.sources, size => new Uint8Array(size));
+    this.contentHashes = grow(this.contentHashes, size => new Uint32Array(size));
+  }
+}
+
+// Export singleton instance
+export const catalog = Catalog.getInstance();
\ No newline at end of file
@@ -0,0 +1,336 @@
+/**
+ * Data Budget
+ * Monthly ledger of bytes transferred per network type, and the policy that
+ * degrades network use as cellular usage approaches the user's budget
+ *
+ * Downloads, prefetches, Graph responses and streams record their bytes here.
+ * On cellular the policy steps down as the month's usage grows: first stream
+ * without caching, then stop prefetching, then play cached content only.
+ * The download strategy setting applies on top of the budget.
+ */
+
+import * as NetInfo from '@react-native-community/netinfo';
+import { AppSettings } from '../../types';
+import { logger } from '../../utils/logger';
+import { metrics } from '../../utils/metrics';
+import { instrumentAsyncStorage } from '../../utils/io';
+import { DataBudgetError } from './DataBudgetError';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('data-budget');
+
+// Constants
+const DATA_USAGE_STORAGE_KEY = '@sonora/data_usage';
+const PERSIST_DEBOUNCE_MS = 5000;
+const MAX_HISTORY_MONTHS = 6;
+const BYTES_PER_MB = 1024 * 1024;
+
+// Fractions of the cellular budget where each degradation starts
+const STREAM_ONLY_AT = 0.75;
+const NO_PREFETCH_AT = 0.9;
+const CACHED_ONLY_AT = 1;
+
+// Streams are decoded natively and never pass through JS, so they are estimated (320 kbps)
+const ESTIMATED_STREAM_BYTES_PER_SECOND = 40000;
+
+export type NetworkClass = 'cellular' | 'wifi' | 'other';
+
+export type UsageCategory = 'download' | 'prefetch' | 'graph' | 'stream';
+
+export enum DataBudgetLevel {
+  NORMAL = 0,
+  STREAM_ONLY = 1, // play uncached tracks without writing them to the cache
+  NO_PREFETCH = 2, // also stop downloading or buffering ahead of playback
+  CACHED_ONLY = 3 // only play what is already on the device
+}
+
+export type UsageByCategory = Record<UsageCategory, number>;
+
+export interface MonthlyUsage {
+  month: string; // YYYY-MM in local time
+  usage: Record<NetworkClass, UsageByCategory>;
+}
+
+export interface DataUsageSnapshot {
+  month: string;
+  cellularBytes: number;
+  wifiBytes: number;
+  otherBytes: number;
+  cellularBudgetBytes: number; // 0 when there is no budget
+  network: NetworkClass | null;
+  level: DataBudgetLevel; // applied while on cellular
+  current: MonthlyUsage;
+  history: MonthlyUsage[];
+}
+
+export type DataBudgetListener = (snapshot: DataUsageSnapshot) => void;
+
+export { DataBudgetError };
+
+const emptyCategories = (): UsageByCategory => ({ download: 0, prefetch: 0, graph: 0, stream: 0 });
+
+const emptyMonth = (month: string): MonthlyUsage => ({
+  month,
+  usage: { cellular: emptyCategories(), wifi: emptyCategories(), other: emptyCategories() }
+});
+
+const monthKey = (date: Date = new Date()): string => {
+  return `${date.getFullYear()}-${String(date.getMonth() + 1).padStart(2, '0')}`;
+};
+
+const sumCategories = (usage: UsageByCategory): number => {
+  return usage.download + usage.prefetch + usage.graph + usage.stream;
+};
+
+class DataBudget {
+  private static instance: DataBudget;
+  private current: MonthlyUsage = emptyMonth(monthKey());
+  private history: MonthlyUsage[] = [];
+  private network: NetworkClass | null = null;
+  private cellularBudgetBytes: number = 0;
+  private downloadStrategy: AppSettings['downloadStrategy'] = 'wifi-only';
+  private level: DataBudgetLevel = DataBudgetLevel.NORMAL;
+  private loadPromise: Promise<void> | null = null;
+  private unsubscribeNetInfo: (() => void) | null = null;
+  private persistTimer: NodeJS.Timeout | null = null;
+  private listeners: Set<DataBudgetListener> = new Set();
+  
+  private constructor() {}
+  
+  public static getInstance(): DataBudget {
+    if (!DataBudget.instance) {
+      DataBudget.instance = new DataBudget();
+    }
+    return DataBudget.instance;
+  }
+  
+  /**
+   * Load the ledger and follow network changes
+   */
+  public start(): Promise<void> {
+    if (!this.unsubscribeNetInfo) {
+      this.unsubscribeNetInfo = NetInfo.addEventListener(state => {
+        const network = this.classify(state);
+        if (network !== this.network) {
+          this.network = network;
+          this.evaluate();
+          this.notify();
+        }
+      });
+    }
+    return this.load();
+  }
+  
+  /**
+   * Apply the user's budget and download strategy
+   */
+  public configure(settings: Pick<AppSettings, 'downloadStrategy' | 'cellularDataBudgetMb'>): void {
+    this.downloadStrategy = settings.downloadStrategy;
+    this.cellularBudgetBytes = Math.max(0, settings.cellularDataBudgetMb || 0) * BYTES_PER_MB;
+    this.evaluate();
+    this.notify();
+  }
+  
+  /**
+   * Add transferred bytes to this month's ledger under the current network
+   */
+  public record(bytes: number, category: UsageCategory): void {
+    if (!(bytes > 0)) return;
+    
+    this.rollMonth();
+    const network = this.network ?? 'other';
+    this.current.usage[network][category] += bytes;
+    metrics.increment(`data.${network}.${category}_bytes`, bytes);
+    
+    this.evaluate();
+    this.schedulePersist();
+  }
+  
+  /**
+   * Record a stream by its expected size, since stream bytes are not visible to JS
+   * @param durationMs Track duration, streams of unknown length are not counted
+   */
+  public recordStream(durationMs: number | undefined): void {
+    if (!durationMs) return;
+    this.record(Math.round((durationMs / 1000) * ESTIMATED_STREAM_BYTES_PER_SECOND), 'stream');
+  }
+  
+  /**
+   * Whether uncached tracks may be downloaded into the cache on the current network
+   */
+  public shouldCacheDownloads(): boolean {
+    if (this.downloadStrategy === 'never') return false;
+    if (this.network !== 'cellular') return true;
+    return this.downloadStrategy === 'always' && this.level < DataBudgetLevel.STREAM_ONLY;
+  }
+  
+  /**
+   * Whether work ahead of playback (precaching, preloading the next track) may use the network
+   */
+  public canPrefetch(): boolean {
+    if (this.network !== 'cellular') return this.downloadStrategy !== 'never';
+    return this.level < DataBudgetLevel.NO_PREFETCH;
+  }
+  
+  /**
+   * Whether an uncached track may be streamed on the current network
+   */
+  public canStream(): boolean {
+    return this.network !== 'cellular' || this.level < DataBudgetLevel.CACHED_ONLY;
+  }
+  
+  /**
+   * Current degradation, always NORMAL off cellular
+   */
+  public getLevel(): DataBudgetLevel {
+    return this.network === 'cellular' ? this.level : DataBudgetLevel.NORMAL;
+  }
+  
+  /**
+   * Usage this month and in previous months
+   */
+  public getSnapshot(): DataUsageSnapshot {
+    this.rollMonth();
+    return {
+      month: this.current.month,
+      cellularBytes: sumCategories(this.current.usage.cellular),
+      wifiBytes: sumCategories(this.current.usage.wifi),
+      otherBytes: sumCategories(this.current.usage.other),
+      cellularBudgetBytes: this.cellularBudgetBytes,
+      network: this.network,
+      level: this.level,
+      current: JSON.parse(JSON.stringify(this.current)),
+      history: this.history.map(month => JSON.parse(JSON.stringify(month)))
+    };
+  }
+  
+  /**
+   * Subscribe to usage and policy changes, delivered at most once per persist interval
+   * Returns an unsubscribe function
+   */
+  public onChange(listener: DataBudgetListener): () => void {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+  
+  /**
+   * Clear this month's usage
+   */
+  public async resetCurrentMonth(): Promise<void> {
+    await this.load();
+    this.current = emptyMonth(monthKey());
+    this.evaluate();
+    await this.persist();
+  }
+  
+  /**
+   * Recompute the cellular level from this month's usage
+   */
+  private evaluate(): void {
+    const used = sumCategories(this.current.usage.cellular);
+    let level = DataBudgetLevel.NORMAL;
+    
+    if (this.cellularBudgetBytes > 0) {
+      const fraction = used / this.cellularBudgetBytes;
+      if (fraction >= CACHED_ONLY_AT) {
+        level = DataBudgetLevel.CACHED_ONLY;
+      } else if (fraction >= NO_PREFETCH_AT) {
+        level = DataBudgetLevel.NO_PREFETCH;
+      } else if (fraction >= STREAM_ONLY_AT) {
+        level = DataBudgetLevel.STREAM_ONLY;
+      }
+    }
+    
+    if (level !== this.level) {
+      logger.info(`Cellular data policy changed from ${DataBudgetLevel[this.level]} to ${DataBudgetLevel[level]}`);
+      this.level = level;
+      metrics.setGauge('data.cellular_level', level);
+    }
+  }
+  
+  /**
+   * Start a new ledger when the month changes, keeping recent months as history
+   */
+  private rollMonth(): void {
+    const month = monthKey();
+    if (this.current.month === month) return;
+    
+    this.history = [this.current, ...this.history].slice(0, MAX_HISTORY_MONTHS);
+    this.current = emptyMonth(month);
+    this.evaluate();
+    this.schedulePersist();
+  }
+  
+  private classify(state: NetInfo.NetInfoState): NetworkClass | null {
+    if (!state.isConnected) return null;
+    if (state.type === NetInfo.NetInfoStateType.cellular) return 'cellular';
+    if (state.type === NetInfo.NetInfoStateType.wifi || state.type === NetInfo.NetInfoStateType.ethernet) return 'wifi';
+    return 'other';
+  }
+  
+  private load(): Promise<void> {
+    if (!this.loadPromise) {
+      this.loadPromise = (async () => {
+        try {
+          const saved = await AsyncStorage.getItem(DATA_USAGE_STORAGE_KEY);
+          if (saved) {
+            const { current, history } = JSON.parse(saved) as { current: MonthlyUsage; history: MonthlyUsage[] };
+            // Bytes recorded before the ledger loaded are added to the saved month
+            const pending = this.current;
+            this.current = current.month === pending.month ? current : emptyMonth(pending.month);
+            this.history = current.month === pending.month ? history : [current, ...history].slice(0, MAX_HISTORY_MONTHS);
+            (Object.keys(pending.usage) as NetworkClass[]).forEach(network => {
+              (Object.keys(pending.usage[network]) as UsageCategory[]).forEach(category => {
+                this.current.usage[network][category] += pending.usage[network][category];
+              });
+            });
+          }
+          
+          this.network = this.classify(await NetInfo.fetch());
+          this.evaluate();
+          this.notify();
+        } catch (error) {
+          logger.error('Error loading data usage ledger', error);
+        }
+      })();
+    }
+    return this.loadPromise;
+  }
+  
+  private schedulePersist(): void {
+    if (this.persistTimer) return;
+    
+    this.persistTimer = setTimeout(() => {
+      this.persistTimer = null;
+      this.persist().catch(error => logger.error('Error saving data usage ledger', error));
+    }, PERSIST_DEBOUNCE_MS);
+  }
+  
+  private async persist(): Promise<void> {
+    if (this.persistTimer) {
+      clearTimeout(this.persistTimer);
+      this.persistTimer = null;
+    }
+    
+    await AsyncStorage.setItem(DATA_USAGE_STORAGE_KEY, JSON.stringify({ current: this.current, history: this.history }));
+    this.notify();
+  }
+  
+  private notify(): void {
+    if (this.listeners.size === 0) return;
+    
+    const snapshot = this.getSnapshot();
+    for (const listener of Array.from(this.listeners)) {
+      try {
+        listener(snapshot);
+      } catch (error) {
+        logger.error('Error in data budget listener', error);
+      }
+    }
+  }
+}
+
+// Export singleton instance
+export const dataBudget = DataBudget.getInstance();
\ No newline at end of file
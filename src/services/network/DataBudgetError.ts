@@ -0,0 +1,14 @@
+/**
+ * Data Budget Error
+ * Thrown when the data budget refuses a transfer
+ *
+ * Kept apart from DataBudget so code that only recognizes the error does not
+ * load NetInfo.
+ */
+
+export class DataBudgetError extends Error {
+  constructor(message: string) {
+    super(message);
+    this.name = 'DataBudgetError';
+  }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+/**
+ * App Player
+ * The app's player, wired to expo-av and the storage providers
+ *
+ * PlayerService only sees the PlayerEnvironment interface, so harnesses can
+ * import it with a simulated backend and never load a native module.
+ */
+
+import { storageManager } from '../storage/StorageManager';
+import { PlayerService, PlayerEnvironment } from './PlayerService';
+import { expoAvBackend } from './ExpoAvBackend';
+
+const APP_ENVIRONMENT: PlayerEnvironment = {
+  backend: expoAvBackend,
+  resolveUri: (track, priority) => storageManager.getPlayableUri(track, priority),
+  warmUri: track => storageManager.warmPlayableUri(track),
+  continueUri: (track, uri) => storageManager.getContinuation(track, uri),
+  extractMetadata: track => storageManager.extractTrackMetadata(track)
+};
+
+// Export singleton instance
+export const playerService = PlayerService.getInstance(APP_ENVIRONMENT);
\ No newline at end of file
@@ -0,0 +1,19 @@
+/**
+ * expo-av Backend
+ * Plays through Audio.Sound, with native calls recorded by the I/O accounting
+ */
+
+import { Audio } from 'expo-av';
+import { ioAccounting, instrumentSound } from '../../utils/io';
+import { PlayerBackend, systemClock } from './PlayerBackend';
+
+export const expoAvBackend: PlayerBackend = {
+  name: 'expo-av',
+  clock: systemClock,
+  createSound: async (uri, initialStatus, onPlaybackStatusUpdate) => {
+    const { sound } = await ioAccounting.track('player', 'av', 'createAsync', () =>
+      Audio.Sound.createAsync({ uri }, initialStatus, onPlaybackStatusUpdate)
+    );
+    return instrumentSound(sound, 'player');
+  }
+};
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * Player Backend
+ * The audio engine the player drives: loading sounds, and the clock it schedules against
+ *
+ * The app plays through expo-av (ExpoAvBackend). Diagnostics harnesses use
+ * SimulatedBackend, which plays on a virtual clock so timing can be measured
+ * deterministically and without a device.
+ */
+
+import { AVPlaybackStatus, AVPlaybackStatusToSet } from 'expo-av';
+
+/**
+ * The part of Audio.Sound the player uses
+ */
+export interface PlayerSound {
+  playAsync(): Promise<unknown>;
+  pauseAsync(): Promise<unknown>;
+  stopAsync(): Promise<unknown>;
+  unloadAsync(): Promise<unknown>;
+  setPositionAsync(positionMillis: number): Promise<unknown>;
+  getStatusAsync(): Promise<AVPlaybackStatus>;
+  setOnPlaybackStatusUpdate(onPlaybackStatusUpdate: ((status: AVPlaybackStatus) => void) | null): void;
+}
+
+/**
+ * Time source and timers, so a simulated backend can also control the player's own scheduling
+ */
+export interface PlayerClock {
+  now(): number;
+  setTimeout(callback: () => void, delayMs: number): unknown;
+  clearTimeout(handle: unknown): void;
+  setInterval(callback: () => void, intervalMs: number): unknown;
+  clearInterval(handle: unknown): void;
+}
+
+export interface PlayerBackend {
+  name: string;
+  clock: PlayerClock;
+  createSound(
+    uri: string,
+    initialStatus: AVPlaybackStatusToSet,
+    onPlaybackStatusUpdate?: (status: AVPlaybackStatus) => void
+  ): Promise<PlayerSound>;
+}
+
+/**
+ * Wall clock and the global timers
+ */
+export const systemClock: PlayerClock = {
+  now: () => Date.now(),
+  setTimeout: (callback, delayMs) => setTimeout(callback, delayMs),
+  clearTimeout: handle => clearTimeout(handle as ReturnType<typeof setTimeout>),
+  setInterval: (callback, intervalMs) => setInterval(callback, intervalMs),
+  clearInterval: handle => clearInterval(handle as ReturnType<typeof setInterval>)
+};
\ No newline at end of file
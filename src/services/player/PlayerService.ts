@@ -1,39 +1,108 @@
 /**
  * Player Service
  * Handles audio playback functionality
+ *
+ * The audio engine and the storage it plays from come in through a
+ * PlayerEnvironment; the app's instance is created in AppPlayer.
  */
 
-import { Audio } from 'expo-av';
 import { Track } from '../../types';
 import { logger } from '../../utils/logger';
-import { storageManager } from '../storage/StorageManager';
+import { RequestPriority } from '../storage/InFlightRegistry';
+import { DataBudgetError } from '../network/DataBudgetError';
+import { toPlainTrack } from '../catalog/Catalog';
+import { PlayerBackend, PlayerSound } from './PlayerBackend';
 
-class PlayerService {
+// Number of upcoming tracks the player keeps track of
+const QUEUE_WINDOW_SIZE = 3;
+
+// How long a warmed sound survives the finger lifting, onPressOut fires before onPress
+const WARM_UP_GRACE_MS = 500;
+
+/**
+ * Dependencies the player reaches outside of itself for
+ * Replaced by diagnostics harnesses to run the player against fakes
+ */
+export interface PlayerEnvironment {
+  backend: PlayerBackend;
+  resolveUri: (track: Track, priority: RequestPriority) => Promise<string>;
+  warmUri: (track: Track) => Promise<string | null>;
+  continueUri: (track: Track, uri: string) => Promise<string> | null;
+  extractMetadata: (track: Track) => Promise<void>;
+}
+
+interface PreloadedTrack {
+  track: Track;
+  sound: PlayerSound;
+}
+
+interface Handoff {
+  stalled: boolean; // the head ran out before the rest arrived
+  finishedStatus: any; // the head's final status, replayed if the rest never arrives
+}
+
+interface WarmedTrack {
+  track: Track;
+  uri: string | null;
+  sound: Promise<PlayerSound | null>;
+  discarded: boolean;
+  releaseTimer: unknown;
+}
+
+export class PlayerService {
   private static instance: PlayerService;
-  private sound: Audio.Sound | null = null;
+  private sound: PlayerSound | null = null;
   private currentTrack: Track | null = null;
   private isPlaying: boolean = false;
   private position: number = 0;
   private duration: number = 0;
-  private updateInterval: NodeJS.Timeout | null = null;
+  private updateInterval: unknown = null;
   private onPlaybackStatusUpdate: ((status: any) => void) | null = null;
+  private onTrackAdvanced: ((track: Track) => void) | null = null;
+  private upcomingTracks: Track[] = [];
+  private preloaded: PreloadedTrack | null = null;
+  private preloadGeneration: number = 0;
+  private warmed: WarmedTrack | null = null;
+  private handoff: Handoff | null = null;
+  private autoAdvanceEnabled: boolean = true;
+  private playGeneration: number = 0;
+  private environment: PlayerEnvironment;
+  private backend: PlayerBackend;
   
-  private constructor() {}
+  private constructor(environment: PlayerEnvironment) {
+    this.environment = environment;
+    this.backend = environment.backend;
+  }
   
   /**
    * Get the singleton instance of the player service
+   * @param environment Dependencies of the instance, required on the first call (see AppPlayer)
    */
-  public static getInstance(): PlayerService {
+  public static getInstance(environment?: PlayerEnvironment): PlayerService {
     if (!PlayerService.instance) {
-      PlayerService.instance = new PlayerService();
+      if (!environment) {
+        throw new Error('The player has not been created yet');
+      }
+      PlayerService.instance = new PlayerService(environment);
     }
     return PlayerService.instance;
   }
   
+  /**
+   * Create a player separate from the app's, on its own dependencies
+   * Used by diagnostics harnesses so they never touch real playback state
+   */
+  public static createIsolated(environment: PlayerEnvironment): PlayerService {
+    return new PlayerService(environment);
+  }
+  
   /**
    * Play a track
    */
   public async play(track: Track): Promise<void> {
+    const generation = ++this.playGeneration;
+    this.handoff = null;
+    
     try {
       logger.info(`Playing track: ${track.title}`);
       
@@ -43,13 +112,47 @@ class PlayerService {
         this.sound = null;
       }
       
+      // The track may already be loaded as part of the queue window (e.g. skip to next)
+      if (this.preloaded && this.preloaded.track.id === track.id) {
+        await this.discardWarmUp();
+        await this.promotePreloaded();
+        return;
+      }
+      
+      // Or by the touch-down that led to this play
+      const warmedSound = await this.takeWarmedSound(track);
+      
       // Store track info
       this.currentTrack = track;
       
+      if (warmedSound) {
+        if (generation !== this.playGeneration) {
+          await warmedSound.unloadAsync();
+          return;
+        }
+        
+        if (this.sound) {
+          await this.sound.unloadAsync();
+        }
+        
+        this.sound = warmedSound;
+        this.position = 0;
+        warmedSound.setOnPlaybackStatusUpdate(this.handlePlaybackStatusUpdate);
+        await warmedSound.playAsync();
+        this.isPlaying = true;
+        
+        if (!track.artwork) {
+          this.tryExtractArtwork(track);
+        }
+        
+        logger.debug(`Started warmed sound for track: ${track.title}`);
+        return;
+      }
+      
       // If no URI is provided, get it from the storage manager
       let uri = track.uri;
       if (!uri) {
-        uri = await storageManager.getPlayableUri(track);
+        uri = await this.environment.resolveUri(track, RequestPriority.INTERACTIVE);
       }
       
       // Try to extract artwork if not already present
@@ -58,15 +161,30 @@ class PlayerService {
       }
       
       // Create and load the sound
-      const { sound } = await Audio.Sound.createAsync(
-        { uri },
+      const sound = await this.backend.createSound(
+        uri,
         { shouldPlay: true },
         this.handlePlaybackStatusUpdate
       );
       
+      // A newer play() started while this one was loading, drop this sound
+      // instead of leaving it playing with no reference
+      if (generation !== this.playGeneration) {
+        await sound.unloadAsync();
+        return;
+      }
+      
+      // Replace whatever a concurrent play() loaded in the meantime
+      if (this.sound) {
+        await this.sound.unloadAsync();
+      }
+      
       this.sound = sound;
       this.isPlaying = true;
       
+      // The URI may be a cached head of the track
+      this.armHandoff(track, uri, sound);
+      
       logger.debug(`Sound loaded for track: ${track.title}`);
     } catch (error) {
       logger.error(`Error playing track: ${track.title}`, error);
@@ -74,13 +192,200 @@ class PlayerService {
     }
   }
   
+  /**
+   * Switch from a partially cached head to the rest of its track once that is available
+   * The head plays meanwhile; if it runs out first, playback waits at its end,
+   * and if the rest cannot be fetched the head's end becomes the track's
+   */
+  private armHandoff(track: Track, uri: string, sound: PlayerSound): void {
+    const continuation = this.environment.continueUri(track, uri);
+    if (!continuation) return;
+    
+    const handoff: Handoff = { stalled: false, finishedStatus: null };
+    this.handoff = handoff;
+    
+    let next: PlayerSound | null = null;
+    let headPaused = false;
+    
+    continuation
+      .then(async nextUri => {
+        if (this.sound !== sound) return;
+        
+        next = await this.backend.createSound(nextUri, { shouldPlay: false });
+        
+        const status = await sound.getStatusAsync();
+        if (this.sound !== sound || !status.isLoaded) {
+          throw new Error('The head was replaced while the rest loaded');
+        }
+        
+        // Silence the head before the rest starts so the two never overlap,
+        // then read where it stopped so the switch lands on the same sample
+        const wasPlaying = status.isPlaying;
+        sound.setOnPlaybackStatusUpdate(null);
+        if (wasPlaying) {
+          await sound.pauseAsync();
+          headPaused = true;
+        }
+        const paused = await sound.getStatusAsync();
+        const position = paused.isLoaded ? paused.positionMillis : status.positionMillis;
+        if (this.sound !== sound) {
+          throw new Error('The head was replaced while it paused');
+        }
+        await next.setPositionAsync(position);
+        
+        this.sound = next;
+        next.setOnPlaybackStatusUpdate(this.handlePlaybackStatusUpdate);
+        if (wasPlaying || handoff.stalled) {
+          await next.playAsync();
+        }
+        
+        sound.unloadAsync().catch(error => logger.warn('Error unloading cached head', error));
+        logger.debug(`Continued ${track.title} past its cached head at ${position}ms`);
+      })
+      .catch(error => {
+        if (next && this.sound !== next) {
+          next.unloadAsync().catch(() => {});
+        }
+        if (this.sound !== sound) return;
+        
+        logger.warn(`Failed to continue ${track.title} past its cached head`, error);
+        if (this.handoff === handoff) {
+          this.handoff = null;
+        }
+        
+        // Without the rest, the head's end is the track's end
+        if (handoff.finishedStatus) {
+          this.handlePlaybackStatusUpdate(handoff.finishedStatus);
+          return;
+        }
+        sound.setOnPlaybackStatusUpdate(this.handlePlaybackStatusUpdate);
+        if (headPaused) {
+          sound.playAsync().catch(playError => logger.warn('Error resuming cached head', playError));
+        }
+      })
+      .finally(() => {
+        if (this.handoff === handoff) {
+          this.handoff = null;
+        }
+      });
+  }
+  
+  /**
+   * Start loading a track the user is likely about to play (touch-down on its row)
+   * Only work that needs no audio transfer is done; play() adopts the result
+   */
+  public warmUp(track: Track): void {
+    if (this.warmed && this.warmed.track.id === track.id) {
+      // Touched again within the grace period
+      if (this.warmed.releaseTimer) {
+        this.backend.clock.clearTimeout(this.warmed.releaseTimer);
+        this.warmed.releaseTimer = null;
+      }
+      return;
+    }
+    
+    // Already loaded
+    if (this.currentTrack?.id === track.id || this.preloaded?.track.id === track.id) {
+      return;
+    }
+    
+    this.discardWarmUp();
+    
+    const entry: WarmedTrack = { track, uri: null, sound: Promise.resolve(null), discarded: false, releaseTimer: null };
+    entry.sound = (async () => {
+      const uri = await this.environment.warmUri(track);
+      if (!uri || entry.discarded) return null;
+      
+      entry.uri = uri;
+      const sound = await this.backend.createSound(uri, { shouldPlay: false });
+      
+      // Cancelled while loading
+      if (entry.discarded) {
+        await sound.unloadAsync();
+        return null;
+      }
+      return sound;
+    })().catch(error => {
+      // Best effort, play() resolves the track again and surfaces real failures
+      logger.debug(`Not warming up ${track.title}: ${error?.message ?? error}`);
+      return null;
+    });
+    
+    this.warmed = entry;
+  }
+  
+  /**
+   * Let go of a warmed track unless play() claims it shortly
+   */
+  public releaseWarmUp(track: Track): void {
+    const entry = this.warmed;
+    if (!entry || entry.track.id !== track.id || entry.releaseTimer) return;
+    
+    entry.releaseTimer = this.backend.clock.setTimeout(() => {
+      entry.releaseTimer = null;
+      if (this.warmed === entry) {
+        this.discardWarmUp();
+      }
+    }, WARM_UP_GRACE_MS);
+  }
+  
+  /**
+   * Claim the warmed sound for a track being played, discarding any other warm-up
+   */
+  private async takeWarmedSound(track: Track): Promise<PlayerSound | null> {
+    const entry = this.warmed;
+    if (!entry) return null;
+    
+    if (entry.track.id !== track.id) {
+      await this.discardWarmUp();
+      return null;
+    }
+    
+    this.warmed = null;
+    if (entry.releaseTimer) {
+      this.backend.clock.clearTimeout(entry.releaseTimer);
+      entry.releaseTimer = null;
+    }
+    
+    const sound = await entry.sound;
+    
+    // The caller resolved a different URI (e.g. the file was cached meanwhile)
+    if (sound && track.uri && entry.uri !== track.uri) {
+      await sound.unloadAsync();
+      return null;
+    }
+    return sound;
+  }
+  
+  /**
+   * Unload the warmed sound, if any, once it finishes loading
+   */
+  private async discardWarmUp(): Promise<void> {
+    const entry = this.warmed;
+    if (!entry) return;
+    
+    this.warmed = null;
+    entry.discarded = true;
+    if (entry.releaseTimer) {
+      this.backend.clock.clearTimeout(entry.releaseTimer);
+      entry.releaseTimer = null;
+    }
+    
+    try {
+      const sound = await entry.sound;
+      await sound?.unloadAsync();
+    } catch (error) {
+      logger.warn('Error unloading warmed sound', error);
+    }
+  }
+  
   /**
    * Try to extract artwork from the audio file if not already present
    */
   private async tryExtractArtwork(track: Track): Promise<void> {
     try {
-      // Let the appropriate storage provider extract metadata
-      await storageManager.extractTrackMetadata(track);
+      // The environment hands this to the storage provider the track came from
+      await this.environment.extractMetadata(track);
     } catch (error) {
       logger.warn(`Failed to extract artwork for: ${track.title}`, error);
       // Continue without artwork
@@ -210,13 +515,162 @@ class PlayerService {
     this.onPlaybackStatusUpdate = callback;
   }
   
+  /**
+   * Set the callback fired when the player advanced to the next track on its own
+   * The store uses it to reconcile its state after the transition already happened
+   */
+  public setOnTrackAdvanced(callback: ((track: Track) => void) | null): void {
+    this.onTrackAdvanced = callback;
+  }
+  
+  /**
+   * Enable or disable autonomous advancement through the queue window
+   * When disabled, completion is reported through the status callback as before
+   */
+  public setAutoAdvanceEnabled(enabled: boolean): void {
+    this.autoAdvanceEnabled = enabled;
+    if (!enabled) {
+      this.discardPreloaded();
+    }
+  }
+  
+  /**
+   * Hand the player the tracks that follow the current one
+   * The first track is resolved and loaded ahead of time, so the transition at the
+   * end of the current track needs no URI resolution or sound creation
+   */
+  public async setUpcomingTracks(tracks: Track[]): Promise<void> {
+    this.upcomingTracks = tracks.slice(0, QUEUE_WINDOW_SIZE);
+    
+    if (!this.autoAdvanceEnabled) {
+      return;
+    }
+    
+    const next = this.upcomingTracks[0];
+    if (this.preloaded && next && this.preloaded.track.id === next.id) {
+      return;
+    }
+    
+    await this.discardPreloaded();
+    if (next) {
+      await this.preload(next);
+    }
+  }
+  
+  /**
+   * Resolve and load a track without starting it
+   */
+  private async preload(track: Track): Promise<void> {
+    const generation = ++this.preloadGeneration;
+    
+    try {
+      // Low priority, a tap on this track joins and promotes the same download
+      const uri = await this.environment.resolveUri(track, RequestPriority.PREFETCH);
+      const sound = await this.backend.createSound(uri, { shouldPlay: false });
+      
+      // The window changed while loading
+      if (generation !== this.preloadGeneration) {
+        await sound.unloadAsync();
+        return;
+      }
+      
+      // Queue entries can be catalog views, whose fields a spread would not copy
+      this.preloaded = { track: { ...toPlainTrack(track), uri }, sound };
+      logger.debug(`Preloaded next track: ${track.title}`);
+    } catch (error) {
+      if (error instanceof DataBudgetError) {
+        logger.debug(`Not preloading ${track.title}: ${error.message}`);
+        return;
+      }
+      logger.warn(`Failed to preload next track: ${track.title}`, error);
+    }
+  }
+  
+  /**
+   * Unload the preloaded sound, if any
+   */
+  private async discardPreloaded(): Promise<void> {
+    this.preloadGeneration++;
+    const preloaded = this.preloaded;
+    this.preloaded = null;
+    
+    if (preloaded) {
+      try {
+        await preloaded.sound.unloadAsync();
+      } catch (error) {
+        logger.warn('Error unloading preloaded sound', error);
+      }
+    }
+  }
+  
+  /**
+   * Make the preloaded sound the current one and start it
+   */
+  private async promotePreloaded(): Promise<Track | null> {
+    const preloaded = this.preloaded;
+    if (!preloaded) return null;
+    
+    this.preloaded = null;
+    this.handoff = null;
+    const finished = this.sound;
+    
+    this.sound = preloaded.sound;
+    this.currentTrack = preloaded.track;
+    this.position = 0;
+    preloaded.sound.setOnPlaybackStatusUpdate(this.handlePlaybackStatusUpdate);
+    
+    // Start audio first, everything else can happen after the transition
+    await preloaded.sound.playAsync();
+    this.isPlaying = true;
+    
+    if (finished) {
+      finished.unloadAsync().catch(error => logger.warn('Error unloading finished sound', error));
+    }
+    
+    if (this.upcomingTracks[0]?.id === preloaded.track.id) {
+      this.upcomingTracks.shift();
+    }
+    
+    if (!preloaded.track.artwork) {
+      this.tryExtractArtwork(preloaded.track);
+    }
+    
+    logger.debug(`Advanced to preloaded track: ${preloaded.track.title}`);
+    return preloaded.track;
+  }
+  
+  /**
+   * Advance to the preloaded track when the current one finishes
+   */
+  private async advanceAutonomously(): Promise<void> {
+    try {
+      const track = await this.promotePreloaded();
+      if (!track) return;
+      
+      if (this.onTrackAdvanced) {
+        this.onTrackAdvanced(track);
+      }
+      
+      // Keep the window armed even if the store is slow to reconcile
+      const next = this.upcomingTracks[0];
+      if (next) {
+        await this.preload(next);
+      }
+    } catch (error) {
+      logger.error('Error advancing to the next track', error);
+    }
+  }
+  
   /**
    * Clean up resources
    */
   public async cleanup(): Promise<void> {
+    await this.discardWarmUp();
+    await this.discardPreloaded();
     await this.unloadSound();
     this.stopPositionUpdateInterval();
     this.onPlaybackStatusUpdate = null;
+    this.onTrackAdvanced = null;
   }
   
   /**
@@ -242,6 +696,24 @@ class PlayerService {
    * Handle playback status updates
    */
   private handlePlaybackStatusUpdate = (status: any): void => {
+    // A cached head is not the end of the track
+    if (this.handoff && status.isLoaded) {
+      if (status.didJustFinish) {
+        this.handoff.stalled = true;
+        this.handoff.finishedStatus = status;
+        return;
+      }
+      if (this.currentTrack?.duration) {
+        status = { ...status, durationMillis: this.currentTrack.duration };
+      }
+    }
+    
+    // Hand over to the preloaded track before anything else touches the JS thread
+    if (status.isLoaded && status.didJustFinish && this.autoAdvanceEnabled && this.preloaded) {
+      this.advanceAutonomously();
+      return;
+    }
+    
     if (status.isLoaded) {
       this.position = status.positionMillis;
       this.duration = status.durationMillis || 0;
@@ -270,10 +742,10 @@ class PlayerService {
    */
   private startPositionUpdateInterval(): void {
     if (this.updateInterval) {
-      clearInterval(this.updateInterval);
+      this.backend.clock.clearInterval(this.updateInterval);
     }
     
-    this.updateInterval = setInterval(async () => {
+    this.updateInterval = this.backend.clock.setInterval(async () => {
       if (this.sound && this.isPlaying) {
         const status = await this.sound.getStatusAsync();
         // Check if status is not an error status before accessing properties
@@ -289,11 +761,8 @@ class PlayerService {
    */
   private stopPositionUpdateInterval(): void {
     if (this.updateInterval) {
-      clearInterval(this.updateInterval);
+      this.backend.clock.clearInterval(this.updateInterval);
       this.updateInterval = null;
     }
   }
-}
-
-// Export singleton instance
-export const playerService = PlayerService.getInstance();
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,531 @@
+/**
+ * Simulated Backend
+ * Deterministic stand-in for expo-av that plays on a virtual clock
+ *
+ * Nothing moves until the clock is advanced. Loading a sound takes a
+ * configurable latency, local files play as soon as they are told to, and
+ * streams download at the network bandwidth relative to their bitrate:
+ * playback waits for a start buffer and stalls when it catches up with the
+ * download. Loads, starts, stalls and finishes are logged in virtual time so
+ * harnesses can measure tap-to-audio latency, gaps between tracks and skip
+ * storms without a device.
+ */
+
+import { AVPlaybackStatus, AVPlaybackStatusToSet } from 'expo-av';
+import { logger } from '../../utils/logger';
+import { PlayerBackend, PlayerClock, PlayerSound } from './PlayerBackend';
+
+// Defaults
+const DEFAULT_DURATION_MS = 180000;
+const DEFAULT_LOCAL_LOAD_MS = 40;
+const DEFAULT_STREAM_LOAD_MS = 300;
+const DEFAULT_STREAM_BITRATE_KBPS = 320;
+const DEFAULT_BANDWIDTH_KBPS = 4000;
+const DEFAULT_START_BUFFER_MS = 2000;
+const DEFAULT_PROGRESS_INTERVAL_MS = 500; // matches expo-av's default progress interval
+const MAX_EVENTS = 10000;
+
+// Promise turns given to awaiting code after each timer, see VirtualClock.advance
+const MICROTASK_DRAIN_TURNS = 50;
+
+// Transition times are fractional, comparisons allow for rounding and timers never
+// fire twice at the same instant without progress
+const EPSILON_MS = 0.001;
+
+interface VirtualTimer {
+  id: number;
+  dueAt: number;
+  intervalMs: number | null;
+  callback: () => void;
+}
+
+const drainMicrotasks = async (): Promise<void> => {
+  for (let i = 0; i < MICROTASK_DRAIN_TURNS; i++) {
+    await Promise.resolve();
+  }
+};
+
+/**
+ * Clock that only moves when advanced, running timers in due order
+ */
+export class VirtualClock implements PlayerClock {
+  private current: number;
+  private nextId: number = 1;
+  private timers: Map<number, VirtualTimer> = new Map();
+  
+  constructor(start: number = 0) {
+    this.current = start;
+  }
+  
+  public now(): number {
+    return this.current;
+  }
+  
+  public setTimeout(callback: () => void, delayMs: number): unknown {
+    return this.schedule(callback, delayMs, null);
+  }
+  
+  public clearTimeout(handle: unknown): void {
+    this.timers.delete(handle as number);
+  }
+  
+  public setInterval(callback: () => void, intervalMs: number): unknown {
+    return this.schedule(callback, intervalMs, Math.max(1, intervalMs));
+  }
+  
+  public clearInterval(handle: unknown): void {
+    this.timers.delete(handle as number);
+  }
+  
+  public getTimeoutCount(): number {
+    return Array.from(this.timers.values()).filter(timer => timer.intervalMs === null).length;
+  }
+  
+  public getIntervalCount(): number {
+    return Array.from(this.timers.values()).filter(timer => timer.intervalMs !== null).length;
+  }
+  
+  /**
+   * Move time forward, running each timer at its due time
+   * Pending promise callbacks run after every timer, so async code reacts before the next one fires
+   */
+  public async advance(ms: number): Promise<void> {
+    const until = this.current + ms;
+    await drainMicrotasks();
+    
+    let timer = this.nextDue(until);
+    while (timer) {
+      this.current = Math.max(this.current, timer.dueAt);
+      if (timer.intervalMs !== null) {
+        timer.dueAt += timer.intervalMs;
+      } else {
+        this.timers.delete(timer.id);
+      }
+      
+      try {
+        timer.callback();
+      } catch (error) {
+        logger.error('Error in virtual timer callback', error);
+      }
+      await drainMicrotasks();
+      timer = this.nextDue(until);
+    }
+    
+    this.current = until;
+  }
+  
+  /**
+   * Advance timer by timer until a promise settles
+   * Fails when nothing is scheduled to settle it within maxMs of virtual time
+   */
+  public async runUntil<T>(promise: Promise<T>, maxMs: number = 60000): Promise<T> {
+    let settled = false;
+    const tracked = promise.finally(() => {
+      settled = true;
+    });
+    tracked.catch(() => undefined);
+    
+    const deadline = this.current + maxMs;
+    await drainMicrotasks();
+    while (!settled) {
+      const next = this.nextDue(deadline);
+      if (!next) {
+        throw new Error(`Still waiting after ${maxMs}ms of virtual time`);
+      }
+      await this.advance(next.dueAt - this.current);
+    }
+    return tracked;
+  }
+  
+  private schedule(callback: () => void, delayMs: number, intervalMs: number | null): number {
+    const id = this.nextId++;
+    this.timers.set(id, { id, dueAt: this.current + Math.max(0, delayMs || 0), intervalMs, callback });
+    return id;
+  }
+  
+  /**
+   * Earliest timer due by a time, ties in the order they were scheduled
+   */
+  private nextDue(until: number): VirtualTimer | null {
+    let next: VirtualTimer | null = null;
+    for (const timer of this.timers.values()) {
+      if (timer.dueAt <= until && (!next || timer.dueAt < next.dueAt || (timer.dueAt === next.dueAt && timer.id < next.id))) {
+        next = timer;
+      }
+    }
+    return next;
+  }
+}
+
+export type SimulatedEventType = 'load-start' | 'loaded' | 'audible' | 'stalled' | 'finished' | 'unloaded';
+
+export interface SimulatedEvent {
+  type: SimulatedEventType;
+  soundId: number;
+  uri: string;
+  at: number; // virtual time
+}
+
+export interface SimulatedBackendOptions {
+  clock?: VirtualClock;
+  durationFor?: (uri: string) => number;
+  loadLatencyMs?: (uri: string, isStream: boolean) => number;
+  isStream?: (uri: string) => boolean;
+  streamBitrateKbps?: number;
+  bandwidthKbps?: number;
+  startBufferMs?: number; // buffered media a stream needs before it starts or resumes
+  progressUpdateIntervalMillis?: number;
+}
+
+type SimulatedSettings = Required<Omit<SimulatedBackendOptions, 'clock'>>;
+
+export class SimulatedBackend implements PlayerBackend {
+  public readonly name = 'simulated';
+  public readonly clock: VirtualClock;
+  public readonly settings: SimulatedSettings;
+  public created: number = 0;
+  public useAfterUnload: number = 0;
+  public stalls: number = 0;
+  public events: SimulatedEvent[] = [];
+  private live: Set<SimulatedSound> = new Set();
+  private nextSoundId: number = 1;
+  
+  constructor(options: SimulatedBackendOptions = {}) {
+    this.clock = options.clock ?? new VirtualClock();
+    this.settings = {
+      durationFor: options.durationFor ?? (() => DEFAULT_DURATION_MS),
+      loadLatencyMs: options.loadLatencyMs ?? ((uri, isStream) => isStream ? DEFAULT_STREAM_LOAD_MS : DEFAULT_LOCAL_LOAD_MS),
+      isStream: options.isStream ?? (uri => /^https?:/.test(uri)),
+      streamBitrateKbps: options.streamBitrateKbps ?? DEFAULT_STREAM_BITRATE_KBPS,
+      bandwidthKbps: options.bandwidthKbps ?? DEFAULT_BANDWIDTH_KBPS,
+      startBufferMs: options.startBufferMs ?? DEFAULT_START_BUFFER_MS,
+      progressUpdateIntervalMillis: options.progressUpdateIntervalMillis ?? DEFAULT_PROGRESS_INTERVAL_MS
+    };
+  }
+  
+  public async createSound(
+    uri: string,
+    initialStatus: AVPlaybackStatusToSet,
+    onPlaybackStatusUpdate?: (status: AVPlaybackStatus) => void
+  ): Promise<PlayerSound> {
+    const id = this.nextSoundId++;
+    const isStream = this.settings.isStream(uri);
+    this.record('load-start', id, uri);
+    
+    const latency = this.settings.loadLatencyMs(uri, isStream);
+    if (latency > 0) {
+      await new Promise<void>(resolve => this.clock.setTimeout(resolve, latency));
+    }
+    
+    const sound = new SimulatedSound(this, id, uri, isStream, initialStatus, onPlaybackStatusUpdate);
+    this.created++;
+    this.live.add(sound);
+    this.record('loaded', id, uri);
+    sound.start();
+    return sound;
+  }
+  
+  /**
+   * Sounds loaded and not yet unloaded
+   */
+  public getLiveSounds(): number {
+    return this.live.size;
+  }
+  
+  /**
+   * Live sounds that still have a status listener attached
+   */
+  public countListeners(): number {
+    let count = 0;
+    this.live.forEach(sound => {
+      if (sound.hasListener()) count++;
+    });
+    return count;
+  }
+  
+  /**
+   * Log an event at the current virtual time, called by the simulated sounds
+   */
+  public record(type: SimulatedEventType, soundId: number, uri: string): void {
+    if (type === 'stalled') {
+      this.stalls++;
+    }
+    
+    this.events.push({ type, soundId, uri, at: this.clock.now() });
+    if (this.events.length > MAX_EVENTS) {
+      this.events.splice(0, this.events.length - MAX_EVENTS);
+    }
+  }
+  
+  /**
+   * Forget an unloaded sound, called by the simulated sounds
+   */
+  public release(sound: SimulatedSound): void {
+    this.live.delete(sound);
+  }
+}
+
+/**
+ * Sound whose position, buffer and status updates follow the virtual clock
+ * Transitions are scheduled for the exact virtual time they happen at
+ */
+class SimulatedSound implements PlayerSound {
+  private position: number;
+  private bufferStart: number; // streams keep one contiguous buffered range
+  private bufferedTo: number;
+  private playing: boolean;
+  private buffering: boolean = false;
+  private audible: boolean = false;
+  private loaded: boolean = true;
+  private lastSyncAt: number;
+  private nextProgressAt: number;
+  private timer: unknown = null;
+  private listener: ((status: AVPlaybackStatus) => void) | null;
+  private readonly duration: number;
+  private readonly fillRate: number; // media milliseconds downloaded per millisecond
+  
+  constructor(
+    private backend: SimulatedBackend,
+    public readonly id: number,
+    private uri: string,
+    private isStream: boolean,
+    initialStatus: AVPlaybackStatusToSet,
+    listener?: (status: AVPlaybackStatus) => void
+  ) {
+    const { settings, clock } = backend;
+    this.duration = settings.durationFor(uri);
+    this.fillRate = settings.bandwidthKbps / settings.streamBitrateKbps;
+    this.position = Math.max(0, Math.min(initialStatus.positionMillis ?? 0, this.duration));
+    this.bufferStart = isStream ? this.position : 0;
+    this.bufferedTo = isStream ? this.position : this.duration;
+    this.playing = !!initialStatus.shouldPlay;
+    this.listener = listener || null;
+    this.lastSyncAt = clock.now();
+    this.nextProgressAt = this.lastSyncAt + settings.progressUpdateIntervalMillis;
+  }
+  
+  public hasListener(): boolean {
+    return this.listener !== null;
+  }
+  
+  /**
+   * Begin playing if loaded with shouldPlay
+   */
+  public start(): void {
+    this.update();
+    this.schedule();
+  }
+  
+  public async playAsync(): Promise<AVPlaybackStatus> {
+    this.ensureLoaded();
+    this.sync();
+    this.playing = true;
+    this.update();
+    this.schedule();
+    return this.getStatus(false);
+  }
+  
+  public async pauseAsync(): Promise<AVPlaybackStatus> {
+    this.ensureLoaded();
+    this.sync();
+    this.playing = false;
+    this.buffering = false;
+    this.schedule();
+    return this.getStatus(false);
+  }
+  
+  public async stopAsync(): Promise<AVPlaybackStatus> {
+    this.ensureLoaded();
+    this.sync();
+    this.playing = false;
+    this.buffering = false;
+    this.seek(0);
+    this.schedule();
+    return this.getStatus(false);
+  }
+  
+  public async setPositionAsync(positionMillis: number): Promise<AVPlaybackStatus> {
+    this.ensureLoaded();
+    this.sync();
+    this.seek(positionMillis);
+    this.update();
+    this.schedule();
+    return this.getStatus(false);
+  }
+  
+  public async getStatusAsync(): Promise<AVPlaybackStatus> {
+    if (!this.loaded) {
+      return { isLoaded: false } as AVPlaybackStatus;
+    }
+    this.sync();
+    return this.getStatus(false);
+  }
+  
+  public async unloadAsync(): Promise<AVPlaybackStatus> {
+    if (this.loaded) {
+      this.loaded = false;
+      this.playing = false;
+      this.listener = null;
+      this.clearTimer();
+      this.backend.release(this);
+      this.backend.record('unloaded', this.id, this.uri);
+    }
+    return { isLoaded: false } as AVPlaybackStatus;
+  }
+  
+  public setOnPlaybackStatusUpdate(listener: ((status: AVPlaybackStatus) => void) | null): void {
+    this.listener = listener;
+  }
+  
+  /**
+   * Bring position and buffer up to the current virtual time
+   */
+  private sync(): void {
+    const now = this.backend.clock.now();
+    const elapsed = now - this.lastSyncAt;
+    this.lastSyncAt = now;
+    if (elapsed <= 0) return;
+    
+    if (this.isStream) {
+      this.bufferedTo = Math.min(this.duration, this.bufferedTo + elapsed * this.fillRate);
+    }
+    if (this.playing && !this.buffering) {
+      this.position = Math.min(this.position + elapsed, this.bufferedTo, this.duration);
+    }
+  }
+  
+  /**
+   * Seeking outside the buffered range of a stream starts a new one there
+   */
+  private seek(positionMillis: number): void {
+    this.position = Math.max(0, Math.min(positionMillis, this.duration));
+    if (this.isStream && (this.position < this.bufferStart || this.position > this.bufferedTo)) {
+      this.bufferStart = this.position;
+      this.bufferedTo = this.position;
+    }
+  }
+  
+  /**
+   * Apply the transition due now, if any
+   */
+  private update(): 'finished' | 'changed' | null {
+    if (!this.playing) return null;
+    
+    if (this.position >= this.duration - EPSILON_MS) {
+      this.position = this.duration;
+      this.playing = false;
+      this.buffering = false;
+      this.backend.record('finished', this.id, this.uri);
+      return 'finished';
+    }
+    
+    const ahead = this.bufferedTo - this.position;
+    if (this.buffering) {
+      if (ahead < this.backend.settings.startBufferMs - EPSILON_MS && this.bufferedTo < this.duration) {
+        return null;
+      }
+      this.buffering = false;
+      this.markAudible();
+      return 'changed';
+    }
+    
+    if (this.isStream && ahead <= EPSILON_MS) {
+      this.buffering = true;
+      // Waiting for the first audio is loading, not a stall
+      if (this.audible) {
+        this.backend.record('stalled', this.id, this.uri);
+      }
+      return 'changed';
+    }
+    
+    this.markAudible();
+    return null;
+  }
+  
+  private markAudible(): void {
+    if (!this.audible) {
+      this.audible = true;
+      this.backend.record('audible', this.id, this.uri);
+    }
+  }
+  
+  /**
+   * Schedule the next status update or transition, whichever comes first
+   */
+  private schedule(): void {
+    this.clearTimer();
+    if (!this.loaded || !this.playing) return;
+    
+    const now = this.backend.clock.now();
+    let delay = Math.max(0, this.nextProgressAt - now);
+    
+    if (this.buffering) {
+      const target = Math.min(this.position + this.backend.settings.startBufferMs, this.duration);
+      delay = Math.min(delay, Math.max(0, (target - this.bufferedTo) / this.fillRate));
+    } else {
+      delay = Math.min(delay, this.duration - this.position);
+      if (this.isStream && this.bufferedTo < this.duration && this.fillRate < 1) {
+        delay = Math.min(delay, (this.bufferedTo - this.position) / (1 - this.fillRate));
+      }
+    }
+    
+    this.timer = this.backend.clock.setTimeout(() => this.onTimer(), Math.max(EPSILON_MS, delay));
+  }
+  
+  private onTimer(): void {
+    this.timer = null;
+    if (!this.loaded) return;
+    
+    this.sync();
+    const change = this.update();
+    const now = this.backend.clock.now();
+    
+    if (change === 'finished') {
+      this.emit(true);
+    } else if (change === 'changed' || now >= this.nextProgressAt - EPSILON_MS) {
+      this.emit(false);
+    }
+    
+    this.schedule();
+  }
+  
+  private emit(didJustFinish: boolean): void {
+    this.nextProgressAt = this.backend.clock.now() + this.backend.settings.progressUpdateIntervalMillis;
+    this.listener?.(this.getStatus(didJustFinish));
+  }
+  
+  private clearTimer(): void {
+    if (this.timer !== null) {
+      this.backend.clock.clearTimeout(this.timer);
+      this.timer = null;
+    }
+  }
+  
+  private ensureLoaded(): void {
+    if (!this.loaded) {
+      this.backend.useAfterUnload++;
+      throw new Error('Cannot complete operation because sound is not loaded');
+    }
+  }
+  
+  private getStatus(didJustFinish: boolean): AVPlaybackStatus {
+    return {
+      isLoaded: true,
+      uri: this.uri,
+      progressUpdateIntervalMillis: this.backend.settings.progressUpdateIntervalMillis,
+      durationMillis: this.duration,
+      positionMillis: Math.round(this.position),
+      playableDurationMillis: Math.round(this.bufferedTo),
+      shouldPlay: this.playing,
+      isPlaying: this.playing && !this.buffering,
+      isBuffering: this.buffering,
+      rate: 1,
+      shouldCorrectPitch: false,
+      volume: 1,
+      isMuted: false,
+      isLooping: false,
+      audioPan: 0,
+      didJustFinish
+    } as AVPlaybackStatus;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * Head Prefetcher
+ * Fetches the first seconds of OneDrive tracks the user is likely to start next,
+ * so they start instantly at a fraction of the cost of precaching them
+ *
+ * Each source (the upcoming queue, playlist rows on screen) replaces its own
+ * request, so rows scrolled past are dropped before anything is fetched for them.
+ */
+
+import { Track } from '../../types';
+import { logger } from '../../utils/logger';
+import { storageManager } from '../storage/StorageManager';
+import { OneDriveStorageProvider } from '../storage/OneDriveStorageProvider';
+import { dataBudget, DataBudgetError } from '../network/DataBudget';
+
+// Constants
+const REQUEST_DELAY_MS = 300;
+const MAX_TRACKS_PER_SOURCE = 8;
+const MAX_REMEMBERED_TRACKS = 1000;
+
+// Sources in the order their requests are served
+const SOURCES = ['queue', 'visible'] as const;
+
+export type HeadPrefetchSource = typeof SOURCES[number];
+
+class HeadPrefetcher {
+  private static instance: HeadPrefetcher;
+  private requests: Map<HeadPrefetchSource, Track[]> = new Map();
+  private handled: Set<string> = new Set();
+  private runTimer: NodeJS.Timeout | null = null;
+  private isRunning: boolean = false;
+  
+  private constructor() {}
+  
+  public static getInstance(): HeadPrefetcher {
+    if (!HeadPrefetcher.instance) {
+      HeadPrefetcher.instance = new HeadPrefetcher();
+    }
+    return HeadPrefetcher.instance;
+  }
+  
+  /**
+   * Replace the tracks a source wants heads for, most wanted first
+   */
+  public request(source: HeadPrefetchSource, tracks: Track[]): void {
+    this.requests.set(source, tracks.filter(track => track.source === 'onedrive').slice(0, MAX_TRACKS_PER_SOURCE));
+    
+    if (this.runTimer) {
+      clearTimeout(this.runTimer);
+    }
+    this.runTimer = setTimeout(() => {
+      this.runTimer = null;
+      this.run();
+    }, REQUEST_DELAY_MS);
+  }
+  
+  /**
+   * Fetch heads one at a time, re-reading the requests between tracks
+   */
+  private async run(): Promise<void> {
+    if (this.isRunning) return;
+    this.isRunning = true;
+    
+    try {
+      const provider = storageManager.getProvider('onedrive') as OneDriveStorageProvider | undefined;
+      if (!provider || !(await provider.isConnected())) {
+        return;
+      }
+      
+      let track = this.nextTrack();
+      while (track && dataBudget.canPrefetch()) {
+        this.remember(track.id);
+        
+        try {
+          await provider.prefetchHead(track);
+        } catch (error) {
+          if (error instanceof DataBudgetError) {
+            logger.debug(error.message);
+            break;
+          }
+          logger.warn(`Failed to prefetch the head of ${track.title}`, error);
+        }
+        
+        track = this.nextTrack();
+      }
+    } catch (error) {
+      logger.error('Error prefetching track heads', error);
+    } finally {
+      this.isRunning = false;
+    }
+  }
+  
+  private nextTrack(): Track | undefined {
+    for (const source of SOURCES) {
+      const track = this.requests.get(source)?.find(candidate => !this.handled.has(candidate.id));
+      if (track) return track;
+    }
+    return undefined;
+  }
+  
+  /**
+   * Tracks are tried once per session, the provider skips those already cached
+   */
+  private remember(trackId: string): void {
+    if (this.handled.size >= MAX_REMEMBERED_TRACKS) {
+      this.handled.clear();
+    }
+    this.handled.add(trackId);
+  }
+}
+
+// Export singleton instance
+export const headPrefetcher = HeadPrefetcher.getInstance();
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * Play History
+ * Persisted log of recent plays, the input for predictive precaching
+ */
+
+import { Track } from '../../types';
+import { logger } from '../../utils/logger';
+import { instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('play-history');
+
+// Constants
+const PLAY_HISTORY_STORAGE_KEY = '@sonora/play_history';
+const MAX_EVENTS = 2000;
+const PERSIST_DELAY_MS = 5000;
+
+export interface PlayEvent {
+  key: string;
+  album?: string;
+  artist?: string;
+  playedAt: number;
+}
+
+/**
+ * Identity of a track that survives rescans and ID changes
+ */
+export const historyKeyOf = (track: Track): string => {
+  return `${track.source}:${track.path || track.id}`;
+};
+
+class PlayHistory {
+  private static instance: PlayHistory;
+  private events: PlayEvent[] = [];
+  private loadPromise: Promise<void> | null = null;
+  private persistTimer: NodeJS.Timeout | null = null;
+  
+  private constructor() {}
+  
+  public static getInstance(): PlayHistory {
+    if (!PlayHistory.instance) {
+      PlayHistory.instance = new PlayHistory();
+    }
+    return PlayHistory.instance;
+  }
+  
+  /**
+   * Record that a track started playing
+   */
+  public async record(track: Track): Promise<void> {
+    await this.load();
+    
+    this.events.push({
+      key: historyKeyOf(track),
+      album: track.album,
+      artist: track.artist,
+      playedAt: Date.now()
+    });
+    
+    if (this.events.length > MAX_EVENTS) {
+      this.events.splice(0, this.events.length - MAX_EVENTS);
+    }
+    
+    this.schedulePersist();
+  }
+  
+  /**
+   * Get all recorded plays, oldest first
+   */
+  public async getEvents(): Promise<PlayEvent[]> {
+    await this.load();
+    return this.events;
+  }
+  
+  /**
+   * Load persisted events once
+   */
+  private load(): Promise<void> {
+    if (!this.loadPromise) {
+      this.loadPromise = (async () => {
+        try {
+          const saved = await AsyncStorage.getItem(PLAY_HISTORY_STORAGE_KEY);
+          if (saved) {
+            // Plays recorded while loading are newer
+            this.events = [...JSON.parse(saved), ...this.events];
+          }
+        } catch (error) {
+          logger.error('Error loading play history', error);
+        }
+      })();
+    }
+    return this.loadPromise;
+  }
+  
+  /**
+   * Persist after a short delay to batch rapid skips
+   */
+  private schedulePersist(): void {
+    if (this.persistTimer) return;
+    
+    this.persistTimer = setTimeout(async () => {
+      this.persistTimer = null;
+      try {
+        await AsyncStorage.setItem(PLAY_HISTORY_STORAGE_KEY, JSON.stringify(this.events));
+      } catch (error) {
+        logger.error('Error saving play history', error);
+      }
+    }, PERSIST_DELAY_MS);
+  }
+}
+
+// Export singleton instance
+export const playHistory = PlayHistory.getInstance();
\ No newline at end of file
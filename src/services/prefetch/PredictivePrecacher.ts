@@ -0,0 +1,357 @@
+/**
+ * Predictive Precacher
+ * Ranks OneDrive tracks by how likely they are to be played soon and
+ * downloads the best candidates while on unmetered Wi-Fi
+ *
+ * The ranking combines play frequency (decayed), recency, plays around the
+ * current time of day and continuity with the album/artist played last.
+ */
+
+import * as NetInfo from '@react-native-community/netinfo';
+import { Track } from '../../types';
+import { logger } from '../../utils/logger';
+import { metrics } from '../../utils/metrics';
+import { catalog } from '../catalog/Catalog';
+import { storageManager } from '../storage/StorageManager';
+import { OneDriveStorageProvider } from '../storage/OneDriveStorageProvider';
+import { playHistory, historyKeyOf, PlayEvent } from './PlayHistory';
+import { dataBudget } from '../network/DataBudget';
+import { instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('precache');
+
+// Constants
+const PRECACHED_KEYS_STORAGE_KEY = '@sonora/precached_tracks';
+const CACHE_BYTE_BUDGET = 512 * 1024 * 1024; // total offline OneDrive audio
+const MAX_CANDIDATES_PER_RUN = 20;
+const RUN_DELAY_MS = 30 * 1000; // let playback settle before downloading
+const FREQUENCY_HALF_LIFE_DAYS = 30;
+const RECENCY_HALF_LIFE_HOURS = 72;
+const TIME_OF_DAY_WINDOW_HOURS = 1.5;
+const ALBUM_CONTINUITY_WINDOW_MS = 24 * 60 * 60 * 1000;
+
+// Score weights
+const WEIGHT_FREQUENCY = 1;
+const WEIGHT_RECENCY = 2;
+const WEIGHT_TIME_OF_DAY = 1.5;
+const WEIGHT_SAME_ALBUM = 2;
+const WEIGHT_SAME_ARTIST = 0.5;
+
+export interface PrecacheCandidate {
+  track: Track;
+  score: number;
+}
+
+interface KeyStats {
+  frequency: number;
+  lastPlayedAt: number;
+  plays: number;
+  playsAtThisHour: number;
+}
+
+/**
+ * Distance between two hours on a 24 hour clock
+ */
+const hourDistance = (a: number, b: number): number => {
+  const diff = Math.abs(a - b) % 24;
+  return Math.min(diff, 24 - diff);
+};
+
+/**
+ * Rank tracks by predicted likelihood of being played soon
+ * @param tracks Candidate tracks
+ * @param events Play history, oldest first
+ * @param now Current time in milliseconds
+ */
+export const rankCandidates = (tracks: Track[], events: PlayEvent[], now: number = Date.now()): PrecacheCandidate[] => {
+  const currentHour = new Date(now).getHours() + new Date(now).getMinutes() / 60;
+  const stats = new Map<string, KeyStats>();
+  
+  for (const event of events) {
+    let entry = stats.get(event.key);
+    if (!entry) {
+      entry = { frequency: 0, lastPlayedAt: 0, plays: 0, playsAtThisHour: 0 };
+      stats.set(event.key, entry);
+    }
+    
+    const ageDays = (now - event.playedAt) / (24 * 60 * 60 * 1000);
+    entry.frequency += Math.pow(0.5, ageDays / FREQUENCY_HALF_LIFE_DAYS);
+    entry.lastPlayedAt = Math.max(entry.lastPlayedAt, event.playedAt);
+    entry.plays++;
+    
+    const playedDate = new Date(event.playedAt);
+    const playedHour = playedDate.getHours() + playedDate.getMinutes() / 60;
+    if (hourDistance(playedHour, currentHour) <= TIME_OF_DAY_WINDOW_HOURS) {
+      entry.playsAtThisHour++;
+    }
+  }
+  
+  const lastEvent = events.length > 0 ? events[events.length - 1] : undefined;
+  
+  const candidates: PrecacheCandidate[] = [];
+  for (const track of tracks) {
+    const key = historyKeyOf(track);
+    const entry = stats.get(key);
+    let score = 0;
+    
+    if (entry) {
+      const ageHours = (now - entry.lastPlayedAt) / (60 * 60 * 1000);
+      score += WEIGHT_FREQUENCY * entry.frequency;
+      score += WEIGHT_RECENCY * Math.pow(0.5, ageHours / RECENCY_HALF_LIFE_HOURS);
+      score += WEIGHT_TIME_OF_DAY * (entry.playsAtThisHour / entry.plays);
+    }
+    
+    // Album continuity: the rest of what was just being listened to
+    if (lastEvent && lastEvent.key !== key && now - lastEvent.playedAt < ALBUM_CONTINUITY_WINDOW_MS) {
+      if (lastEvent.album && track.album === lastEvent.album) {
+        score += WEIGHT_SAME_ALBUM;
+      } else if (lastEvent.artist && track.artist === lastEvent.artist) {
+        score += WEIGHT_SAME_ARTIST;
+      }
+    }
+    
+    if (score > 0) {
+      candidates.push({ track, score });
+    }
+  }
+  
+  return candidates.sort((a, b) => b.score - a.score);
+};
+
+class PredictivePrecacher {
+  private static instance: PredictivePrecacher;
+  private precachedKeys: Set<string> = new Set();
+  private loadPromise: Promise<void> | null = null;
+  private runTimer: NodeJS.Timeout | null = null;
+  private isRunning: boolean = false;
+  private unsubscribeNetInfo: (() => void) | null = null;
+  
+  private constructor() {}
+  
+  public static getInstance(): PredictivePrecacher {
+    if (!PredictivePrecacher.instance) {
+      PredictivePrecacher.instance = new PredictivePrecacher();
+    }
+    return PredictivePrecacher.instance;
+  }
+  
+  /**
+   * Start watching for unmetered networks and schedule a first run
+   */
+  public start(): void {
+    if (this.unsubscribeNetInfo) return;
+    
+    this.unsubscribeNetInfo = NetInfo.addEventListener(state => {
+      if (this.isUnmetered(state)) {
+        this.scheduleRun();
+      }
+    });
+    
+    // Files the cache GC deletes no longer count as precached
+    const provider = storageManager.getProvider('onedrive') as OneDriveStorageProvider | undefined;
+    provider?.setCacheFilesRemovedCallback(() => {
+      this.prune(provider).catch(error => logger.warn('Failed to prune precached tracks', error));
+    });
+    
+    this.scheduleRun();
+  }
+  
+  /**
+   * Stop watching the network and cancel a pending run
+   */
+  public stop(): void {
+    this.unsubscribeNetInfo?.();
+    this.unsubscribeNetInfo = null;
+    const provider = storageManager.getProvider('onedrive') as OneDriveStorageProvider | undefined;
+    provider?.setCacheFilesRemovedCallback(null);
+    if (this.runTimer) {
+      clearTimeout(this.runTimer);
+      this.runTimer = null;
+    }
+  }
+  
+  /**
+   * Record a play, attribute cache hits and schedule a new prediction
+   */
+  public async notePlayed(track: Track): Promise<void> {
+    try {
+      await this.load();
+      await playHistory.record(track);
+      
+      if (track.source === 'onedrive') {
+        metrics.increment('precache.plays');
+        if (this.precachedKeys.has(historyKeyOf(track))) {
+          metrics.increment('precache.hits');
+        }
+        metrics.setGauge('precache.hit_rate', metrics.ratio('precache.hits', 'precache.plays'));
+      }
+      
+      this.scheduleRun();
+    } catch (error) {
+      logger.error('Error recording play for precaching', error);
+    }
+  }
+  
+  /**
+   * Run a prediction and precache pass after a short delay
+   */
+  public scheduleRun(): void {
+    if (this.runTimer) return;
+    
+    this.runTimer = setTimeout(() => {
+      this.runTimer = null;
+      this.run();
+    }, RUN_DELAY_MS);
+  }
+  
+  /**
+   * Precache the top ranked tracks within the byte budget
+   */
+  public async run(): Promise<void> {
+    if (this.isRunning) return;
+    this.isRunning = true;
+    
+    try {
+      const provider = storageManager.getProvider('onedrive') as OneDriveStorageProvider | undefined;
+      if (!provider || !(await provider.isConnected())) {
+        return;
+      }
+      
+      const networkState = await NetInfo.fetch();
+      if (!this.isUnmetered(networkState)) {
+        logger.debug('Skipping precache, not on an unmetered network');
+        return;
+      }
+      if (!dataBudget.canPrefetch() || !dataBudget.shouldCacheDownloads()) {
+        logger.debug('Skipping precache, prefetching is off in the data settings');
+        return;
+      }
+      
+      // The OS may have cleared cached files since the last run
+      await this.prune(provider);
+      const events = await playHistory.getEvents();
+      const oneDriveTracks = catalog.tracks().filter(track => track.source === 'onedrive');
+      const candidates = rankCandidates(oneDriveTracks, events).slice(0, MAX_CANDIDATES_PER_RUN);
+      
+      let cacheSize = await provider.getCacheSize();
+      let precachedCount = 0;
+      
+      for (const { track } of candidates) {
+        if (cacheSize >= CACHE_BYTE_BUDGET) {
+          logger.debug('Precache byte budget reached');
+          break;
+        }
+        
+        // Conditions may change during a long run
+        const currentState = await NetInfo.fetch();
+        if (!this.isUnmetered(currentState)) {
+          break;
+        }
+        
+        try {
+          const bytes = await provider.precacheTrack(track);
+          if (bytes > 0) {
+            cacheSize += bytes;
+            precachedCount++;
+            this.precachedKeys.add(historyKeyOf(track));
+            metrics.increment('precache.downloads');
+            metrics.increment('precache.bytes', bytes);
+          }
+        } catch (error) {
+          logger.warn(`Failed to precache ${track.title}`, error);
+        }
+      }
+      
+      if (precachedCount > 0) {
+        await this.persist();
+        logger.info(`Precached ${precachedCount} predicted tracks`);
+      }
+    } catch (error) {
+      logger.error('Error running predictive precache', error);
+    } finally {
+      this.isRunning = false;
+    }
+  }
+  
+  /**
+   * Forget precached tracks whose files are gone, so playing them is not counted as a hit
+   */
+  private async prune(provider: OneDriveStorageProvider): Promise<void> {
+    await this.load();
+    
+    // Before the library loads every track would look removed
+    if (this.precachedKeys.size === 0 || catalog.size === 0) {
+      return;
+    }
+    
+    const tracksByKey = new Map<string, Track>();
+    for (const track of catalog.tracks()) {
+      if (track.source === 'onedrive') {
+        tracksByKey.set(historyKeyOf(track), track);
+      }
+    }
+    
+    let pruned = 0;
+    for (const key of Array.from(this.precachedKeys)) {
+      const track = tracksByKey.get(key);
+      if (!track || !(await provider.isTrackCached(track))) {
+        this.precachedKeys.delete(key);
+        pruned++;
+      }
+    }
+    
+    if (pruned > 0) {
+      await this.persist();
+      logger.debug(`Forgot ${pruned} precached tracks no longer in the cache`);
+    }
+  }
+  
+  /**
+   * Wi-Fi or ethernet that the OS does not flag as expensive
+   */
+  private isUnmetered(state: NetInfo.NetInfoState): boolean {
+    if (!state.isConnected) {
+      return false;
+    }
+    if (state.type !== NetInfo.NetInfoStateType.wifi && state.type !== NetInfo.NetInfoStateType.ethernet) {
+      return false;
+    }
+    return !state.details?.isConnectionExpensive;
+  }
+  
+  /**
+   * Load the set of tracks this precacher downloaded
+   */
+  private load(): Promise<void> {
+    if (!this.loadPromise) {
+      this.loadPromise = (async () => {
+        try {
+          const saved = await AsyncStorage.getItem(PRECACHED_KEYS_STORAGE_KEY);
+          if (saved) {
+            for (const key of JSON.parse(saved)) {
+              this.precachedKeys.add(key);
+            }
+          }
+        } catch (error) {
+          logger.error('Error loading precached tracks', error);
+        }
+      })();
+    }
+    return this.loadPromise;
+  }
+  
+  /**
+   * Save the set of precached tracks
+   */
+  private async persist(): Promise<void> {
+    try {
+      await AsyncStorage.setItem(PRECACHED_KEYS_STORAGE_KEY, JSON.stringify(Array.from(this.precachedKeys)));
+    } catch (error) {
+      logger.error('Error saving precached tracks', error);
+    }
+  }
+}
+
+// Export singleton instance
+export const predictivePrecacher = PredictivePrecacher.getInstance();
\ No newline at end of file
@@ -0,0 +1,287 @@
+/**
+ * Maintenance Scheduler
+ * Runs heavy housekeeping only in favorable conditions
+ *
+ * A maintenance window is open while the app is backgrounded or the user has
+ * been idle for a while, and the device is charging or has plenty of battery.
+ * A device whose battery can't be read counts as not charging and stays closed.
+ * Jobs that need the network also require an unmetered connection. Jobs run
+ * one bounded step at a time and persist a checkpoint after each step, so a
+ * window that closes mid-job resumes where it stopped.
+ */
+
+import { AppState, AppStateStatus } from 'react-native';
+import * as NetInfo from '@react-native-community/netinfo';
+import * as Battery from 'expo-battery';
+import { logger } from '../../utils/logger';
+import { userActivity } from './UserActivity';
+import { instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('maintenance');
+
+// Constants
+const MAINTENANCE_STATE_STORAGE_KEY = '@sonora/maintenance_state';
+const CHECK_INTERVAL_MS = 60 * 1000;
+const IDLE_THRESHOLD_MS = 2 * 60 * 1000;
+const MIN_BATTERY_LEVEL = 0.5; // when not charging
+
+export interface MaintenanceJob<C = any> {
+  id: string;
+  /** How long after a completed run the job is due again */
+  intervalMs: number;
+  /** Only run on unmetered networks */
+  requiresUnmeteredNetwork?: boolean;
+  /**
+   * Do one bounded unit of work
+   * @param checkpoint The checkpoint returned by the previous step, null to start a new run
+   * @returns The next checkpoint, or null when the run is complete
+   */
+  step: (checkpoint: C | null) => Promise<C | null>;
+}
+
+interface JobState {
+  checkpoint: unknown | null;
+  lastCompletedAt: number;
+}
+
+interface WindowConditions {
+  open: boolean;
+  unmetered: boolean;
+}
+
+class MaintenanceScheduler {
+  private static instance: MaintenanceScheduler;
+  private jobs: Map<string, MaintenanceJob> = new Map();
+  private jobStates: Record<string, JobState> = {};
+  private loadPromise: Promise<void> | null = null;
+  private checkTimer: NodeJS.Timeout | null = null;
+  private appStateSubscription: { remove: () => void } | null = null;
+  private unsubscribeActivity: (() => void) | null = null;
+  private appState: AppStateStatus = AppState.currentState;
+  private isDraining: boolean = false;
+  private interrupted: boolean = false;
+  
+  private constructor() {}
+  
+  public static getInstance(): MaintenanceScheduler {
+    if (!MaintenanceScheduler.instance) {
+      MaintenanceScheduler.instance = new MaintenanceScheduler();
+    }
+    return MaintenanceScheduler.instance;
+  }
+  
+  /**
+   * Register a maintenance job
+   */
+  public register(job: MaintenanceJob): void {
+    this.jobs.set(job.id, job);
+  }
+  
+  /**
+   * Start watching for maintenance windows
+   */
+  public start(): void {
+    if (this.checkTimer) return;
+    
+    this.checkTimer = setInterval(() => this.drain(), CHECK_INTERVAL_MS);
+    
+    this.appStateSubscription = AppState.addEventListener('change', state => {
+      this.appState = state;
+      if (state === 'background') {
+        this.drain();
+      } else {
+        // Returning to the foreground counts as an interaction
+        userActivity.markActive();
+      }
+    });
+    
+    // Any interaction closes the window immediately
+    this.unsubscribeActivity = userActivity.onActive(() => {
+      this.interrupted = true;
+    });
+  }
+  
+  /**
+   * Stop watching for maintenance windows
+   */
+  public stop(): void {
+    if (this.checkTimer) {
+      clearInterval(this.checkTimer);
+      this.checkTimer = null;
+    }
+    this.appStateSubscription?.remove();
+    this.appStateSubscription = null;
+    this.unsubscribeActivity?.();
+    this.unsubscribeActivity = null;
+    this.interrupted = true;
+  }
+  
+  /**
+   * Run due jobs step by step while the window stays open
+   */
+  public async drain(): Promise<void> {
+    if (this.isDraining) return;
+    this.isDraining = true;
+    this.interrupted = false;
+    
+    try {
+      await this.load();
+      
+      const conditions = await this.checkConditions();
+      if (!conditions.open) {
+        return;
+      }
+      
+      for (const job of Array.from(this.jobs.values())) {
+        if (!this.isDue(job)) continue;
+        if (job.requiresUnmeteredNetwork && !conditions.unmetered) continue;
+        
+        const completed = await this.runJob(job);
+        if (!completed) {
+          logger.debug(`Maintenance window closed during ${job.id}, will resume from checkpoint`);
+          return;
+        }
+      }
+    } catch (error) {
+      logger.error('Error running maintenance jobs', error);
+    } finally {
+      this.isDraining = false;
+    }
+  }
+  
+  /**
+   * Run a job from its checkpoint until it completes or the window closes
+   * @returns Whether the job completed
+   */
+  private async runJob(job: MaintenanceJob): Promise<boolean> {
+    const state = this.getJobState(job.id);
+    logger.debug(`Running maintenance job ${job.id}${state.checkpoint !== null ? ' from checkpoint' : ''}`);
+    
+    do {
+      if (!this.isWindowStillOpen()) {
+        return false;
+      }
+      
+      try {
+        state.checkpoint = await job.step(state.checkpoint);
+      } catch (error) {
+        // Start over next time rather than retrying a failing step forever
+        logger.error(`Maintenance job ${job.id} failed`, error);
+        state.checkpoint = null;
+        state.lastCompletedAt = Date.now();
+        await this.persist();
+        return true;
+      }
+      
+      await this.persist();
+      
+      // Let touches and rendering through between steps
+      await new Promise(resolve => setTimeout(resolve, 0));
+    } while (state.checkpoint !== null);
+    
+    state.lastCompletedAt = Date.now();
+    await this.persist();
+    logger.info(`Maintenance job ${job.id} completed`);
+    return true;
+  }
+  
+  /**
+   * Cheap check between steps, only interaction and app state can change quickly
+   */
+  private isWindowStillOpen(): boolean {
+    if (this.interrupted) {
+      return false;
+    }
+    return this.appState === 'background' || userActivity.getIdleMs() >= IDLE_THRESHOLD_MS;
+  }
+  
+  /**
+   * Check app state, idleness, power and network
+   */
+  private async checkConditions(): Promise<WindowConditions> {
+    const closed = { open: false, unmetered: false };
+    
+    if (!this.isWindowStillOpen()) {
+      return closed;
+    }
+    
+    try {
+      // Without a readable battery the device can't be known to be charging
+      if (!await Battery.isAvailableAsync()) {
+        return closed;
+      }
+      
+      const [batteryState, level, lowPower] = await Promise.all([
+        Battery.getBatteryStateAsync(),
+        Battery.getBatteryLevelAsync(),
+        Battery.isLowPowerModeEnabledAsync()
+      ]);
+      const charging = batteryState === Battery.BatteryState.CHARGING || batteryState === Battery.BatteryState.FULL;
+      if (lowPower || (!charging && level < MIN_BATTERY_LEVEL)) {
+        return closed;
+      }
+    } catch (error) {
+      logger.warn('Could not read battery state for maintenance', error);
+      return closed;
+    }
+    
+    const networkState = await NetInfo.fetch();
+    const unmetered = !!networkState.isConnected &&
+      (networkState.type === NetInfo.NetInfoStateType.wifi || networkState.type === NetInfo.NetInfoStateType.ethernet) &&
+      !networkState.details?.isConnectionExpensive;
+    
+    return { open: true, unmetered };
+  }
+  
+  /**
+   * A job is due when its interval has passed or a run was interrupted
+   */
+  private isDue(job: MaintenanceJob): boolean {
+    const state = this.getJobState(job.id);
+    return state.checkpoint !== null || Date.now() - state.lastCompletedAt >= job.intervalMs;
+  }
+  
+  /**
+   * Checkpoint and last completion of a job
+   */
+  private getJobState(id: string): JobState {
+    if (!this.jobStates[id]) {
+      this.jobStates[id] = { checkpoint: null, lastCompletedAt: 0 };
+    }
+    return this.jobStates[id];
+  }
+  
+  /**
+   * Load persisted checkpoints once
+   */
+  private load(): Promise<void> {
+    if (!this.loadPromise) {
+      this.loadPromise = (async () => {
+        try {
+          const saved = await AsyncStorage.getItem(MAINTENANCE_STATE_STORAGE_KEY);
+          if (saved) {
+            this.jobStates = JSON.parse(saved);
+          }
+        } catch (error) {
+          logger.error('Error loading maintenance state', error);
+        }
+      })();
+    }
+    return this.loadPromise;
+  }
+  
+  /**
+   * Save checkpoints so an interrupted run survives an app restart
+   */
+  private async persist(): Promise<void> {
+    try {
+      await AsyncStorage.setItem(MAINTENANCE_STATE_STORAGE_KEY, JSON.stringify(this.jobStates));
+    } catch (error) {
+      logger.error('Error saving maintenance state', error);
+    }
+  }
+}
+
+// Export singleton instance
+export const maintenanceScheduler = MaintenanceScheduler.getInstance();
\ No newline at end of file
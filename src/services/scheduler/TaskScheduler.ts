@@ -0,0 +1,263 @@
+/**
+ * Task Scheduler
+ * Cooperative, time-sliced executor for large jobs on the JS thread
+ *
+ * Jobs are generator functions that yield at safe points. The scheduler runs
+ * jobs in slices bounded by a frame budget and yields to the event loop between
+ * slices, so touch handling and rendering can run in the meantime.
+ */
+
+import { logger } from '../../utils/logger';
+import { tracing } from '../../utils/tracing';
+
+// Work per slice, leaves room for rendering inside a 16ms frame
+const DEFAULT_FRAME_BUDGET_MS = 8;
+
+// Steps longer than a frame are recorded as spans, so stalls can be attributed to them
+const TRACED_STEP_MS = 16;
+
+export enum TaskPriority {
+  USER_BLOCKING = 0, // results the user is waiting for (search as you type)
+  NORMAL = 1,
+  BACKGROUND = 2 // catalog loads, legacy blob parsing
+}
+
+export type TaskJob<T> = () => Generator<unknown, T, unknown>;
+
+export interface TaskOptions {
+  priority?: TaskPriority;
+  label?: string;
+}
+
+export interface TaskHandle<T> {
+  promise: Promise<T>;
+  cancel: () => void;
+}
+
+export class TaskCancelledError extends Error {
+  constructor(label: string) {
+    super(`Task cancelled: ${label}`);
+    this.name = 'TaskCancelledError';
+  }
+}
+
+interface ScheduledTask {
+  label: string;
+  priority: TaskPriority;
+  iterator: Generator<unknown, unknown, unknown> | null;
+  job: TaskJob<unknown>;
+  cancelled: boolean;
+  resolve: (value: any) => void;
+  reject: (error: any) => void;
+}
+
+class TaskScheduler {
+  private static instance: TaskScheduler;
+  private queues: ScheduledTask[][] = [[], [], []];
+  private frameBudgetMs: number = DEFAULT_FRAME_BUDGET_MS;
+  private pumpScheduled: boolean = false;
+  private runningTask: ScheduledTask | null = null; // the task whose step is executing
+  
+  private constructor() {}
+  
+  public static getInstance(): TaskScheduler {
+    if (!TaskScheduler.instance) {
+      TaskScheduler.instance = new TaskScheduler();
+    }
+    return TaskScheduler.instance;
+  }
+  
+  /**
+   * Set the maximum time a single slice may run
+   */
+  public setFrameBudget(ms: number): void {
+    this.frameBudgetMs = Math.max(1, ms);
+  }
+  
+  /**
+   * Schedule a job and get a handle that can cancel it
+   */
+  public schedule<T>(job: TaskJob<T>, options: TaskOptions = {}): TaskHandle<T> {
+    const priority = options.priority ?? TaskPriority.NORMAL;
+    let task!: ScheduledTask;
+    
+    const promise = new Promise<T>((resolve, reject) => {
+      task = {
+        label: options.label || 'anonymous',
+        priority,
+        iterator: null,
+        job,
+        cancelled: false,
+        resolve,
+        reject
+      };
+    });
+    
+    this.queues[priority].push(task);
+    this.schedulePump();
+    
+    return {
+      promise,
+      cancel: () => this.cancel(task)
+    };
+  }
+  
+  /**
+   * Schedule a job and wait for its result
+   */
+  public run<T>(job: TaskJob<T>, options: TaskOptions = {}): Promise<T> {
+    return this.schedule(job, options).promise;
+  }
+  
+  /**
+   * Number of jobs waiting or running
+   */
+  public getPendingCount(): number {
+    return this.queues.reduce((count, queue) => count + queue.length, 0);
+  }
+  
+  /**
+   * Cancel a task; it stops at its next yield point
+   */
+  private cancel(task: ScheduledTask): void {
+    if (task.cancelled) return;
+    
+    task.cancelled = true;
+    // A generator can't be returned while it runs, the pump finishes the task once the step yields
+    if (task === this.runningTask) return;
+    
+    if (this.removeTask(task)) {
+      this.finishCancelled(task);
+    }
+  }
+  
+  /**
+   * Remove a task from its queue, returns false if it already finished
+   */
+  private removeTask(task: ScheduledTask): boolean {
+    const queue = this.queues[task.priority];
+    const index = queue.indexOf(task);
+    if (index === -1) return false;
+    
+    queue.splice(index, 1);
+    return true;
+  }
+  
+  /**
+   * Reject a cancelled task and let its generator clean up
+   */
+  private finishCancelled(task: ScheduledTask): void {
+    try {
+      task.iterator?.return(undefined);
+    } catch (error) {
+      logger.warn(`Error cleaning up cancelled task: ${task.label}`, error);
+    }
+    task.reject(new TaskCancelledError(task.label));
+  }
+  
+  /**
+   * Queue the next slice behind pending events
+   */
+  private schedulePump(): void {
+    if (this.pumpScheduled) return;
+    this.pumpScheduled = true;
+    setTimeout(this.pump, 0);
+  }
+  
+  /**
+   * Pick the highest priority task
+   */
+  private nextTask(): ScheduledTask | undefined {
+    for (const queue of this.queues) {
+      if (queue.length > 0) {
+        return queue[0];
+      }
+    }
+    return undefined;
+  }
+  
+  /**
+   * Run tasks until the frame budget is used up
+   * The task is re-picked at every yield point, so higher priorities preempt
+   */
+  private pump = (): void => {
+    this.pumpScheduled = false;
+    const sliceStart = performance.now();
+    
+    let task = this.nextTask();
+    while (task && performance.now() - sliceStart < this.frameBudgetMs) {
+      try {
+        if (!task.iterator) {
+          task.iterator = task.job();
+        }
+        
+        const stepStart = performance.now();
+        this.runningTask = task;
+        let step: IteratorResult<unknown, unknown>;
+        try {
+          step = task.iterator.next();
+        } finally {
+          this.runningTask = null;
+        }
+        const stepEnd = performance.now();
+        if (stepEnd - stepStart >= TRACED_STEP_MS) {
+          tracing.recordSpan(`task:${task.label}`, stepStart, stepEnd);
+        }
+        
+        if (task.cancelled) {
+          // Cancelled from inside its own step
+          this.removeTask(task);
+          this.finishCancelled(task);
+        } else if (step.done) {
+          this.removeTask(task);
+          task.resolve(step.value);
+        }
+      } catch (error) {
+        this.removeTask(task);
+        task.reject(error);
+      }
+      
+      task = this.nextTask();
+    }
+    
+    const elapsed = performance.now() - sliceStart;
+    if (elapsed > this.frameBudgetMs * 4) {
+      logger.debug(`Task slice overran its budget: ${task?.label ?? 'done'} took ${elapsed.toFixed(1)}ms`);
+    }
+    
+    if (this.nextTask()) {
+      this.schedulePump();
+    }
+  };
+}
+
+/**
+ * Generator that filters items, yielding every chunkSize items
+ */
+export function* filterInSlices<T>(items: T[], predicate: (item: T) => boolean, chunkSize = 250): Generator<void, T[], unknown> {
+  const results: T[] = [];
+  for (let i = 0; i < items.length; i++) {
+    if (predicate(items[i])) {
+      results.push(items[i]);
+    }
+    if (i % chunkSize === chunkSize - 1) {
+      yield;
+    }
+  }
+  return results;
+}
+
+/**
+ * Generator that runs a callback for each item, yielding every chunkSize items
+ */
+export function* forEachInSlices<T>(items: T[], callback: (item: T, index: number) => void, chunkSize = 250): Generator<void, void, unknown> {
+  for (let i = 0; i < items.length; i++) {
+    callback(items[i], i);
+    if (i % chunkSize === chunkSize - 1) {
+      yield;
+    }
+  }
+}
+
+// Export singleton instance
+export const taskScheduler = TaskScheduler.getInstance();
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * User Activity
+ * Tracks when the user last interacted (touches, navigation, scrolling, starting playback) so
+ * deferrable work can stay out of the way
+ */
+
+export type ActivityListener = () => void;
+
+class UserActivity {
+  private static instance: UserActivity;
+  private lastActiveAt: number = Date.now();
+  private listeners: Set<ActivityListener> = new Set();
+  
+  private constructor() {}
+  
+  public static getInstance(): UserActivity {
+    if (!UserActivity.instance) {
+      UserActivity.instance = new UserActivity();
+    }
+    return UserActivity.instance;
+  }
+  
+  /**
+   * Note an interaction, called on touches, navigation, scroll handlers and playback actions
+   */
+  public markActive(): void {
+    this.lastActiveAt = Date.now();
+    for (const listener of Array.from(this.listeners)) {
+      listener();
+    }
+  }
+  
+  /**
+   * Milliseconds since the last interaction
+   */
+  public getIdleMs(): number {
+    return Date.now() - this.lastActiveAt;
+  }
+  
+  /**
+   * Subscribe to interactions
+   * Returns an unsubscribe function
+   */
+  public onActive(listener: ActivityListener): () => void {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+}
+
+// Export singleton instance
+export const userActivity = UserActivity.getInstance();
\ No newline at end of file
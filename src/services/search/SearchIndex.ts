@@ -0,0 +1,593 @@
+/**
+ * Search Index
+ * Inverted word-prefix index over the catalog's title, artist and album fields
+ *
+ * The index is persisted as a versioned binary snapshot and validated against
+ * the catalog fingerprint, so a cold start only re-tokenizes tracks whose
+ * searchable fields changed since the snapshot was written. While loaded it
+ * follows the catalog change feed.
+ */
+
+import { catalog, Catalog, CatalogChangeBatch } from '../catalog/Catalog';
+import { Track } from '../../types';
+import { logger } from '../../utils/logger';
+import { metrics } from '../../utils/metrics';
+import { instrumentFileSystem } from '../../utils/io';
+import { taskScheduler, TaskPriority } from '../scheduler/TaskScheduler';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('search-index');
+
+// Constants
+const SNAPSHOT_DIR = `${FileSystem.documentDirectory}search/`;
+const SNAPSHOT_FILE = 'index.bin';
+const SNAPSHOT_MAGIC = 0x53495831; // "SIX1"
+const SNAPSHOT_VERSION = 1;
+const HEADER_WORDS = 8;
+const SAVE_DEBOUNCE_MS = 10 * 1000;
+const RECONCILE_CHUNK_SIZE = 250;
+const COMPACT_MIN_DEAD_DOCS = 1000;
+const BASE64_CHUNK_BYTES = 3 * 0x2000; // whole base64 groups, so chunks encode and decode independently
+const BASE64_CHUNK_CHARS = BASE64_CHUNK_BYTES / 3 * 4;
+
+// Posting lists loaded from a snapshot stay typed array views until they are appended to
+type PostingList = number[] | Uint32Array;
+
+/**
+ * Split text into lowercase words for indexing and querying
+ */
+export const tokenize = (text: string | undefined): string[] => {
+  if (!text) return [];
+  
+  let normalized = text.toLowerCase();
+  if (typeof normalized.normalize === 'function') {
+    // Fold accents so "beyonce" finds "Beyoncé"
+    normalized = normalized.normalize('NFD').replace(/[\u0300-\u036f]/g, '');
+  }
+  return normalized.split(/[\s\-_.,;:!?'"()[\]{}&/\\|+*#@~`]+/).filter(word => word.length > 0);
+};
+
+export class SearchIndex {
+  private static instance: SearchIndex;
+  
+  // Documents are addressed by ordinal; removed documents leave a null slot
+  private docIds: (string | null)[] = [];
+  private docHashes: number[] = [];
+  private ordinalById = new Map<string, number>();
+  private postings = new Map<string, PostingList>();
+  private sortedTokens: string[] | null = null;
+  private deadDocs = 0;
+  private hashSum = 0;
+  
+  private readyPromise: Promise<void> | null = null;
+  private reconcilePromise: Promise<void> | null = null;
+  private unsubscribeCatalog: (() => void) | null = null;
+  private saveTimer: NodeJS.Timeout | null = null;
+  private snapshotPath: string;
+  
+  private constructor(private catalog: Catalog, private snapshotDir: string) {
+    this.snapshotPath = `${snapshotDir}${SNAPSHOT_FILE}`;
+  }
+  
+  public static getInstance(): SearchIndex {
+    if (!SearchIndex.instance) {
+      SearchIndex.instance = new SearchIndex(catalog, SNAPSHOT_DIR);
+    }
+    return SearchIndex.instance;
+  }
+  
+  /**
+   * Create an index over another catalog, persisted in its own directory
+   * Used by diagnostics harnesses so they never touch the app's snapshot
+   */
+  public static createIsolated(catalog: Catalog, snapshotDir: string): SearchIndex {
+    return new SearchIndex(catalog, snapshotDir);
+  }
+  
+  /**
+   * Start loading the snapshot ahead of the first query
+   */
+  public warmUp(): void {
+    this.ensureReady().catch(error => logger.warn('Search index warm-up failed', error));
+  }
+  
+  /**
+   * Find tracks where every query word prefixes a word of the title, artist or album
+   * Results are in library order
+   */
+  public async search(query: string): Promise<Track[]> {
+    const words = Array.from(new Set(tokenize(query)));
+    if (words.length === 0) return [];
+    
+    await this.ensureReady();
+    if (this.isStale()) {
+      await this.reconcile();
+    }
+    
+    const start = performance.now();
+    
+    // Intersect the per-word matches, smallest first
+    const matches = words.map(word => this.matchPrefix(word)).sort((a, b) => a.size - b.size);
+    let ordinals = Array.from(matches[0]);
+    for (let i = 1; i < matches.length && ordinals.length > 0; i++) {
+      ordinals = ordinals.filter(ordinal => matches[i].has(ordinal));
+    }
+    ordinals.sort((a, b) => a - b);
+    
+    const results: Track[] = [];
+    for (const ordinal of ordinals) {
+      const id = this.docIds[ordinal];
+      const track = id ? this.catalog.get(id) : undefined;
+      if (track) {
+        results.push(track);
+      }
+    }
+    
+    metrics.observe('search.index.query_ms', performance.now() - start);
+    return results;
+  }
+  
+  /**
+   * Write a pending snapshot now instead of after the debounce
+   */
+  public async flush(): Promise<void> {
+    if (!this.saveTimer) return;
+    
+    clearTimeout(this.saveTimer);
+    this.saveTimer = null;
+    await this.saveSnapshot();
+  }
+  
+  /**
+   * Stop following the catalog and drop any pending snapshot write
+   */
+  public dispose(): void {
+    if (this.saveTimer) {
+      clearTimeout(this.saveTimer);
+      this.saveTimer = null;
+    }
+    this.unsubscribeCatalog?.();
+    this.unsubscribeCatalog = null;
+  }
+  
+  /**
+   * Index statistics for diagnostics
+   */
+  public getStats(): { documents: number; deadDocuments: number; tokens: number; ready: boolean } {
+    return {
+      documents: this.ordinalById.size,
+      deadDocuments: this.deadDocs,
+      tokens: this.postings.size,
+      ready: this.readyPromise !== null && this.reconcilePromise === null
+    };
+  }
+  
+  /**
+   * Order-independent hash of the indexed documents, comparable to catalog.getFingerprint()
+   */
+  private getFingerprint(): number {
+    return (this.hashSum ^ this.ordinalById.size) >>> 0;
+  }
+  
+  /**
+   * Whether the indexed documents differ from the catalog
+   * An empty catalog means the library hasn't loaded yet, the snapshot is kept for it
+   */
+  private isStale(): boolean {
+    return this.catalog.size > 0 && this.getFingerprint() !== this.catalog.getFingerprint();
+  }
+  
+  /**
+   * Load the snapshot once, then follow catalog changes
+   */
+  private ensureReady(): Promise<void> {
+    if (!this.readyPromise) {
+      this.readyPromise = (async () => {
+        this.unsubscribeCatalog = this.catalog.subscribe(batch => this.applyChanges(batch));
+        
+        const start = performance.now();
+        await this.loadSnapshot();
+        metrics.observe('search.index.load_ms', performance.now() - start);
+        
+        if (this.isStale()) {
+          await this.reconcile();
+        } else {
+          metrics.increment('search.index.snapshot_hits');
+        }
+      })().catch(error => {
+        this.readyPromise = null;
+        this.unsubscribeCatalog?.();
+        this.unsubscribeCatalog = null;
+        throw error;
+      });
+    }
+    return this.readyPromise;
+  }
+  
+  /**
+   * Bring the index in line with the catalog, re-tokenizing only changed tracks
+   */
+  private reconcile(): Promise<void> {
+    if (!this.reconcilePromise) {
+      const start = performance.now();
+      this.reconcilePromise = taskScheduler.run(() => this.reconcileInSlices(), {
+        priority: TaskPriority.USER_BLOCKING,
+        label: 'search-index-reconcile'
+      }).then(updated => {
+        metrics.observe('search.index.reconcile_ms', performance.now() - start);
+        logger.debug(`Search index reconciled ${updated} documents`);
+        if (updated > 0) {
+          this.scheduleSave();
+        }
+      }).finally(() => {
+        this.reconcilePromise = null;
+      });
+    }
+    return this.reconcilePromise;
+  }
+  
+  private *reconcileInSlices(): Generator<void, number, unknown> {
+    let updated = 0;
+    
+    const tracks = this.catalog.tracks();
+    for (let i = 0; i < tracks.length; i++) {
+      if (this.indexTrack(tracks[i].id)) {
+        updated++;
+      }
+      if (i % RECONCILE_CHUNK_SIZE === RECONCILE_CHUNK_SIZE - 1) {
+        yield;
+      }
+    }
+    
+    for (let ordinal = 0; ordinal < this.docIds.length; ordinal++) {
+      const id = this.docIds[ordinal];
+      if (id !== null && this.catalog.keyOf(id) === undefined) {
+        this.removeDocument(id);
+        updated++;
+      }
+    }
+    
+    this.compactIfNeeded();
+    return updated;
+  }
+  
+  /**
+   * Incremental update from the catalog change feed
+   */
+  private applyChanges(batch: CatalogChangeBatch): void {
+    if (batch.reset) {
+      // Fell behind the feed, the fingerprint check finds what changed
+      this.reconcile().catch(error => logger.warn('Search index reconcile failed', error));
+      return;
+    }
+    
+    let updated = 0;
+    for (const change of batch.changes) {
+      if (change.type === 'delete') {
+        if (this.removeDocument(change.id)) {
+          updated++;
+        }
+      } else if (change.fields.some(field => field === 'title' || field === 'artist' || field === 'album')) {
+        if (this.indexTrack(change.id)) {
+          updated++;
+        }
+      }
+    }
+    
+    if (updated > 0) {
+      this.compactIfNeeded();
+      this.scheduleSave();
+    }
+  }
+  
+  /**
+   * (Re)index one catalog track if its searchable fields changed
+   * Returns whether the index was modified
+   */
+  private indexTrack(id: string): boolean {
+    const key = this.catalog.keyOf(id);
+    if (key === undefined) {
+      return this.removeDocument(id);
+    }
+    
+    const hash = this.catalog.getContentHash(key);
+    const existing = this.ordinalById.get(id);
+    if (existing !== undefined && this.docHashes[existing] === hash) {
+      return false;
+    }
+    
+    this.removeDocument(id);
+    
+    const ordinal = this.docIds.length;
+    this.docIds.push(id);
+    this.docHashes.push(hash);
+    this.ordinalById.set(id, ordinal);
+    this.hashSum = (this.hashSum + hash) >>> 0;
+    
+    const words = new Set([
+      ...tokenize(this.catalog.getTitle(key)),
+      ...tokenize(this.catalog.getArtist(key)),
+      ...tokenize(this.catalog.getAlbum(key))
+    ]);
+    words.forEach(word => {
+      let list = this.postings.get(word);
+      if (!list) {
+        list = [];
+        this.postings.set(word, list);
+        this.sortedTokens = null;
+      } else if (!Array.isArray(list)) {
+        list = Array.from(list);
+        this.postings.set(word, list);
+      }
+      (list as number[]).push(ordinal);
+    });
+    return true;
+  }
+  
+  /**
+   * Tombstone a document, its postings are dropped on the next compaction
+   */
+  private removeDocument(id: string): boolean {
+    const ordinal = this.ordinalById.get(id);
+    if (ordinal === undefined) return false;
+    
+    this.ordinalById.delete(id);
+    this.docIds[ordinal] = null;
+    this.hashSum = (this.hashSum - this.docHashes[ordinal]) >>> 0;
+    this.deadDocs++;
+    return true;
+  }
+  
+  /**
+   * Drop tombstoned ordinals from the posting lists once they are a sizeable share
+   */
+  private compactIfNeeded(): void {
+    if (this.deadDocs < COMPACT_MIN_DEAD_DOCS || this.deadDocs * 4 < this.docIds.length) return;
+    
+    this.postings.forEach((list, word) => {
+      const live = Array.from(list).filter(ordinal => this.docIds[ordinal] !== null);
+      if (live.length === 0) {
+        this.postings.delete(word);
+        this.sortedTokens = null;
+      } else {
+        this.postings.set(word, live);
+      }
+    });
+    this.deadDocs = 0;
+  }
+  
+  /**
+   * Live ordinals of every token starting with the prefix
+   */
+  private matchPrefix(prefix: string): Set<number> {
+    if (!this.sortedTokens) {
+      this.sortedTokens = Array.from(this.postings.keys()).sort();
+    }
+    const tokens = this.sortedTokens;
+    
+    // Binary search for the first token >= prefix
+    let low = 0;
+    let high = tokens.length;
+    while (low < high) {
+      const mid = (low + high) >>> 1;
+      if (tokens[mid] < prefix) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    
+    const result = new Set<number>();
+    for (let i = low; i < tokens.length && tokens[i].startsWith(prefix); i++) {
+      const list = this.postings.get(tokens[i]);
+      if (!list) continue;
+      for (let j = 0; j < list.length; j++) {
+        if (this.docIds[list[j]] !== null) {
+          result.add(list[j]);
+        }
+      }
+    }
+    return result;
+  }
+  
+  /**
+   * Write the snapshot a while after the last change
+   */
+  private scheduleSave(): void {
+    if (this.saveTimer) {
+      clearTimeout(this.saveTimer);
+    }
+    this.saveTimer = setTimeout(() => {
+      this.saveTimer = null;
+      this.saveSnapshot().catch(error => logger.warn('Failed to save search index snapshot', error));
+    }, SAVE_DEBOUNCE_MS);
+  }
+  
+  /**
+   * Snapshot layout, little endian:
+   *   u32[8]      magic, version, fingerprint, docCount, tokenCount, postingCount, stringUnits, reserved
+   *   u32[doc]    content hash per document
+   *   u32[tok+1]  posting offsets per token
+   *   u32[post]   document ordinals
+   *   u16[units]  document IDs then tokens, each terminated by U+0000
+   * Documents are renumbered densely, so tombstones are never written
+   */
+  private async saveSnapshot(): Promise<void> {
+    const start = performance.now();
+    const base64 = await taskScheduler.run(() => this.encodeSnapshotInSlices(), {
+      priority: TaskPriority.BACKGROUND,
+      label: 'search-index-save'
+    });
+    
+    const dirInfo = await FileSystem.getInfoAsync(this.snapshotDir);
+    if (!dirInfo.exists) {
+      await FileSystem.makeDirectoryAsync(this.snapshotDir, { intermediates: true });
+    }
+    
+    // Write next to the snapshot and swap, so a crash never leaves a torn file
+    await FileSystem.writeAsStringAsync(`${this.snapshotPath}.tmp`, base64, { encoding: FileSystem.EncodingType.Base64 });
+    await FileSystem.moveAsync({ from: `${this.snapshotPath}.tmp`, to: this.snapshotPath });
+    
+    metrics.observe('search.index.save_ms', performance.now() - start);
+    logger.debug(`Saved search index snapshot with ${this.ordinalById.size} documents`);
+  }
+  
+  private *encodeSnapshotInSlices(): Generator<void, string, unknown> {
+    // Dense renumbering of live documents
+    const renumber = new Map<number, number>();
+    const ids: string[] = [];
+    const hashes: number[] = [];
+    this.docIds.forEach((id, ordinal) => {
+      if (id !== null) {
+        renumber.set(ordinal, ids.length);
+        ids.push(id);
+        hashes.push(this.docHashes[ordinal]);
+      }
+    });
+    yield;
+    
+    const tokens: string[] = [];
+    const offsets: number[] = [0];
+    const ordinals: number[] = [];
+    let visited = 0;
+    for (const [word, list] of Array.from(this.postings.entries())) {
+      const before = ordinals.length;
+      for (let i = 0; i < list.length; i++) {
+        const dense = renumber.get(list[i]);
+        if (dense !== undefined) {
+          ordinals.push(dense);
+        }
+      }
+      if (ordinals.length > before) {
+        tokens.push(word);
+        offsets.push(ordinals.length);
+      }
+      if (++visited % RECONCILE_CHUNK_SIZE === 0) {
+        yield;
+      }
+    }
+    
+    const strings = `${ids.join('\u0000')}\u0000${tokens.join('\u0000')}\u0000`;
+    const header = [SNAPSHOT_MAGIC, SNAPSHOT_VERSION, this.getFingerprint(), ids.length, tokens.length, ordinals.length, strings.length, 0];
+    const words = HEADER_WORDS + ids.length + offsets.length + ordinals.length;
+    
+    const buffer = new ArrayBuffer(words * 4 + strings.length * 2);
+    const u32 = new Uint32Array(buffer, 0, words);
+    u32.set(header, 0);
+    u32.set(hashes, HEADER_WORDS);
+    u32.set(offsets, HEADER_WORDS + ids.length);
+    u32.set(ordinals, HEADER_WORDS + ids.length + offsets.length);
+    
+    const u16 = new Uint16Array(buffer, words * 4, strings.length);
+    for (let i = 0; i < strings.length; i++) {
+      u16[i] = strings.charCodeAt(i);
+      if ((i + 1) % BASE64_CHUNK_BYTES === 0) {
+        yield;
+      }
+    }
+    yield;
+    
+    // base64 one chunk at a time, only the last chunk can carry padding
+    const bytes = new Uint8Array(buffer);
+    const chunks: string[] = [];
+    for (let i = 0; i < bytes.length; i += BASE64_CHUNK_BYTES) {
+      chunks.push(btoa(String.fromCharCode.apply(null, Array.from(bytes.subarray(i, i + BASE64_CHUNK_BYTES)))));
+      yield;
+    }
+    return chunks.join('');
+  }
+  
+  /**
+   * Load the snapshot if it exists and matches this format version
+   */
+  private async loadSnapshot(): Promise<void> {
+    const info = await FileSystem.getInfoAsync(this.snapshotPath);
+    if (!info.exists) return;
+    
+    try {
+      const base64 = await FileSystem.readAsStringAsync(this.snapshotPath, { encoding: FileSystem.EncodingType.Base64 });
+      await taskScheduler.run(() => this.decodeSnapshotInSlices(base64), {
+        priority: TaskPriority.USER_BLOCKING,
+        label: 'search-index-load'
+      });
+      logger.debug(`Loaded search index snapshot with ${this.ordinalById.size} documents`);
+    } catch (error) {
+      // A bad snapshot only costs a rebuild
+      logger.warn('Discarding unreadable search index snapshot', error);
+      this.resetIndex();
+      await FileSystem.deleteAsync(this.snapshotPath, { idempotent: true });
+    }
+  }
+  
+  private *decodeSnapshotInSlices(base64: string): Generator<void, void, unknown> {
+    if (base64.length % 4 !== 0) {
+      throw new Error('Corrupt search index snapshot encoding');
+    }
+    
+    // Decode one chunk of whole base64 groups at a time
+    const padding = base64.endsWith('==') ? 2 : base64.endsWith('=') ? 1 : 0;
+    const buffer = new ArrayBuffer(base64.length / 4 * 3 - padding);
+    const bytes = new Uint8Array(buffer);
+    let offset = 0;
+    for (let i = 0; i < base64.length; i += BASE64_CHUNK_CHARS) {
+      const binary = atob(base64.slice(i, i + BASE64_CHUNK_CHARS));
+      for (let j = 0; j < binary.length; j++) {
+        bytes[offset++] = binary.charCodeAt(j);
+      }
+      yield;
+    }
+    
+    const header = new Uint32Array(buffer, 0, HEADER_WORDS);
+    if (header[0] !== SNAPSHOT_MAGIC || header[1] !== SNAPSHOT_VERSION) {
+      throw new Error(`Unsupported search index snapshot version ${header[1]}`);
+    }
+    const [, , , docCount, tokenCount, postingCount, stringUnits] = Array.from(header);
+    
+    const words = HEADER_WORDS + docCount + tokenCount + 1 + postingCount;
+    const u32 = new Uint32Array(buffer, 0, words);
+    const hashes = u32.subarray(HEADER_WORDS, HEADER_WORDS + docCount);
+    const offsets = u32.subarray(HEADER_WORDS + docCount, HEADER_WORDS + docCount + tokenCount + 1);
+    const ordinals = u32.subarray(HEADER_WORDS + docCount + tokenCount + 1, words);
+    const u16 = new Uint16Array(buffer, words * 4, stringUnits);
+    
+    // Split the string table
+    const strings: string[] = [];
+    let from = 0;
+    for (let i = 0; i < u16.length; i++) {
+      if (u16[i] === 0) {
+        strings.push(String.fromCharCode.apply(null, Array.from(u16.subarray(from, i))));
+        from = i + 1;
+        if (strings.length % RECONCILE_CHUNK_SIZE === 0) {
+          yield;
+        }
+      }
+    }
+    if (strings.length !== docCount + tokenCount) {
+      throw new Error('Corrupt search index snapshot string table');
+    }
+    
+    this.resetIndex();
+    for (let ordinal = 0; ordinal < docCount; ordinal++) {
+      this.docIds.push(strings[ordinal]);
+      this.docHashes.push(hashes[ordinal]);
+      this.ordinalById.set(strings[ordinal], ordinal);
+      this.hashSum = (this.hashSum + hashes[ordinal]) >>> 0;
+    }
+    for (let t = 0; t < tokenCount; t++) {
+      this.postings.set(strings[docCount + t], ordinals.subarray(offsets[t], offsets[t + 1]));
+    }
+  }
+  
+  private resetIndex(): void {
+    this.docIds = [];
+    this.docHashes = [];
+    this.ordinalById.clear();
+    this.postings.clear();
+    this.sortedTokens = null;
+    this.deadDocs = 0;
+    this.hashSum = 0;
+  }
+}
+
+// Export singleton instance
+export const searchIndex = SearchIndex.getInstance();
\ No newline at end of file
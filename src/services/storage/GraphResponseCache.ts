@@ -0,0 +1,237 @@
+/**
+ * Graph Response Cache
+ * Persisted ETag cache for idempotent Microsoft Graph GET requests
+ *
+ * Bodies are stored with the ETag they were served with, so a repeat request
+ * can be sent with If-None-Match and a 304 answered from the stored body.
+ * Each body lives under its own storage key and is read on first use; only a
+ * small index of ETags is rewritten as the cache changes.
+ */
+
+import { logger } from '../../utils/logger';
+import { instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('graph-cache');
+
+// Constants
+const GRAPH_CACHE_STORAGE_KEY = '@sonora/graph_response_cache'; // single blob from before per-URL bodies
+const GRAPH_CACHE_INDEX_KEY = '@sonora/graph_response_index';
+const GRAPH_CACHE_BODY_PREFIX = '@sonora/graph_response_body/';
+const MAX_ENTRIES = 500;
+const MAX_BODY_LENGTH = 64 * 1024; // larger bodies are not worth persisting
+const MAX_TOTAL_BODY_LENGTH = 1024 * 1024; // all bodies together, well below what one storage read can return
+const PERSIST_DELAY_MS = 2000;
+
+export interface CachedGraphResponse {
+  etag: string;
+  body: string;
+  storedAt: number; // when the body was fetched
+  lastUsed: number;
+}
+
+// What the index keeps for a URL, the body is stored under its own key
+interface GraphCacheIndexEntry {
+  etag: string;
+  length: number;
+  storedAt: number;
+  lastUsed: number;
+}
+
+class GraphResponseCache {
+  private static instance: GraphResponseCache;
+  private index: Map<string, GraphCacheIndexEntry> = new Map();
+  private bodies: Map<string, string> = new Map(); // bodies read or stored this session
+  private totalLength = 0;
+  private dirtyBodies: Set<string> = new Set();
+  private removedBodies: Set<string> = new Set();
+  private loadPromise: Promise<void> | null = null;
+  private persistTimer: NodeJS.Timeout | null = null;
+  
+  private constructor() {}
+  
+  public static getInstance(): GraphResponseCache {
+    if (!GraphResponseCache.instance) {
+      GraphResponseCache.instance = new GraphResponseCache();
+    }
+    return GraphResponseCache.instance;
+  }
+  
+  /**
+   * Get the cached response for a URL
+   */
+  public async get(url: string): Promise<CachedGraphResponse | null> {
+    await this.load();
+    const entry = this.index.get(url);
+    if (!entry) return null;
+    
+    let body = this.bodies.get(url);
+    if (body === undefined) {
+      let saved: string | null = null;
+      try {
+        saved = await AsyncStorage.getItem(`${GRAPH_CACHE_BODY_PREFIX}${url}`);
+      } catch (error) {
+        logger.error('Error loading cached Graph response', error);
+      }
+      
+      // Replaced or dropped while the body was being read
+      if (this.index.get(url) !== entry) return this.get(url);
+      
+      // A body lost to an interrupted write can't answer a 304
+      if (saved === null) {
+        this.remove(url);
+        this.schedulePersist();
+        return null;
+      }
+      body = saved;
+      this.bodies.set(url, body);
+    }
+    
+    return { etag: entry.etag, body, storedAt: entry.storedAt, lastUsed: entry.lastUsed };
+  }
+  
+  /**
+   * Store a response body with its ETag
+   */
+  public set(url: string, etag: string, body: string): void {
+    this.remove(url);
+    
+    if (body.length <= MAX_BODY_LENGTH) {
+      const now = Date.now();
+      this.index.set(url, { etag, length: body.length, storedAt: now, lastUsed: now });
+      this.bodies.set(url, body);
+      this.totalLength += body.length;
+      this.dirtyBodies.add(url);
+      this.removedBodies.delete(url);
+      this.evict();
+    }
+    this.schedulePersist();
+  }
+  
+  /**
+   * Mark a cached response as revalidated
+   */
+  public touch(url: string): void {
+    const entry = this.index.get(url);
+    if (!entry) return;
+    
+    entry.lastUsed = Date.now();
+    this.schedulePersist();
+  }
+  
+  /**
+   * Drop all cached responses, e.g. when the account is disconnected
+   */
+  public async clear(): Promise<void> {
+    await this.load();
+    
+    const urls = new Set([...this.index.keys(), ...this.removedBodies]);
+    this.index.clear();
+    this.bodies.clear();
+    this.totalLength = 0;
+    this.dirtyBodies.clear();
+    this.removedBodies.clear();
+    if (this.persistTimer) {
+      clearTimeout(this.persistTimer);
+      this.persistTimer = null;
+    }
+    
+    await AsyncStorage.removeItem(GRAPH_CACHE_INDEX_KEY);
+    for (const url of urls) {
+      await AsyncStorage.removeItem(`${GRAPH_CACHE_BODY_PREFIX}${url}`);
+    }
+  }
+  
+  /**
+   * Load the persisted index once, bodies are read when first requested
+   */
+  private load(): Promise<void> {
+    if (!this.loadPromise) {
+      this.loadPromise = (async () => {
+        try {
+          // The old single blob could grow past what one read returns, drop it unread
+          await AsyncStorage.removeItem(GRAPH_CACHE_STORAGE_KEY);
+          
+          const saved = await AsyncStorage.getItem(GRAPH_CACHE_INDEX_KEY);
+          if (saved) {
+            const entries: [string, GraphCacheIndexEntry][] = JSON.parse(saved);
+            // Keep entries set while loading, they are newer
+            for (const [url, entry] of entries) {
+              if (!this.index.has(url) && !this.removedBodies.has(url)) {
+                this.index.set(url, entry);
+                this.totalLength += entry.length;
+              }
+            }
+            this.evict();
+            logger.debug(`Loaded ${entries.length} cached Graph responses`);
+          }
+        } catch (error) {
+          logger.error('Error loading Graph response cache', error);
+        }
+      })();
+    }
+    return this.loadPromise;
+  }
+  
+  /**
+   * Forget a URL's entry and queue its body for removal
+   */
+  private remove(url: string): void {
+    const entry = this.index.get(url);
+    if (!entry) return;
+    
+    this.index.delete(url);
+    this.bodies.delete(url);
+    this.totalLength -= entry.length;
+    this.dirtyBodies.delete(url);
+    this.removedBodies.add(url);
+  }
+  
+  /**
+   * Evict least recently used entries over the entry or size limit
+   */
+  private evict(): void {
+    if (this.index.size <= MAX_ENTRIES && this.totalLength <= MAX_TOTAL_BODY_LENGTH) return;
+    
+    const byUse = Array.from(this.index.entries()).sort((a, b) => a[1].lastUsed - b[1].lastUsed);
+    for (const [url] of byUse) {
+      if (this.index.size <= MAX_ENTRIES && this.totalLength <= MAX_TOTAL_BODY_LENGTH) break;
+      this.remove(url);
+    }
+  }
+  
+  /**
+   * Persist after a short delay so a rescan writes once
+   * Only bodies that changed are written, the index itself stays small
+   */
+  private schedulePersist(): void {
+    if (this.persistTimer) return;
+    
+    this.persistTimer = setTimeout(async () => {
+      this.persistTimer = null;
+      const written = Array.from(this.dirtyBodies);
+      const removed = Array.from(this.removedBodies);
+      this.dirtyBodies.clear();
+      this.removedBodies.clear();
+      
+      try {
+        for (const url of written) {
+          const body = this.bodies.get(url);
+          if (body !== undefined) {
+            await AsyncStorage.setItem(`${GRAPH_CACHE_BODY_PREFIX}${url}`, body);
+          }
+        }
+        for (const url of removed) {
+          await AsyncStorage.removeItem(`${GRAPH_CACHE_BODY_PREFIX}${url}`);
+        }
+        // Written last, so a listed entry's body is already stored
+        await AsyncStorage.setItem(GRAPH_CACHE_INDEX_KEY, JSON.stringify(Array.from(this.index.entries())));
+      } catch (error) {
+        logger.error('Error saving Graph response cache', error);
+      }
+    }, PERSIST_DELAY_MS);
+  }
+}
+
+// Export singleton instance
+export const graphResponseCache = GraphResponseCache.getInstance();
\ No newline at end of file
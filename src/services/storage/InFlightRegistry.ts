@@ -0,0 +1,146 @@
+/**
+ * In-Flight Registry
+ * Single-flight execution of expensive per-resource work such as downloads
+ *
+ * Concurrent requests for the same key share one promise. Background work is
+ * queued by priority under a concurrency limit, interactive work starts
+ * immediately, and a queued request is promoted when a higher priority caller
+ * joins it (e.g. the user plays a track that is still waiting to prefetch).
+ */
+
+import { logger } from '../../utils/logger';
+
+// Background transfers running at the same time, interactive ones are not limited
+const MAX_CONCURRENT_BACKGROUND = 2;
+
+export enum RequestPriority {
+  PREFETCH = 0,
+  BACKGROUND = 1,
+  INTERACTIVE = 2
+}
+
+interface InFlightEntry {
+  key: string;
+  priority: RequestPriority;
+  promise: Promise<any>;
+  started: boolean;
+  counted: boolean; // occupies a background slot
+  start: () => void;
+}
+
+class InFlightRegistry {
+  private static instance: InFlightRegistry;
+  private entries = new Map<string, InFlightEntry>();
+  private waiting: InFlightEntry[] = [];
+  private runningBackground: number = 0;
+  
+  private constructor() {}
+  
+  public static getInstance(): InFlightRegistry {
+    if (!InFlightRegistry.instance) {
+      InFlightRegistry.instance = new InFlightRegistry();
+    }
+    return InFlightRegistry.instance;
+  }
+  
+  /**
+   * Run a task for a key, or join the task already in flight for it
+   */
+  public run<T>(key: string, priority: RequestPriority, task: () => Promise<T>): Promise<T> {
+    const existing = this.entries.get(key);
+    if (existing) {
+      if (priority > existing.priority) {
+        this.promote(existing, priority);
+      }
+      logger.debug(`Joined in-flight request: ${key}`);
+      return existing.promise;
+    }
+    
+    let resolve!: (value: T) => void;
+    let reject!: (error: any) => void;
+    const promise = new Promise<T>((res, rej) => {
+      resolve = res;
+      reject = rej;
+    });
+    
+    const entry: InFlightEntry = {
+      key,
+      priority,
+      promise,
+      started: false,
+      counted: false,
+      start: () => {
+        entry.started = true;
+        entry.counted = entry.priority !== RequestPriority.INTERACTIVE;
+        if (entry.counted) {
+          this.runningBackground++;
+        }
+        
+        task()
+          .then(resolve, reject)
+          .finally(() => {
+            this.entries.delete(key);
+            if (entry.counted) {
+              this.runningBackground--;
+            }
+            this.drain();
+          });
+      }
+    };
+    
+    this.entries.set(key, entry);
+    
+    if (priority === RequestPriority.INTERACTIVE) {
+      entry.start();
+    } else {
+      this.waiting.push(entry);
+      this.drain();
+    }
+    
+    return promise;
+  }
+  
+  /**
+   * Check whether work for a key is queued or running
+   */
+  public isInFlight(key: string): boolean {
+    return this.entries.has(key);
+  }
+  
+  /**
+   * Raise the priority of an entry, starting it right away if it becomes interactive
+   */
+  private promote(entry: InFlightEntry, priority: RequestPriority): void {
+    logger.debug(`Promoting in-flight request ${entry.key} to priority ${priority}`);
+    entry.priority = priority;
+    
+    if (entry.started) {
+      return;
+    }
+    
+    if (priority === RequestPriority.INTERACTIVE) {
+      this.waiting = this.waiting.filter(waiting => waiting !== entry);
+      entry.start();
+    } else {
+      this.drain();
+    }
+  }
+  
+  /**
+   * Start queued entries in priority order while slots are free
+   */
+  private drain(): void {
+    if (this.waiting.length === 0) return;
+    
+    // Stable sort keeps FIFO order within a priority
+    this.waiting.sort((a, b) => b.priority - a.priority);
+    
+    while (this.runningBackground < MAX_CONCURRENT_BACKGROUND && this.waiting.length > 0) {
+      const entry = this.waiting.shift()!;
+      entry.start();
+    }
+  }
+}
+
+// Export singleton instance
+export const inFlightRegistry = InFlightRegistry.getInstance();
\ No newline at end of file
@@ -3,7 +3,6 @@
  * Handles access to music files stored on the device's local file system
  */
 
-import * as FileSystem from 'expo-file-system';
 import * as DocumentPicker from 'expo-document-picker';
 import { Audio } from 'expo-av';
 import { Platform } from 'react-native';
@@ -11,31 +10,66 @@ import uuid from 'react-native-uuid';
 import MusicInfo from 'expo-music-info-2';
 
 import { BaseStorageProvider } from './StorageProvider';
-import { Track } from '../../types';
+import { ShardedDirectory } from './ShardedDirectory';
+import { Track, ConnectionState } from '../../types';
 import { logger } from '../../utils/logger';
-import AsyncStorage from '@react-native-async-storage/async-storage';
+import { parseJsonArrayInSlices } from '../../utils/jsonChunks';
+import { taskScheduler, TaskPriority } from '../scheduler/TaskScheduler';
+import { maintenanceScheduler } from '../scheduler/MaintenanceScheduler';
+import { instrumentFileSystem, instrumentAsyncStorage, ioAccounting } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('local');
+const AsyncStorage = instrumentAsyncStorage('local');
 
 // Constants
 const LOCAL_TRACKS_STORAGE_KEY = '@sonora/local_tracks';
+const LOCAL_FOLDER_ROOT_STORAGE_KEY = '@sonora/local_folder_root';
 const SUPPORTED_AUDIO_EXTENSIONS = ['.mp3', '.m4a', '.aac', '.wav', '.ogg', '.flac'];
+const FOLDER_SCAN_CONCURRENCY = 4;
+const FOLDER_IMPORT_BATCH_SIZE = 25;
+const CONTENT_URI_PREFIX = 'content://';
+const AUDIO_DOCUMENT_DIR = `${FileSystem.documentDirectory}audio/`;
+const LAYOUT_MIGRATION_INTERVAL_MS = 24 * 60 * 60 * 1000;
+
+export type ImportBatchListener = (tracks: Track[]) => void;
+
+export interface FolderRescanResult {
+  added: Track[];
+  removedIds: string[];
+}
+
+interface FolderEntry {
+  uri: string;
+  isDirectory?: boolean; // unknown until probed
+  name?: string;
+}
 
 export class LocalStorageProvider extends BaseStorageProvider {
   private tracks: Map<string, Track>;
-  private initialized: boolean = false;
+  // Imported copies, sharded by file name
+  private audioLayout = new ShardedDirectory(AUDIO_DOCUMENT_DIR, {
+    onMoved: (fileName, path) => this.relocateTrackFile(fileName, path)
+  });
+  private hasRelocatedTracks: boolean = false;
   
   constructor() {
     super('Local Storage', 'local');
     this.tracks = new Map<string, Track>();
-  }
-  
-  /**
-   * Check if local storage is available and initialized
-   */
-  async isConnected(): Promise<boolean> {
-    if (!this.initialized) {
-      await this.initialize();
-    }
-    return this.initialized;
+    
+    // Move copies imported before the directory was sharded into their shards
+    maintenanceScheduler.register({
+      id: 'local-audio-layout',
+      intervalMs: LAYOUT_MIGRATION_INTERVAL_MS,
+      step: async () => {
+        const remaining = await this.audioLayout.migrateStep();
+        if (this.hasRelocatedTracks) {
+          this.hasRelocatedTracks = false;
+          await this.saveTracks();
+        }
+        return remaining || null;
+      }
+    });
   }
   
   /**
@@ -43,7 +77,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
    */
   async connect(): Promise<boolean> {
     try {
-      await this.initialize();
+      await this.ensureInitialized();
       return true;
     } catch (error) {
       logger.error('Failed to connect to local storage', error);
@@ -56,15 +90,16 @@ export class LocalStorageProvider extends BaseStorageProvider {
    */
   async disconnect(): Promise<void> {
     this.tracks.clear();
-    this.initialized = false;
+    this.resetInitialization();
+    this.setConnectionState(ConnectionState.DISCONNECTED);
   }
   
   /**
    * List all audio files in local storage
    */
   async listAudioFiles(): Promise<Track[]> {
-    if (!this.initialized) {
-      await this.initialize();
+    if (this.connectionState !== ConnectionState.CONNECTED) {
+      await this.ensureInitialized();
     }
     return Array.from(this.tracks.values());
   }
@@ -73,8 +108,8 @@ export class LocalStorageProvider extends BaseStorageProvider {
    * Get a specific audio file by ID
    */
   async getAudioFile(id: string): Promise<Track | null> {
-    if (!this.initialized) {
-      await this.initialize();
+    if (this.connectionState !== ConnectionState.CONNECTED) {
+      await this.ensureInitialized();
     }
     return this.tracks.get(id) || null;
   }
@@ -90,7 +125,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
     try {
       // On Android, we need to handle both file:// and non-file:// URIs
       let normalizedUri = track.uri;
-      if (Platform.OS === 'android' && !normalizedUri.startsWith('file://')) {
+      if (Platform.OS === 'android' && !normalizedUri.startsWith('file://') && !normalizedUri.startsWith(CONTENT_URI_PREFIX)) {
         normalizedUri = `file://${normalizedUri}`;
       }
       
@@ -119,8 +154,8 @@ export class LocalStorageProvider extends BaseStorageProvider {
       const fileName = uriParts[uriParts.length - 1];
       
       // Check if file exists in current document directory (new location)
-      const audioDocDir = `${FileSystem.documentDirectory}audio/`;
-      const docPath = `${audioDocDir}${fileName}`;
+      await this.audioLayout.adopt(fileName);
+      const docPath = this.audioLayout.pathFor(fileName);
       const docFileInfo = await FileSystem.getInfoAsync(docPath);
       
       if (docFileInfo.exists) {
@@ -198,7 +233,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
         // Copy file to document directory to ensure it's readable
         const cachePath = await this.copyFileToDocumentDirectory(file.uri, file.name);
         
-        // Extract metadata from the audio file including artwork
+        // Extract metadata from the audio file, artwork is read when the track is shown
         let metadata = null;
         try {
           metadata = await MusicInfo.getMusicInfoAsync(cachePath, {
@@ -206,7 +241,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
             artist: true,
             album: true,
             genre: true,
-            picture: true
+            picture: false
           });
           logger.debug(`Extracted metadata for ${file.name}:`, metadata);
         } catch (error) {
@@ -232,8 +267,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
           uri: cachePath,
           source: 'local',
           path: cachePath,
-          duration: await this.getAudioDuration(cachePath),
-          artwork: metadata?.picture?.pictureData || undefined
+          duration: await this.getAudioDuration(cachePath)
         };
         
         // Add to tracks map
@@ -254,113 +288,294 @@ export class LocalStorageProvider extends BaseStorageProvider {
   
   /**
    * Import audio files from a folder in the device
+   * On Android the user grants access to a directory tree once and it is scanned
+   * recursively, elsewhere this falls back to picking multiple files
    */
-  async importAudioFilesFromFolder(): Promise<Track[]> {
+  async importAudioFilesFromFolder(onBatch?: ImportBatchListener): Promise<Track[]> {
     try {
       logger.info('Importing audio files from folder');
       
-      // Use document picker to select multiple files
-      const result = await DocumentPicker.getDocumentAsync({
-        type: '*/*', // Allow all file types, we'll filter them after
-        copyToCacheDirectory: false, // We'll handle caching ourselves
-        multiple: true // Allow multiple selection
-      });
+      if (Platform.OS !== 'android') {
+        return await this.importPickedFiles(onBatch);
+      }
       
-      if (result.canceled) {
+      const permission = await FileSystem.StorageAccessFramework.requestDirectoryPermissionsAsync();
+      if (!permission.granted) {
         logger.info('User canceled folder selection');
         return [];
       }
       
-      const newTracks: Track[] = [];
+      // Remember the granted tree so it can be rescanned without asking again
+      await AsyncStorage.setItem(LOCAL_FOLDER_ROOT_STORAGE_KEY, permission.directoryUri);
       
-      // Process selected files
-      for (const file of result.assets) {
-        // Check if file is an audio file by extension
-        const fileExtension = `.${this.getFileExtension(file.name).toLowerCase()}`;
-        if (!SUPPORTED_AUDIO_EXTENSIONS.includes(fileExtension)) {
-          logger.warn(`Skipping unsupported file: ${file.name}`);
-          continue;
+      const { added } = await this.scanFolder(permission.directoryUri, onBatch);
+      logger.info(`Imported ${added.length} audio files from folder`);
+      return added;
+    } catch (error) {
+      logger.error('Error importing audio files from folder', error);
+      throw error;
+    }
+  }
+  
+  /**
+   * Rescan the remembered folder, importing new files and dropping removed ones
+   */
+  async rescanFolder(onBatch?: ImportBatchListener): Promise<FolderRescanResult> {
+    try {
+      const rootUri = await this.getFolderRoot();
+      if (!rootUri) {
+        logger.info('No folder has been imported, nothing to rescan');
+        return { added: [], removedIds: [] };
+      }
+      
+      const { added, seen, failures } = await this.scanFolder(rootUri, onBatch);
+      
+      // A partial listing would look like deletions, only prune after a clean scan
+      const removedIds: string[] = [];
+      if (failures === 0) {
+        const treePrefix = `${rootUri}/document/`;
+        for (const track of Array.from(this.tracks.values())) {
+          if (track.uri.startsWith(treePrefix) && !seen.has(track.uri)) {
+            this.tracks.delete(track.id);
+            removedIds.push(track.id);
+          }
         }
-        
-        // Copy file to document directory to ensure it's readable
-        const cachePath = await this.copyFileToDocumentDirectory(file.uri, file.name);
-        
-        // Extract metadata from the audio file
-        let metadata = null;
-        try {
-          metadata = await MusicInfo.getMusicInfoAsync(cachePath, {
-            title: true,
-            artist: true,
-            album: true,
-            genre: true,
-            picture: true
-          });
-          logger.debug(`Extracted metadata for ${file.name}:`, metadata);
-        } catch (error) {
-          logger.warn(`Failed to extract metadata from ${file.name}`, error);
+        if (removedIds.length > 0) {
+          await this.saveTracks();
         }
-        
-        // Try to extract artist from filename if not in metadata
-        let artistFromFilename;
-        const filenameWithoutExt = this.getFileNameWithoutExtension(file.name);
-        if (filenameWithoutExt.includes('-')) {
-          const parts = filenameWithoutExt.split('-');
-          if (parts.length >= 2) {
-            artistFromFilename = parts[0].trim();
+      } else {
+        logger.warn(`Folder rescan had ${failures} failed entries, keeping existing tracks`);
+      }
+      
+      logger.info(`Folder rescan added ${added.length} and removed ${removedIds.length} tracks`);
+      return { added, removedIds };
+    } catch (error) {
+      logger.error('Error rescanning imported folder', error);
+      throw error;
+    }
+  }
+  
+  /**
+   * The directory tree granted by the last folder import, if any
+   */
+  async getFolderRoot(): Promise<string | null> {
+    if (Platform.OS !== 'android') {
+      return null;
+    }
+    return AsyncStorage.getItem(LOCAL_FOLDER_ROOT_STORAGE_KEY);
+  }
+  
+  /**
+   * Walk a granted directory tree with bounded concurrency, importing audio files
+   * in place and handing them to the listener in batches as they are found
+   */
+  private async scanFolder(rootUri: string, onBatch?: ImportBatchListener): Promise<{ added: Track[]; seen: Set<string>; failures: number }> {
+    const knownUris = new Set(Array.from(this.tracks.values()).map(track => track.uri));
+    const seen = new Set<string>();
+    const added: Track[] = [];
+    let batch: Track[] = [];
+    
+    const failures = await this.runBounded<FolderEntry>([{ uri: rootUri, isDirectory: true }], FOLDER_SCAN_CONCURRENCY, async (entry, enqueue) => {
+      let isDirectory = entry.isDirectory;
+      if (isDirectory === undefined) {
+        const info = await FileSystem.getInfoAsync(entry.uri);
+        isDirectory = info.exists && info.isDirectory;
+      }
+      
+      if (isDirectory) {
+        const children = await ioAccounting.track('local', 'fs', 'saf.readDirectoryAsync', () =>
+          FileSystem.StorageAccessFramework.readDirectoryAsync(entry.uri)
+        );
+        for (const childUri of children) {
+          const name = this.getDocumentName(childUri);
+          if (this.isSupportedAudioFile(name)) {
+            enqueue({ uri: childUri, isDirectory: false, name });
+          } else {
+            // Folder names can contain dots, so anything else is probed once
+            enqueue({ uri: childUri });
           }
         }
-        
-        // Create a track object with metadata
-        const track: Track = {
-          id: uuid.v4().toString(),
-          title: metadata?.title || this.getFileNameWithoutExtension(file.name),
-          artist: metadata?.artist || artistFromFilename || 'Unknown artist',
-          album: metadata?.album || undefined,
-          uri: cachePath,
-          source: 'local',
-          path: cachePath,
-          duration: await this.getAudioDuration(cachePath),
-          artwork: metadata?.picture?.pictureData || undefined
-        };
-        
-        // Add to tracks map
-        this.tracks.set(track.id, track);
-        newTracks.push(track);
+        return;
       }
       
-      // Save updated tracks to persistent storage
+      const name = entry.name || this.getDocumentName(entry.uri);
+      if (!this.isSupportedAudioFile(name)) return;
+      
+      seen.add(entry.uri);
+      if (knownUris.has(entry.uri)) return;
+      knownUris.add(entry.uri);
+      
+      const track = await this.createTrackFromFile(entry.uri, name);
+      this.tracks.set(track.id, track);
+      added.push(track);
+      
+      batch.push(track);
+      if (batch.length >= FOLDER_IMPORT_BATCH_SIZE) {
+        onBatch?.(batch);
+        batch = [];
+      }
+    });
+    
+    if (batch.length > 0) {
+      onBatch?.(batch);
+    }
+    if (added.length > 0) {
       await this.saveTracks();
+    }
+    
+    return { added, seen, failures };
+  }
+  
+  /**
+   * Run a worker over a growing queue with at most `concurrency` items in flight
+   * Returns the number of items whose worker failed
+   */
+  private runBounded<T>(initial: T[], concurrency: number, worker: (item: T, enqueue: (item: T) => void) => Promise<void>): Promise<number> {
+    const queue = [...initial];
+    let active = 0;
+    let failures = 0;
+    
+    return new Promise(resolve => {
+      const pump = () => {
+        if (queue.length === 0 && active === 0) {
+          resolve(failures);
+          return;
+        }
+        while (active < concurrency && queue.length > 0) {
+          const item = queue.shift() as T;
+          active++;
+          worker(item, next => queue.push(next))
+            .catch(error => {
+              failures++;
+              logger.warn('Folder scan entry failed', error);
+            })
+            .finally(() => {
+              active--;
+              pump();
+            });
+        }
+      };
+      pump();
+    });
+  }
+  
+  /**
+   * Fallback folder import where directory trees can't be granted: pick many files
+   */
+  private async importPickedFiles(onBatch?: ImportBatchListener): Promise<Track[]> {
+    // Use document picker to select multiple files
+    const result = await DocumentPicker.getDocumentAsync({
+      type: '*/*', // Allow all file types, we'll filter them after
+      copyToCacheDirectory: false, // We'll handle caching ourselves
+      multiple: true // Allow multiple selection
+    });
+    
+    if (result.canceled) {
+      logger.info('User canceled folder selection');
+      return [];
+    }
+    
+    const newTracks: Track[] = [];
+    
+    // Process selected files
+    for (const file of result.assets) {
+      // Check if file is an audio file by extension
+      if (!this.isSupportedAudioFile(file.name)) {
+        logger.warn(`Skipping unsupported file: ${file.name}`);
+        continue;
+      }
       
-      logger.info(`Imported ${newTracks.length} audio files from folder`);
-      return newTracks;
+      // Copy file to document directory to ensure it's readable
+      const cachePath = await this.copyFileToDocumentDirectory(file.uri, file.name);
+      const track = await this.createTrackFromFile(cachePath, file.name);
+      
+      // Add to tracks map
+      this.tracks.set(track.id, track);
+      newTracks.push(track);
+    }
+    
+    // Save updated tracks to persistent storage
+    await this.saveTracks();
+    onBatch?.(newTracks);
+    
+    logger.info(`Imported ${newTracks.length} audio files from folder`);
+    return newTracks;
+  }
+  
+  /**
+   * Build a track for a readable audio file, using embedded metadata where present
+   */
+  private async createTrackFromFile(uri: string, fileName: string): Promise<Track> {
+    // Extract metadata from the audio file
+    let metadata = null;
+    try {
+      metadata = await MusicInfo.getMusicInfoAsync(uri, {
+        title: true,
+        artist: true,
+        album: true,
+        genre: true,
+        picture: false
+      });
+      logger.debug(`Extracted metadata for ${fileName}:`, metadata);
     } catch (error) {
-      logger.error('Error importing audio files from folder', error);
-      throw error;
+      logger.warn(`Failed to extract metadata from ${fileName}`, error);
+    }
+    
+    // Try to extract artist from filename if not in metadata
+    let artistFromFilename;
+    const filenameWithoutExt = this.getFileNameWithoutExtension(fileName);
+    if (filenameWithoutExt.includes('-')) {
+      const parts = filenameWithoutExt.split('-');
+      if (parts.length >= 2) {
+        artistFromFilename = parts[0].trim();
+      }
     }
+    
+    return {
+      id: uuid.v4().toString(),
+      title: metadata?.title || filenameWithoutExt,
+      artist: metadata?.artist || artistFromFilename || 'Unknown artist',
+      album: metadata?.album || undefined,
+      uri,
+      source: 'local',
+      path: uri,
+      duration: await this.getAudioDuration(uri)
+    };
   }
   
   /**
    * Initialize the local storage provider
    */
-  private async initialize(): Promise<void> {
+  protected async initialize(): Promise<void> {
     try {
       // Load saved tracks from AsyncStorage
       const savedTracksJson = await AsyncStorage.getItem(LOCAL_TRACKS_STORAGE_KEY);
       
       if (savedTracksJson) {
-        const savedTracks: Track[] = JSON.parse(savedTracksJson);
+        const savedTracks = await taskScheduler.run(() => parseJsonArrayInSlices<Track>(savedTracksJson), {
+          priority: TaskPriority.BACKGROUND,
+          label: 'parse-local-tracks'
+        });
         
         // Populate tracks map
         this.tracks.clear();
+        let relocatedCount = 0;
+        let hadArtwork = false;
         for (const track of savedTracks) {
+          // Artwork is read from the file when shown, libraries saved before that carried it inline
+          if (track.artwork !== undefined) {
+            delete track.artwork;
+            hadArtwork = true;
+          }
+          
           // Verify and fix file paths for Android
           if (Platform.OS === 'android') {
-            // Ensure URI has file:// protocol
-            if (track.uri && !track.uri.startsWith('file://')) {
+            // Ensure URI has file:// protocol, folder imports keep their content:// URIs
+            if (track.uri && !track.uri.startsWith('file://') && !track.uri.startsWith(CONTENT_URI_PREFIX)) {
               track.uri = `file://${track.uri}`;
             }
             // Ensure path has file:// protocol
-            if (track.path && !track.path.startsWith('file://')) {
+            if (track.path && !track.path.startsWith('file://') && !track.path.startsWith(CONTENT_URI_PREFIX)) {
               track.path = `file://${track.path}`;
             }
           }
@@ -376,6 +591,7 @@ export class LocalStorageProvider extends BaseStorageProvider {
               const found = await this.findFileByName(track);
               if (found) {
                 this.tracks.set(track.id, track);
+                relocatedCount++;
               } else {
                 logger.warn(`Could not locate file for track: ${track.title}`);
               }
@@ -384,9 +600,14 @@ export class LocalStorageProvider extends BaseStorageProvider {
         }
         
         logger.info(`Loaded ${this.tracks.size} tracks from local storage`);
+        
+        // Remember new locations so the next launch finds the files directly, without inline artwork
+        if (relocatedCount > 0 || hadArtwork) {
+          await this.saveTracks();
+        }
       }
       
-      this.initialized = true;
+      this.setConnectionState(ConnectionState.CONNECTED);
     } catch (error) {
       logger.error('Failed to initialize local storage provider', error);
       throw error;
@@ -412,9 +633,9 @@ export class LocalStorageProvider extends BaseStorageProvider {
    */
   private async getAudioDuration(uri: string): Promise<number | undefined> {
     try {
-      const { sound } = await Audio.Sound.createAsync({ uri });
-      const status = await sound.getStatusAsync();
-      await sound.unloadAsync(); // Clean up resources
+      const { sound } = await ioAccounting.track('local', 'av', 'createAsync', () => Audio.Sound.createAsync({ uri }));
+      const status = await ioAccounting.track('local', 'av', 'getStatusAsync', () => sound.getStatusAsync());
+      await ioAccounting.track('local', 'av', 'unloadAsync', () => sound.unloadAsync()); // Clean up resources
       
       // Check if the status is not an error status
       if ('durationMillis' in status) {
@@ -432,17 +653,12 @@ export class LocalStorageProvider extends BaseStorageProvider {
    */
   private async copyFileToDocumentDirectory(uri: string, fileName: string): Promise<string> {
     try {
-      // Ensure the audio directory exists in document storage (persistent)
-      const audioDir = `${FileSystem.documentDirectory}audio/`;
-      const dirInfo = await FileSystem.getInfoAsync(audioDir);
-      
-      if (!dirInfo.exists) {
-        await FileSystem.makeDirectoryAsync(audioDir, { intermediates: true });
-      }
-      
       // Create a unique filename to prevent collisions
       const uniqueFileName = `${Date.now()}_${fileName}`;
-      const destinationUri = `${audioDir}${uniqueFileName}`;
+      const destinationUri = this.audioLayout.pathFor(uniqueFileName);
+      
+      // Ensure its shard exists in document storage (persistent)
+      await this.audioLayout.ensureDirectoryFor(destinationUri);
       
       // Copy the file
       await FileSystem.copyAsync({
@@ -481,7 +697,36 @@ export class LocalStorageProvider extends BaseStorageProvider {
   private getFileNameWithoutExtension(filename: string): string {
     return filename.split('.').slice(0, -1).join('.');
   }
+  
+  /**
+   * Whether a filename has one of the supported audio extensions
+   */
+  private isSupportedAudioFile(filename: string): boolean {
+    return SUPPORTED_AUDIO_EXTENSIONS.includes(`.${this.getFileExtension(filename).toLowerCase()}`);
+  }
+  
+  /**
+   * Display name of a Storage Access Framework document, the last segment of its document ID
+   */
+  private getDocumentName(uri: string): string {
+    const documentId = decodeURIComponent(uri.substring(uri.lastIndexOf('/') + 1));
+    return documentId.substring(Math.max(documentId.lastIndexOf('/'), documentId.lastIndexOf(':')) + 1);
+  }
 
+  /**
+   * Point tracks at an imported copy that moved into its shard
+   */
+  private relocateTrackFile(fileName: string, path: string): void {
+    const persistentUri = Platform.OS === 'android' ? `file://${path}` : path;
+    for (const track of this.tracks.values()) {
+      if (track.uri && !track.uri.startsWith(CONTENT_URI_PREFIX) && track.uri.endsWith(`/${fileName}`)) {
+        track.uri = persistentUri;
+        track.path = persistentUri;
+        this.hasRelocatedTracks = true;
+      }
+    }
+  }
+  
   /**
    * Try to find a file by its name in the document directory
    * This is useful for Android where file paths might change between app launches
@@ -494,20 +739,26 @@ export class LocalStorageProvider extends BaseStorageProvider {
       const uriParts = track.uri.split('/');
       const fileName = uriParts[uriParts.length - 1];
       
-      // Check document directory
-      const audioDocDir = `${FileSystem.documentDirectory}audio/`;
-      const dirInfo = await FileSystem.getInfoAsync(audioDocDir);
-      
-      if (!dirInfo.exists) return false;
+      // The same name in its shard, e.g. after the directory was sharded or the container moved
+      await this.audioLayout.adopt(fileName);
+      const shardPath = this.audioLayout.pathFor(fileName);
+      if ((await FileSystem.getInfoAsync(shardPath)).exists) {
+        const persistentUri = Platform.OS === 'android' ? `file://${shardPath}` : shardPath;
+        track.uri = persistentUri;
+        track.path = persistentUri;
+        
+        logger.info(`Found relocated file for track: ${track.title} at ${persistentUri}`);
+        return true;
+      }
       
-      // List all files in the audio directory
-      const files = await FileSystem.readDirectoryAsync(audioDocDir);
+      // Files left in the root from before sharding
+      const files = await this.audioLayout.listFlatFiles();
       
       // Look for files with similar names
       for (const file of files) {
         // Check if file contains the original filename (without timestamp prefix)
         if (file.includes(fileName) || fileName.includes(file)) {
-          const newPath = `${audioDocDir}${file}`;
+          const newPath = `${AUDIO_DOCUMENT_DIR}${file}`;
           const persistentUri = Platform.OS === 'android' ? `file://${newPath}` : newPath;
           
           // Update track with new path
@@ -526,6 +777,14 @@ export class LocalStorageProvider extends BaseStorageProvider {
     }
   }
 
+  /**
+   * Read a track's embedded artwork from its imported copy
+   */
+  async readArtwork(track: Track): Promise<string | undefined> {
+    const path = this.tracks.get(track.id)?.path ?? track.path;
+    return path ? this.readEmbeddedArtwork(path) : undefined;
+  }
+  
   /**
    * Extract metadata from an audio file and update the track object
    * @param track Track to update
@@ -533,14 +792,14 @@ export class LocalStorageProvider extends BaseStorageProvider {
    */
   public async extractAndUpdateMetadata(track: Track, filePath: string): Promise<void> {
     try {
-      // Only extract metadata if track is missing information
-      if (!track.artist || !track.album || !track.artwork) {
+      // Only extract metadata if track is missing information, artwork is read when the track is shown
+      if (!track.artist || !track.album) {
         const metadata = await MusicInfo.getMusicInfoAsync(filePath, {
           title: true,
           artist: true,
           album: true,
           genre: true,
-          picture: true
+          picture: false
         });
         
         // Try to extract artist from filename if metadata doesn't provide it
@@ -566,11 +825,6 @@ export class LocalStorageProvider extends BaseStorageProvider {
             track.album = metadata.album;
           }
           
-          if (!track.artwork && metadata.picture?.pictureData) {
-            track.artwork = metadata.picture.pictureData;
-            logger.debug(`Extracted artwork for track: ${track.title}`);
-          }
-          
           // Save the updated tracks to persistent storage
           await this.saveTracks();
         } else if (!track.artist) {
@@ -0,0 +1,412 @@
+/**
+ * Media library storage provider implementation
+ * Exposes the audio the OS has already indexed, without copying or re-parsing files
+ */
+
+import * as MediaLibrary from 'expo-media-library';
+import MusicInfo from 'expo-music-info-2';
+import { Platform } from 'react-native';
+
+import { BaseStorageProvider } from './StorageProvider';
+import { toPlainTrack } from '../catalog/Catalog';
+import { Track, ConnectionState } from '../../types';
+import { logger } from '../../utils/logger';
+import { ioAccounting, instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('media-library');
+
+// Constants
+const MEDIA_LIBRARY_ENABLED_STORAGE_KEY = '@sonora/media_library_enabled';
+const PAGE_SIZE = 500;
+const CHANGE_DEBOUNCE_MS = 1000;
+const CHANGE_EVENT = 'mediaLibraryDidChange';
+const TRACK_ID_PREFIX = 'media-';
+
+// Audio only, so Android 13+ asks for READ_MEDIA_AUDIO and not for photos and videos
+const GRANULAR_PERMISSIONS: MediaLibrary.GranularPermission[] = ['audio'];
+
+export interface MediaLibraryPermission {
+  granted: boolean;
+  canAskAgain?: boolean;
+}
+
+export interface MediaLibraryAsset {
+  id: string;
+  filename: string;
+  uri: string;
+  mediaType: string;
+  duration: number; // in seconds
+  modificationTime?: number;
+}
+
+export interface MediaLibraryPage {
+  assets: MediaLibraryAsset[];
+  endCursor: string;
+  hasNextPage: boolean;
+  totalCount: number;
+}
+
+/**
+ * The subset of the ExpoMediaLibrary native module this provider uses
+ */
+export interface MediaLibraryModule {
+  getPermissionsAsync(writeOnly: boolean): Promise<MediaLibraryPermission>;
+  requestPermissionsAsync(writeOnly: boolean): Promise<MediaLibraryPermission>;
+  getAssetsAsync(options: { first: number; after?: string; mediaType: string[] }): Promise<MediaLibraryPage>;
+  getAssetInfoAsync(assetId: string, options?: { shouldDownloadFromNetwork?: boolean }): Promise<MediaLibraryAsset & { localUri?: string }>;
+  addListener?(eventName: string, listener: () => void): { remove: () => void };
+}
+
+export interface MediaLibraryChange {
+  added: Track[];
+  removedIds: string[];
+}
+
+export type MediaLibraryChangeListener = (change: MediaLibraryChange) => void;
+
+/**
+ * expo-media-library behind the module interface
+ * Only Android indexes music in its media store; on iOS the API reaches the Photos library alone
+ */
+const createExpoMediaLibrary = (): MediaLibraryModule | null => {
+  if (Platform.OS !== 'android') {
+    return null;
+  }
+  
+  return {
+    getPermissionsAsync: writeOnly => MediaLibrary.getPermissionsAsync(writeOnly, GRANULAR_PERMISSIONS),
+    requestPermissionsAsync: writeOnly => MediaLibrary.requestPermissionsAsync(writeOnly, GRANULAR_PERMISSIONS),
+    getAssetsAsync: options => MediaLibrary.getAssetsAsync({
+      ...options,
+      mediaType: options.mediaType as MediaLibrary.MediaTypeValue[]
+    }),
+    getAssetInfoAsync: (assetId, options) => MediaLibrary.getAssetInfoAsync(assetId, options),
+    addListener: (eventName, listener) => MediaLibrary.addListener(listener)
+  };
+};
+
+export class MediaLibraryStorageProvider extends BaseStorageProvider {
+  private tracks: Map<string, Track> = new Map();
+  private changeListeners: Set<MediaLibraryChangeListener> = new Set();
+  private librarySubscription: { remove: () => void } | null = null;
+  private changeTimer: NodeJS.Timeout | null = null;
+  private scanPromise: Promise<void> | null = null;
+  private rescanRequested: boolean = false;
+  
+  /**
+   * @param mediaLibrary Media library to read, defaults to expo-media-library on Android
+   */
+  constructor(private mediaLibrary: MediaLibraryModule | null = createExpoMediaLibrary()) {
+    super('Device Library', 'media-library');
+  }
+  
+  /**
+   * Whether this platform's media library holds music
+   */
+  isAvailable(): boolean {
+    return this.mediaLibrary !== null;
+  }
+  
+  /**
+   * Ask for media library access and index the device's audio
+   */
+  async connect(): Promise<boolean> {
+    if (!this.mediaLibrary) {
+      logger.warn('The media library holds no music on this platform');
+      return false;
+    }
+    
+    try {
+      const permission = await this.mediaLibrary.requestPermissionsAsync(false);
+      if (!permission.granted) {
+        logger.info('Media library permission was not granted');
+        return false;
+      }
+      
+      await AsyncStorage.setItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY, 'true');
+      this.resetInitialization();
+      await this.ensureInitialized();
+      return this.connectionState === ConnectionState.CONNECTED;
+    } catch (error) {
+      logger.error('Failed to connect to media library', error);
+      return false;
+    }
+  }
+  
+  /**
+   * Stop exposing the device library
+   */
+  async disconnect(): Promise<void> {
+    await AsyncStorage.removeItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY);
+    this.unsubscribeFromLibrary();
+    
+    const removedIds = Array.from(this.tracks.keys());
+    this.tracks.clear();
+    this.resetInitialization();
+    this.setConnectionState(ConnectionState.DISCONNECTED);
+    this.emitChange({ added: [], removedIds });
+  }
+  
+  /**
+   * List all audio assets in the device library
+   */
+  async listAudioFiles(): Promise<Track[]> {
+    await this.ensureInitialized();
+    return Array.from(this.tracks.values());
+  }
+  
+  /**
+   * Get a specific audio asset by track ID
+   */
+  async getAudioFile(id: string): Promise<Track | null> {
+    await this.ensureInitialized();
+    return this.tracks.get(id) || null;
+  }
+  
+  /**
+   * Get the playable URI for an asset
+   * Android assets are plain files; other platforms resolve a local URI on demand
+   */
+  async getAudioFileUri(track: Track): Promise<string> {
+    if (track.source !== 'media-library') {
+      throw new Error('Track is not from the media library');
+    }
+    
+    if (track.uri.startsWith('file://') || !this.mediaLibrary) {
+      return track.uri;
+    }
+    
+    try {
+      const assetId = track.id.substring(TRACK_ID_PREFIX.length);
+      const info = await ioAccounting.track('media-library', 'fs', 'getAssetInfoAsync', () =>
+        this.mediaLibrary!.getAssetInfoAsync(assetId, { shouldDownloadFromNetwork: true })
+      );
+      return info.localUri || track.uri;
+    } catch (error) {
+      logger.error(`Error resolving media library asset for ${track.title}`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * Only plain files resolve without the OS possibly fetching the asset from the network
+   */
+  async warmAudioFileUri(track: Track): Promise<string | null> {
+    return track.uri.startsWith('file://') ? track.uri : null;
+  }
+  
+  /**
+   * Subscribe to tracks added or removed after library changes
+   * Returns an unsubscribe function
+   */
+  onTracksChanged(listener: MediaLibraryChangeListener): () => void {
+    this.changeListeners.add(listener);
+    return () => {
+      this.changeListeners.delete(listener);
+    };
+  }
+  
+  /**
+   * Read the artwork of an asset stored as a plain file
+   */
+  async readArtwork(track: Track): Promise<string | undefined> {
+    return track.uri.startsWith('file://') ? this.readEmbeddedArtwork(track.uri) : undefined;
+  }
+  
+  /**
+   * Read embedded tags the OS index doesn't expose (artist, album, artwork)
+   * Called lazily on playback, so the initial index stays a pure metadata read
+   */
+  async extractAndUpdateMetadata(track: Track, filePath: string): Promise<void> {
+    if (track.album && track.artwork) return;
+    
+    try {
+      const uri = filePath.startsWith('file://') ? filePath : await this.getAudioFileUri(track);
+      const metadata = await MusicInfo.getMusicInfoAsync(uri, {
+        title: true,
+        artist: true,
+        album: true,
+        genre: false,
+        picture: true
+      });
+      if (!metadata) return;
+      
+      if (metadata.title) track.title = metadata.title;
+      if (metadata.artist) track.artist = metadata.artist;
+      if (metadata.album) track.album = metadata.album;
+      if (metadata.picture?.pictureData) track.artwork = metadata.picture.pictureData;
+      
+      // Keep the in-memory index in step so later listings see the tags, artwork is read again when shown
+      // The track can be a catalog view, whose fields a spread would not copy
+      const { artwork, ...tags } = toPlainTrack(track);
+      this.tracks.set(track.id, tags);
+    } catch (error) {
+      logger.warn(`Failed to extract metadata for ${track.title}`, error);
+    }
+  }
+  
+  /**
+   * Index the library if the user enabled it and access is still granted
+   */
+  protected async initialize(): Promise<void> {
+    try {
+      if (!this.mediaLibrary) {
+        this.setConnectionState(ConnectionState.DISCONNECTED);
+        return;
+      }
+      
+      const enabled = await AsyncStorage.getItem(MEDIA_LIBRARY_ENABLED_STORAGE_KEY);
+      if (enabled !== 'true') {
+        this.setConnectionState(ConnectionState.DISCONNECTED);
+        return;
+      }
+      
+      const permission = await this.mediaLibrary.getPermissionsAsync(false);
+      if (!permission.granted) {
+        logger.warn('Media library permission was revoked');
+        this.setConnectionState(ConnectionState.DISCONNECTED);
+        return;
+      }
+      
+      await this.scan();
+      this.subscribeToLibrary();
+      this.setConnectionState(ConnectionState.CONNECTED);
+    } catch (error) {
+      logger.error('Failed to initialize media library provider', error);
+      throw error;
+    }
+  }
+  
+  /**
+   * Page through every audio asset and diff against the current index
+   * Concurrent requests coalesce into one follow-up scan
+   */
+  private scan(): Promise<void> {
+    if (this.scanPromise) {
+      this.rescanRequested = true;
+      return this.scanPromise;
+    }
+    
+    this.scanPromise = (async () => {
+      try {
+        do {
+          this.rescanRequested = false;
+          await this.scanOnce();
+        } while (this.rescanRequested);
+      } finally {
+        this.scanPromise = null;
+      }
+    })();
+    return this.scanPromise;
+  }
+  
+  private async scanOnce(): Promise<void> {
+    const mediaLibrary = this.mediaLibrary!;
+    const seen = new Set<string>();
+    const added: Track[] = [];
+    let after: string | undefined;
+    let pages = 0;
+    
+    while (true) {
+      const page = await ioAccounting.track('media-library', 'fs', 'getAssetsAsync', () =>
+        mediaLibrary.getAssetsAsync({ first: PAGE_SIZE, after, mediaType: ['audio'] })
+      );
+      pages++;
+      
+      for (const asset of page.assets) {
+        const track = this.toTrack(asset);
+        seen.add(track.id);
+        
+        const existing = this.tracks.get(track.id);
+        if (!existing) {
+          this.tracks.set(track.id, track);
+          added.push(track);
+        } else if (existing.uri !== track.uri || existing.duration !== track.duration) {
+          // Moved or replaced on disk, keep any tags read since
+          const updated = { ...existing, uri: track.uri, path: track.path, duration: track.duration };
+          this.tracks.set(track.id, updated);
+          added.push(updated);
+        }
+      }
+      
+      if (!page.hasNextPage || page.assets.length === 0) break;
+      after = page.endCursor;
+    }
+    
+    const removedIds: string[] = [];
+    for (const id of Array.from(this.tracks.keys())) {
+      if (!seen.has(id)) {
+        this.tracks.delete(id);
+        removedIds.push(id);
+      }
+    }
+    
+    logger.info(`Indexed ${this.tracks.size} media library tracks in ${pages} pages (+${added.length} -${removedIds.length})`);
+    this.emitChange({ added, removedIds });
+  }
+  
+  /**
+   * Build a track from the OS index entry
+   * The index has no tags, so "Artist - Title" filenames are split like local imports
+   */
+  private toTrack(asset: MediaLibraryAsset): Track {
+    const baseName = asset.filename.includes('.') ? asset.filename.split('.').slice(0, -1).join('.') : asset.filename;
+    let title = baseName;
+    let artist: string | undefined;
+    
+    const separator = baseName.indexOf(' - ');
+    if (separator > 0) {
+      artist = baseName.substring(0, separator).trim();
+      title = baseName.substring(separator + 3).trim();
+    }
+    
+    return {
+      id: `${TRACK_ID_PREFIX}${asset.id}`,
+      title,
+      artist: artist || 'Unknown artist',
+      uri: asset.uri,
+      source: 'media-library',
+      path: asset.uri,
+      duration: asset.duration > 0 ? Math.round(asset.duration * 1000) : undefined
+    };
+  }
+  
+  /**
+   * Rescan shortly after the OS reports library changes, bursts collapse into one scan
+   */
+  private subscribeToLibrary(): void {
+    if (this.librarySubscription || !this.mediaLibrary?.addListener) return;
+    
+    this.librarySubscription = this.mediaLibrary.addListener(CHANGE_EVENT, () => {
+      if (this.changeTimer) {
+        clearTimeout(this.changeTimer);
+      }
+      this.changeTimer = setTimeout(() => {
+        this.changeTimer = null;
+        this.scan().catch(error => logger.error('Media library rescan failed', error));
+      }, CHANGE_DEBOUNCE_MS);
+    });
+  }
+  
+  private unsubscribeFromLibrary(): void {
+    this.librarySubscription?.remove();
+    this.librarySubscription = null;
+    if (this.changeTimer) {
+      clearTimeout(this.changeTimer);
+      this.changeTimer = null;
+    }
+  }
+  
+  private emitChange(change: MediaLibraryChange): void {
+    if (change.added.length === 0 && change.removedIds.length === 0) return;
+    
+    for (const listener of Array.from(this.changeListeners)) {
+      try {
+        listener(change);
+      } catch (error) {
+        logger.error('Error in media library change listener', error);
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -3,13 +3,24 @@
  * Handles access to music files stored in Microsoft OneDrive
  */
 
-import { BaseStorageProvider } from './StorageProvider';
-import { Track, OneDriveAuthResult } from '../../types';
+import { BaseStorageProvider, isSessionState } from './StorageProvider';
+import { inFlightRegistry, RequestPriority } from './InFlightRegistry';
+import { graphResponseCache } from './GraphResponseCache';
+import { getHeadPath, getCompleteFileName, readPartial, fetchHead, fillRemainder } from './PartialCache';
+import { ShardedDirectory } from './ShardedDirectory';
+import {
+  DriveFolder,
+  SyncScopeRule,
+  DEFAULT_SYNC_FOLDER_NAMES,
+  getEffectiveRules,
+  findGoverningRule,
+  toDriveFolder,
+  getParentPath
+} from './SyncScopes';
+import { Track, OneDriveAuthResult, ConnectionState } from '../../types';
 import { logger } from '../../utils/logger';
-import AsyncStorage from '@react-native-async-storage/async-storage';
 import * as WebBrowser from 'expo-web-browser';
 import * as Linking from 'expo-linking';
-import * as FileSystem from 'expo-file-system';
 import { Platform } from 'react-native';
 import * as NetInfo from '@react-native-community/netinfo';
 import MusicInfo from 'expo-music-info-2';
@@ -23,18 +34,63 @@ import {
 } from '../../config/onedrive';
 import { logOAuthDetails } from '../../utils/debugHelper';
 import { extractCleanTitle, formatTime as formatDuration } from '../../utils/formatters';
+import { parseJsonArrayInSlices } from '../../utils/jsonChunks';
+import { taskScheduler, TaskPriority } from '../scheduler/TaskScheduler';
+import { metrics } from '../../utils/metrics';
+import { tracing } from '../../utils/tracing';
+import { maintenanceScheduler } from '../scheduler/MaintenanceScheduler';
+import { dataBudget, DataBudgetError } from '../network/DataBudget';
+import { instrumentFileSystem, instrumentAsyncStorage } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('onedrive');
+const AsyncStorage = instrumentAsyncStorage('onedrive');
 
 // Constants
 const ONEDRIVE_TRACKS_STORAGE_KEY = '@sonora/onedrive_tracks';
+const ONEDRIVE_INGESTED_TRACKS_STORAGE_KEY = '@sonora/onedrive_ingested_tracks'; // single list from before the journal
+const ONEDRIVE_INGESTED_BATCHES_KEY = '@sonora/onedrive_ingested_batches';
+const ONEDRIVE_INGESTED_BATCH_PREFIX = '@sonora/onedrive_ingested_batch/';
 const ONEDRIVE_AUTH_STORAGE_KEY = '@sonora/onedrive_auth';
 const ONEDRIVE_SYNC_SETTINGS_KEY = '@sonora/onedrive_sync_settings';
+const ONEDRIVE_SYNC_SCOPES_KEY = '@sonora/onedrive_sync_scopes';
 const ONEDRIVE_DOCUMENT_DIR = FileSystem.documentDirectory + 'onedrive/';
 const SUPPORTED_AUDIO_EXTENSIONS = ['.mp3', '.m4a', '.aac', '.wav', '.ogg', '.flac', '.wma', '.alac', '.aiff'];
+const CACHE_GC_INTERVAL_MS = 24 * 60 * 60 * 1000;
 
 // Microsoft Graph API endpoints
 const GRAPH_API_ENDPOINT = 'https://graph.microsoft.com/v1.0';
 const GRAPH_API_DRIVE_ENDPOINT = `${GRAPH_API_ENDPOINT}/me/drive`;
 
+// Pre-authenticated download URLs expire after about an hour, refetch item bodies before that
+const DOWNLOAD_URL_MAX_AGE_MS = 45 * 60 * 1000;
+
+// Server-side search results requested per query
+const DRIVE_SEARCH_PAGE_SIZE = 50;
+const SEARCH_FOLDER_PATHS_KEPT = 500;
+
+// Tracks added from search or browsing are journaled in batches, so adding a page writes only that page
+const MAX_INGESTED_BATCHES = 32; // folded into one batch on load beyond this
+
+// Folder listings are paged, and trimmed to the fields the crawler and folder picker read
+const DRIVE_CHILDREN_PAGE_SIZE = 200;
+const CRAWL_SELECT = 'id,name,size,folder,file,audio,@microsoft.graph.downloadUrl';
+const FOLDER_SELECT = 'id,name,size,folder,parentReference';
+const BROWSE_SELECT = `${CRAWL_SELECT},parentReference`;
+
+// Browsed pages are reused for a while, so going back up a folder costs no request
+const BROWSE_PAGE_MAX_AGE_MS = 5 * 60 * 1000;
+const BROWSE_CACHE_PAGES = 50;
+
+// Partial prefetch: enough of a track to start playing while the rest arrives
+const HEAD_SECONDS = 10;
+const HEAD_TAG_ALLOWANCE_BYTES = 128 * 1024; // ID3 tags and embedded artwork come before the audio
+const DEFAULT_HEAD_BITRATE_KBPS = 320;
+const CONTINUATION_CLAIM_MS = 60 * 1000;
+
+// Formats that decode from a truncated file (MP4 containers may keep their index at the end)
+const HEAD_PLAYABLE_EXTENSIONS = ['mp3', 'aac', 'flac', 'ogg', 'wav'];
+
 // Default OneDrive auth config
 const DEFAULT_AUTH_CONFIG = {
   clientId: ONEDRIVE_CLIENT_ID,
@@ -51,27 +107,104 @@ interface SyncSettings {
   lastSyncTime: Date | null;
 }
 
+export interface DriveFolderPage {
+  folders: DriveFolder[];
+  nextLink: string | null; // more folders follow
+}
+
+export interface DriveBrowsePage {
+  folders: DriveFolder[];
+  tracks: Track[];
+  nextLink: string | null; // more items follow
+}
+
+// Reads a Graph resource as JSON, standing in for the drive in isolated providers
+export type GraphJsonReader = (url: string) => Promise<any>;
+
+// A track added from search or browsing, with its folder so scope rules can apply to it
+interface IngestedTrack {
+  track: Track;
+  folderPath: string | null; // null when Graph did not say
+}
+
+interface DownloadItem {
+  url: string;
+  eTag?: string;
+  size: number; // 0 when unknown
+  bitrateKbps: number; // 0 when unknown
+}
+
 export class OneDriveStorageProvider extends BaseStorageProvider {
   private tracks: Map<string, Track>;
+  // Tracks added from search results or browsing, kept across rescans of the music folders
+  private ingestedTracks: Map<string, IngestedTrack> = new Map();
+  private ingestedBatches: number[] = [];
+  private nextIngestedBatch: number = 0;
+  private ingestedWrites: Promise<void> = Promise.resolve();
+  // Folders of recent search results, for results the user then adds
+  private searchFolderPaths: Map<string, string | null> = new Map();
   private authConfig: {
     clientId: string;
     redirectUri: string;
     scopes: string[];
   };
   private authResult: OneDriveAuthResult | null = null;
-  private initialized: boolean = false;
+  private tokenExpiryTimer: NodeJS.Timeout | null = null;
+  private tokenRefreshPromise: Promise<boolean> | null = null;
+  private isNetworkOffline: boolean = false;
+  private unsubscribeNetInfo: (() => void) | null = null;
   private syncSettings: SyncSettings = { ...DEFAULT_SYNC_SETTINGS };
+  private syncScopes: SyncScopeRule[] = [];
+  // Folder pages listed while browsing, keyed by request URL, oldest first
+  private browsePages: Map<string, { page: DriveBrowsePage; fetchedAt: number }> = new Map();
   private syncStatus: SyncStatus = SyncStatus.IDLE;
   private syncTimer: NodeJS.Timeout | null = null;
   private onSyncStatusChange: ((status: SyncStatus) => void) | null = null;
+  private onCacheFilesRemoved: (() => void) | null = null;
+  // Set only on isolated providers, which read this instead of the signed-in drive
+  private readonly isolatedGraph: GraphJsonReader | null;
+  // Where playback started from a cached head continues, keyed by the head's path
+  private continuations: Map<string, Promise<string>> = new Map();
+  // Downloads are sharded by cache file name, so partial files sit next to the file they become
+  private cacheLayout = new ShardedDirectory(ONEDRIVE_DOCUMENT_DIR, {
+    keyOf: file => this.getOwnerFileName(file)
+  });
   
-  constructor(clientId?: string) {
+  constructor(clientId?: string, isolatedGraph: GraphJsonReader | null = null) {
     super('OneDrive', 'onedrive');
     this.tracks = new Map<string, Track>();
     this.authConfig = {
       ...DEFAULT_AUTH_CONFIG,
       clientId: clientId || DEFAULT_AUTH_CONFIG.clientId
     };
+    this.isolatedGraph = isolatedGraph;
+    
+    // The app's provider owns the cache directory
+    if (isolatedGraph) {
+      return;
+    }
+    
+    // Remove orphaned and partial downloads during maintenance windows
+    maintenanceScheduler.register({
+      id: 'onedrive-cache-gc',
+      intervalMs: CACHE_GC_INTERVAL_MS,
+      step: (checkpoint: number | null) => this.collectCacheGarbage(checkpoint)
+    });
+    
+    // Move downloads made before the cache was sharded into their shards
+    maintenanceScheduler.register({
+      id: 'onedrive-cache-layout',
+      intervalMs: CACHE_GC_INTERVAL_MS,
+      step: async () => (await this.cacheLayout.migrateStep()) || null
+    });
+  }
+  
+  /**
+   * Create a provider that syncs from a stand-in drive, for benchmarks
+   * It needs no session and never touches the app's saved library, caches or maintenance jobs
+   */
+  static createIsolated(graph: GraphJsonReader): OneDriveStorageProvider {
+    return new OneDriveStorageProvider(undefined, graph);
   }
   
   /**
@@ -88,6 +221,13 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     this.onSyncStatusChange = callback;
   }
   
+  /**
+   * Set a callback for when cache maintenance deletes downloaded tracks
+   */
+  setCacheFilesRemovedCallback(callback: (() => void) | null): void {
+    this.onCacheFilesRemoved = callback;
+  }
+  
   /**
    * Get current sync status
    */
@@ -125,16 +265,61 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
   }
   
   /**
-   * Check if connected to OneDrive
+   * Get the folder include and exclude rules, see SyncScopes
    */
-  async isConnected(): Promise<boolean> {
-    if (!this.initialized) {
-      await this.initialize();
+  getSyncScopes(): SyncScopeRule[] {
+    return [...this.syncScopes];
+  }
+  
+  /**
+   * Replace the folder rules, applied from the next sync
+   */
+  async setSyncScopes(rules: SyncScopeRule[]): Promise<void> {
+    try {
+      this.syncScopes = [...rules];
+      await AsyncStorage.setItem(ONEDRIVE_SYNC_SCOPES_KEY, JSON.stringify(this.syncScopes));
+      logger.info(`OneDrive sync scopes updated: ${rules.length} rules`);
+    } catch (error) {
+      logger.error('Error updating OneDrive sync scopes', error);
+      throw error;
     }
+  }
+  
+  /**
+   * List one page of the subfolders of a folder, with their item counts and sizes
+   * @param folderId Folder to list, null for the drive root
+   * @param nextLink Link from the previous page, to continue a listing
+   */
+  async listDriveFolders(folderId: string | null, nextLink: string | null = null): Promise<DriveFolderPage> {
+    await this.requireSession();
     
-    // Only return true if we have a valid auth result
-    // Don't attempt to sync or show Disconnect button if we never connected
-    return !!this.authResult && this.isTokenValid();
+    const parent = folderId ? `items/${folderId}` : 'root';
+    const url = nextLink || `${GRAPH_API_DRIVE_ENDPOINT}/${parent}/children?$top=${DRIVE_CHILDREN_PAGE_SIZE}&$select=${FOLDER_SELECT}`;
+    
+    try {
+      const data = await this.graphGetJson(url);
+      return {
+        folders: (data.value || []).filter((item: any) => item.folder).map(toDriveFolder),
+        nextLink: data['@odata.nextLink'] || null
+      };
+    } catch (error) {
+      logger.error(`Error listing folders in ${folderId || 'root'}`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * The default music folders present in the drive root, synced when no rule includes a folder
+   */
+  async getDefaultSyncFolders(): Promise<DriveFolder[]> {
+    const folders: DriveFolder[] = [];
+    let nextLink: string | null = null;
+    do {
+      const page: DriveFolderPage = await this.listDriveFolders(null, nextLink);
+      folders.push(...page.folders.filter(folder => DEFAULT_SYNC_FOLDER_NAMES.includes(folder.name)));
+      nextLink = page.nextLink;
+    } while (nextLink);
+    return folders;
   }
   
   /**
@@ -165,9 +350,11 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       
       // Start the authentication flow
       logger.debug('No valid token found, starting authentication flow...');
+      this.setConnectionState(ConnectionState.CONNECTING);
       await this.authenticate();
+      this.evaluateSessionState();
       
-      const connected = await this.isConnected();
+      const connected = isSessionState(this.connectionState);
       logger.debug('Authentication completed, connected status: ' + connected);
       
       // Start sync timer if enabled and connected successfully
@@ -178,6 +365,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       return connected;
     } catch (error) {
       logger.error('Failed to connect to OneDrive', error);
+      this.evaluateSessionState();
       return false;
     }
   }
@@ -192,11 +380,22 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       
       // Clear auth data
       this.authResult = null;
+      this.evaluateSessionState();
       await AsyncStorage.removeItem(ONEDRIVE_AUTH_STORAGE_KEY);
       
       // Clear tracks
       this.tracks.clear();
+      this.ingestedTracks.clear();
+      this.searchFolderPaths.clear();
       await AsyncStorage.removeItem(ONEDRIVE_TRACKS_STORAGE_KEY);
+      await AsyncStorage.removeItem(ONEDRIVE_INGESTED_TRACKS_STORAGE_KEY);
+      await this.rewriteIngested();
+      
+      // Cached responses and folder rules belong to the old account
+      await graphResponseCache.clear();
+      this.browsePages.clear();
+      this.syncScopes = [];
+      await AsyncStorage.removeItem(ONEDRIVE_SYNC_SCOPES_KEY);
       
       logger.info('Disconnected from OneDrive');
     } catch (error) {
@@ -223,6 +422,11 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
         return;
       }
       
+      if (this.connectionState === ConnectionState.OFFLINE) {
+        logger.info('Skipping OneDrive sync - network offline');
+        return;
+      }
+      
       // Check if should sync only on WiFi
       if (this.syncSettings.syncOnWifiOnly) {
         const networkState = await NetInfo.fetch();
@@ -238,7 +442,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       logger.info('Starting OneDrive sync (logging files only, not downloading)');
       
       // Fetch audio files from OneDrive
-      await this.fetchAudioFiles();
+      await tracing.trace('sync', () => this.fetchAudioFiles(), { provider: 'onedrive' });
       
       // Update last sync time
       this.syncSettings.lastSyncTime = new Date();
@@ -257,9 +461,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
    * List all audio files in OneDrive
    */
   async listAudioFiles(): Promise<Track[]> {
-    if (!await this.isConnected()) {
-      throw new Error('Not connected to OneDrive');
-    }
+    await this.requireSession();
     
     try {
       // First try to load from cache
@@ -281,46 +483,285 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
    * Get a specific audio file by ID
    */
   async getAudioFile(id: string): Promise<Track | null> {
-    if (!await this.isConnected()) {
-      throw new Error('Not connected to OneDrive');
-    }
+    await this.requireSession();
     
     return this.tracks.get(id) || null;
   }
   
   /**
-   * Get the playable URI for an audio file
+   * Resolve cached tracks, and for the rest refresh the session and fetch the download URL
+   * Runs on touch-down, so it never downloads audio; the tap reuses the cached Graph response
    */
-  async getAudioFileUri(track: Track): Promise<string> {
+  async warmAudioFileUri(track: Track): Promise<string | null> {
     if (track.source !== 'onedrive') {
       throw new Error('Track is not from OneDrive');
     }
     
-    if (!await this.isConnected()) {
-      throw new Error('Not connected to OneDrive');
+    await this.requireSession();
+    
+    const docPath = await this.getCachePath(track);
+    const docInfo = await FileSystem.getInfoAsync(docPath);
+    if (docInfo.exists) {
+      return docPath;
+    }
+    
+    // Graph requests refresh an expiring token on the way
+    if (dataBudget.canPrefetch()) {
+      await this.getDownloadUrl(track);
     }
+    return null;
+  }
+  
+  /**
+   * Search the whole drive server-side for audio files
+   * Finds tracks outside the scanned music folders; results are not added to the library
+   */
+  async searchDrive(query: string): Promise<Track[]> {
+    await this.requireSession();
+    
+    const trimmed = query.trim();
+    if (!trimmed) return [];
+    
+    try {
+      // OData string literals escape quotes by doubling them
+      const q = encodeURIComponent(trimmed.replace(/'/g, "''"));
+      const response = await this.makeGraphRequest(
+        `${GRAPH_API_DRIVE_ENDPOINT}/root/search(q='${q}')?$top=${DRIVE_SEARCH_PAGE_SIZE}&$select=id,name,file,audio,parentReference,@microsoft.graph.downloadUrl`
+      );
+      
+      if (!response.ok) {
+        throw new Error(`Graph search failed with status ${response.status}`);
+      }
+      
+      const data = await response.json();
+      const results: Track[] = [];
+      for (const item of data.value || []) {
+        if (item.file && this.isAudioItem(item)) {
+          // Prefer the library copy, it may already carry extracted metadata
+          const track = this.tracks.get(`onedrive-${item.id}`) || this.createTrackFromItem(item);
+          results.push(track);
+          this.searchFolderPaths.delete(track.id);
+          this.searchFolderPaths.set(track.id, getParentPath(item));
+        }
+      }
+      
+      // Oldest results first in the map
+      for (const id of this.searchFolderPaths.keys()) {
+        if (this.searchFolderPaths.size <= SEARCH_FOLDER_PATHS_KEPT) break;
+        this.searchFolderPaths.delete(id);
+      }
+      
+      metrics.increment('onedrive.search.queries');
+      logger.debug(`Drive search for "${trimmed}" returned ${results.length} audio files`);
+      return results;
+    } catch (error) {
+      logger.error(`Error searching OneDrive for "${trimmed}"`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * List one page of a folder's subfolders and audio files, without waiting for a sync
+   * Audio files on the page join the library as they are listed
+   * @param folderId Folder to list, null for the drive root
+   * @param nextLink Link from the previous page, to continue a listing
+   */
+  async browseFolder(folderId: string | null, nextLink: string | null = null): Promise<DriveBrowsePage> {
+    await this.requireSession();
+    
+    const parent = folderId ? `items/${folderId}` : 'root';
+    const url = nextLink || `${GRAPH_API_DRIVE_ENDPOINT}/${parent}/children?$top=${DRIVE_CHILDREN_PAGE_SIZE}&$select=${BROWSE_SELECT}`;
+    
+    const cached = this.browsePages.get(url);
+    if (cached && Date.now() - cached.fetchedAt < BROWSE_PAGE_MAX_AGE_MS) {
+      metrics.increment('onedrive.browse.cache_hits');
+      return cached.page;
+    }
+    
+    try {
+      const data = await this.graphGetJson(url);
+      const page: DriveBrowsePage = { folders: [], tracks: [], nextLink: data['@odata.nextLink'] || null };
+      const browsed: IngestedTrack[] = [];
+      for (const item of data.value || []) {
+        if (item.folder) {
+          page.folders.push(toDriveFolder(item));
+        } else if (item.file && this.isAudioItem(item)) {
+          // Prefer the library copy, it may already carry extracted metadata
+          const track = this.tracks.get(`onedrive-${item.id}`) || this.createTrackFromItem(item);
+          page.tracks.push(track);
+          browsed.push({ track, folderPath: getParentPath(item) });
+        }
+      }
+      
+      this.browsePages.delete(url);
+      this.browsePages.set(url, { page, fetchedAt: Date.now() });
+      if (this.browsePages.size > BROWSE_CACHE_PAGES) {
+        this.browsePages.delete(this.browsePages.keys().next().value as string);
+      }
+      
+      await this.ingestBrowsedTracks(browsed);
+      metrics.increment('onedrive.browse.pages');
+      return page;
+    } catch (error) {
+      logger.error(`Error browsing folder ${folderId || 'root'}`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * Add a track found by drive search to the library
+   * Only its journal entry is written, the journal is merged into the saved library on load
+   */
+  async ingestTrack(track: Track): Promise<Track> {
+    await this.requireSession();
+    
+    const existing = this.tracks.get(track.id);
+    if (existing) return existing;
     
     try {
-      // Extract file extension from the path or title
-      let fileExtension = '';
-      if (track.path && track.path.includes('.')) {
-        fileExtension = `.${this.getFileExtension(track.path)}`;
-      } else if (track.title && track.title.includes('.')) {
-        fileExtension = `.${this.getFileExtension(track.title)}`;
+      const entry: IngestedTrack = { track, folderPath: this.searchFolderPaths.get(track.id) ?? null };
+      this.tracks.set(track.id, track);
+      this.ingestedTracks.set(track.id, entry);
+      await this.appendIngested([entry]);
+      
+      metrics.increment('onedrive.search.ingested');
+      logger.info(`Added ${extractCleanTitle(track.title, track.artist)} to the library from drive search`);
+      return track;
+    } catch (error) {
+      logger.error(`Error adding ${track.title} to the library`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * Add browsed tracks that are not in the library yet
+   * Only this page's new tracks are written, as one journal batch
+   */
+  private async ingestBrowsedTracks(entries: IngestedTrack[]): Promise<void> {
+    const added = entries.filter(entry => !this.tracks.has(entry.track.id));
+    if (added.length === 0) return;
+    
+    for (const entry of added) {
+      this.tracks.set(entry.track.id, entry.track);
+      this.ingestedTracks.set(entry.track.id, entry);
+    }
+    
+    await this.appendIngested(added);
+    metrics.increment('onedrive.browse.ingested', added.length);
+    logger.debug(`Added ${added.length} browsed tracks to the library`);
+  }
+  
+  /**
+   * Write ingested tracks as a new journal batch, earlier batches are left as they are
+   * Journal writes run one at a time so the batch list stays consistent
+   */
+  private appendIngested(entries: IngestedTrack[]): Promise<void> {
+    const write = this.ingestedWrites.then(async () => {
+      const batch = this.nextIngestedBatch++;
+      await AsyncStorage.setItem(`${ONEDRIVE_INGESTED_BATCH_PREFIX}${batch}`, JSON.stringify(entries));
+      this.ingestedBatches.push(batch);
+      await AsyncStorage.setItem(ONEDRIVE_INGESTED_BATCHES_KEY, JSON.stringify(this.ingestedBatches));
+    });
+    this.ingestedWrites = write.catch(() => {});
+    return write;
+  }
+  
+  /**
+   * Replace the journal with one batch of the current ingested tracks
+   * The new batch list is saved before old batches are removed, so a crash loses nothing
+   */
+  private rewriteIngested(): Promise<void> {
+    const write = this.ingestedWrites.then(async () => {
+      const previous = this.ingestedBatches;
+      const entries = Array.from(this.ingestedTracks.values());
+      
+      if (entries.length > 0) {
+        const batch = this.nextIngestedBatch++;
+        await AsyncStorage.setItem(`${ONEDRIVE_INGESTED_BATCH_PREFIX}${batch}`, JSON.stringify(entries));
+        this.ingestedBatches = [batch];
+        await AsyncStorage.setItem(ONEDRIVE_INGESTED_BATCHES_KEY, JSON.stringify(this.ingestedBatches));
       } else {
-        // Default to .mp3 if no extension found
-        fileExtension = '.mp3';
+        this.ingestedBatches = [];
+        await AsyncStorage.removeItem(ONEDRIVE_INGESTED_BATCHES_KEY);
       }
       
+      for (const batch of previous) {
+        await AsyncStorage.removeItem(`${ONEDRIVE_INGESTED_BATCH_PREFIX}${batch}`);
+      }
+    });
+    this.ingestedWrites = write.catch(() => {});
+    return write;
+  }
+  
+  /**
+   * Read the ingested tracks journal, folding it into one batch when it has grown long
+   */
+  private async loadIngested(): Promise<void> {
+    this.ingestedTracks.clear();
+    let compact = false;
+    
+    // The single list written before the journal
+    const legacyData = await AsyncStorage.getItem(ONEDRIVE_INGESTED_TRACKS_STORAGE_KEY);
+    if (legacyData) {
+      try {
+        for (const track of JSON.parse(legacyData) as Track[]) {
+          this.ingestedTracks.set(track.id, { track, folderPath: null });
+        }
+      } catch (parseError) {
+        logger.error('Error parsing ingested OneDrive tracks', parseError);
+      }
+      compact = true;
+    }
+    
+    const batchesData = await AsyncStorage.getItem(ONEDRIVE_INGESTED_BATCHES_KEY);
+    this.ingestedBatches = batchesData ? JSON.parse(batchesData) as number[] : [];
+    this.nextIngestedBatch = this.ingestedBatches.reduce((next, batch) => Math.max(next, batch + 1), 0);
+    
+    for (const batch of this.ingestedBatches) {
+      const data = await AsyncStorage.getItem(`${ONEDRIVE_INGESTED_BATCH_PREFIX}${batch}`);
+      if (!data) continue;
+      try {
+        // Later batches win, they carry the newer copy of a track
+        for (const entry of JSON.parse(data) as IngestedTrack[]) {
+          this.ingestedTracks.set(entry.track.id, entry);
+        }
+      } catch (parseError) {
+        logger.error(`Error parsing ingested OneDrive tracks batch ${batch}`, parseError);
+      }
+    }
+    
+    if (compact || this.ingestedBatches.length > MAX_INGESTED_BATCHES) {
+      await this.rewriteIngested();
+      await AsyncStorage.removeItem(ONEDRIVE_INGESTED_TRACKS_STORAGE_KEY);
+    }
+  }
+  
+  /**
+   * Get the playable URI for an audio file
+   */
+  async getAudioFileUri(track: Track, priority: RequestPriority = RequestPriority.INTERACTIVE): Promise<string> {
+    if (track.source !== 'onedrive') {
+      throw new Error('Track is not from OneDrive');
+    }
+    
+    await this.requireSession();
+    
+    // Only count lookups made for playback in the cache hit rate
+    const isPlayback = priority === RequestPriority.INTERACTIVE;
+    
+    try {
       // Create consistent file name for caching
-      const fileName = `onedrive-${track.id}${fileExtension}`;
+      const fileName = this.getCacheFileName(track);
       
       // Check if file exists in document directory (new location)
-      const docPath = `${ONEDRIVE_DOCUMENT_DIR}${fileName}`;
+      const docPath = await this.getCachePath(track);
       const docInfo = await FileSystem.getInfoAsync(docPath);
       
       if (docInfo.exists) {
         logger.debug(`Using cached file for ${track.title} from document directory`);
+        if (isPlayback) {
+          this.recordPlaybackLookup(true);
+        }
         
         // If track has no metadata yet, try to extract it
         if (!track.artist && !track.album) {
@@ -337,9 +778,12 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       
       if (cacheInfo.exists) {
         logger.debug(`Found file in legacy cache directory, moving to document directory: ${track.title}`);
+        if (isPlayback) {
+          this.recordPlaybackLookup(true);
+        }
         
-        // Ensure document directory exists
-        await this.ensureDocumentDirectory();
+        // Ensure its shard exists
+        await this.cacheLayout.ensureDirectoryFor(docPath);
         
         // Copy file to document directory
         await FileSystem.copyAsync({
@@ -353,31 +797,47 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
         return docPath;
       }
       
-      // Download the file
-      logger.info(`Downloading file from OneDrive: ${track.title}`);
-      
-      // Ensure document directory exists
-      await this.ensureDocumentDirectory();
+      if (isPlayback) {
+        this.recordPlaybackLookup(false);
+      }
       
-      // Get download URL
-      const downloadUrl = await this.getDownloadUrl(track);
-      logger.debug(`Download URL: ${downloadUrl}`);
+      // Not cached, the data budget decides between downloading, streaming and refusing
+      if (priority === RequestPriority.PREFETCH && !dataBudget.canPrefetch()) {
+        throw new DataBudgetError(`Prefetch of ${track.title} paused by the data budget`);
+      }
       
-      // Download the file
-      const downloadResult = await FileSystem.downloadAsync(downloadUrl, docPath);
-      logger.debug(`File downloaded to: ${downloadResult.uri}`);
+      // A prefetched head starts playback right away, the rest follows
+      if (isPlayback && (dataBudget.shouldCacheDownloads() || dataBudget.canStream()) && await readPartial(docPath)) {
+        metrics.increment('onedrive.playback.head_starts');
+        return this.startFromHead(track, docPath);
+      }
       
-      // Extract metadata and update track
-      await this.extractAndUpdateMetadata(track, downloadResult.uri);
+      if (!dataBudget.shouldCacheDownloads()) {
+        if (!dataBudget.canStream()) {
+          throw new DataBudgetError(`${track.title} is not available offline and the cellular data budget is used up`);
+        }
+        
+        logger.info(`Streaming ${track.title} without caching`);
+        const streamUrl = await this.getDownloadUrl(track);
+        dataBudget.recordStream(track.duration);
+        return streamUrl;
+      }
       
-      return downloadResult.uri;
+      // Download the file, or join a download already running for this track
+      return await this.downloadToCache(track, docPath, priority);
     } catch (error) {
+      // Budget decisions are final, streaming instead would defeat them
+      if (error instanceof DataBudgetError) {
+        throw error;
+      }
+      
       logger.error(`Error getting audio file URI for ${track.title}`, error);
       
       // If we can't download/cache the file, return the direct download URL as fallback
       try {
         const downloadUrl = await this.getDownloadUrl(track);
         logger.info(`Using direct download URL for ${track.title} as fallback`);
+        dataBudget.recordStream(track.duration);
         return downloadUrl;
       } catch (fallbackError) {
         logger.error(`Fallback also failed for ${track.title}`, fallbackError);
@@ -386,19 +846,336 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     }
   }
   
+  /**
+   * Read a track's embedded artwork from its downloaded file, if there is one
+   */
+  async readArtwork(track: Track): Promise<string | undefined> {
+    // pathFor rather than getCachePath, which may move a file into its shard
+    const docPath = this.cacheLayout.pathFor(this.getCacheFileName(track));
+    const docInfo = await FileSystem.getInfoAsync(docPath);
+    return docInfo.exists ? this.readEmbeddedArtwork(docPath) : undefined;
+  }
+  
+  /**
+   * Check whether a track is available offline
+   */
+  async isTrackCached(track: Track): Promise<boolean> {
+    const fileName = this.getCacheFileName(track);
+    const docInfo = await FileSystem.getInfoAsync(await this.getCachePath(track));
+    if (docInfo.exists) {
+      return true;
+    }
+    
+    const cacheInfo = await FileSystem.getInfoAsync(`${FileSystem.cacheDirectory}onedrive/${fileName}`);
+    return cacheInfo.exists;
+  }
+  
+  /**
+   * Download a track ahead of playback at prefetch priority
+   * @returns Bytes downloaded, 0 if the track was already cached
+   */
+  async precacheTrack(track: Track): Promise<number> {
+    await this.requireSession();
+    
+    if (!dataBudget.canPrefetch() || !dataBudget.shouldCacheDownloads()) {
+      throw new DataBudgetError(`Precaching of ${track.title} paused by the data budget`);
+    }
+    
+    if (await this.isTrackCached(track)) {
+      return 0;
+    }
+    
+    const docPath = await this.getCachePath(track);
+    await this.downloadToCache(track, docPath, RequestPriority.PREFETCH);
+    
+    const info = await FileSystem.getInfoAsync(docPath);
+    return info.exists ? info.size : 0;
+  }
+  
+  /**
+   * Download the first seconds of a track, sized by its bitrate
+   * Costs a fraction of precaching; playing the track range-fills the rest
+   * @returns Bytes downloaded, 0 if nothing was needed
+   */
+  async prefetchHead(track: Track): Promise<number> {
+    await this.requireSession();
+    
+    if (!dataBudget.canPrefetch()) {
+      throw new DataBudgetError(`Head prefetch of ${track.title} paused by the data budget`);
+    }
+    
+    const fileName = this.getCacheFileName(track);
+    if (!HEAD_PLAYABLE_EXTENSIONS.includes(this.getFileExtension(fileName).toLowerCase())) {
+      return 0;
+    }
+    
+    const docPath = await this.getCachePath(track);
+    if (inFlightRegistry.isInFlight(`onedrive-download:${track.id}`) || await this.isTrackCached(track) || await readPartial(docPath)) {
+      return 0;
+    }
+    
+    return inFlightRegistry.run(`onedrive-head:${track.id}`, RequestPriority.PREFETCH, async () => {
+      await this.cacheLayout.ensureDirectoryFor(docPath);
+      
+      const item = await this.getDownloadItem(track);
+      const result = await fetchHead(item.url, docPath, this.getHeadBytes(track, item), item.eTag);
+      dataBudget.record(result.bytes, 'prefetch');
+      metrics.increment('onedrive.head_prefetch.count');
+      metrics.increment('onedrive.head_prefetch.bytes', result.bytes);
+      
+      logger.debug(`Prefetched ${result.complete ? 'all' : 'the head'} of ${track.title} (${result.bytes} bytes)`);
+      return result.bytes;
+    });
+  }
+  
+  /**
+   * Claim where playback started from a cached head continues
+   * Null unless the URI is a head returned by getAudioFileUri
+   */
+  getContinuation(uri: string): Promise<string> | null {
+    const continuation = this.continuations.get(uri) || null;
+    this.continuations.delete(uri);
+    return continuation;
+  }
+  
+  /**
+   * Total size of downloaded audio files
+   */
+  async getCacheSize(): Promise<number> {
+    let total = 0;
+    for (const path of await this.cacheLayout.listFiles()) {
+      const info = await FileSystem.getInfoAsync(path);
+      if (info.exists && !info.isDirectory) {
+        total += info.size;
+      }
+    }
+    return total;
+  }
+  
+  /**
+   * One step of cache garbage collection, scanning one shard of the cache directory
+   * Removes interrupted downloads and files of tracks no longer in the library
+   * @param checkpoint Index of the shard to continue from
+   * @returns The next index, or null when every shard has been scanned
+   */
+  async collectCacheGarbage(checkpoint: number | null): Promise<number | null> {
+    // Without a loaded track list every file would look orphaned
+    if (this.tracks.size === 0) {
+      return null;
+    }
+    
+    const shards = this.cacheLayout.getShardDirs();
+    const index = checkpoint ?? 0;
+    if (index >= shards.length) {
+      return null;
+    }
+    
+    const dir = shards[index];
+    const files = await this.cacheLayout.readShard(dir);
+    
+    const liveFileNames = new Set<string>();
+    for (const track of this.tracks.values()) {
+      liveFileNames.add(this.getCacheFileName(track));
+    }
+    
+    let removedTracks = 0;
+    for (const file of files) {
+      const isTransfer = file.endsWith('.part') || file.endsWith('.fill');
+      const owner = this.getOwnerFileName(file);
+      const trackId = this.getTrackIdFromFileName(owner);
+      
+      const isInterrupted = isTransfer &&
+        !inFlightRegistry.isInFlight(`onedrive-download:${trackId}`) &&
+        !inFlightRegistry.isInFlight(`onedrive-head:${trackId}`);
+      const isOrphan = !isTransfer && !liveFileNames.has(owner);
+      
+      if (isInterrupted || isOrphan) {
+        await FileSystem.deleteAsync(`${dir}${file}`, { idempotent: true });
+        logger.debug(`Removed unused cache file: ${file}`);
+        if (isOrphan && file === owner) {
+          removedTracks++;
+        }
+      }
+    }
+    
+    if (removedTracks > 0) {
+      this.onCacheFilesRemoved?.();
+    }
+    
+    return index + 1 < shards.length ? index + 1 : null;
+  }
+  
+  /**
+   * Complete cache file a file belongs to
+   * Downloads in progress, heads, their manifests and range fills belong to the file they become
+   */
+  private getOwnerFileName(file: string): string {
+    return file.endsWith('.part') ? file.slice(0, -'.part'.length) : getCompleteFileName(file) ?? file;
+  }
+  
+  /**
+   * Path of a track's cache file in its shard
+   * A file cached before the cache was sharded is moved there first
+   */
+  private async getCachePath(track: Track): Promise<string> {
+    const fileName = this.getCacheFileName(track);
+    await this.cacheLayout.adopt(fileName);
+    return this.cacheLayout.pathFor(fileName);
+  }
+  
+  /**
+   * Track ID a cache file name belongs to
+   */
+  private getTrackIdFromFileName(name: string): string {
+    const withoutPrefix = name.startsWith('onedrive-') ? name.slice('onedrive-'.length) : name;
+    const dotIndex = withoutPrefix.lastIndexOf('.');
+    return dotIndex === -1 ? withoutPrefix : withoutPrefix.slice(0, dotIndex);
+  }
+  
+  /**
+   * Cache file name for a track, the extension comes from the path or title
+   */
+  private getCacheFileName(track: Track): string {
+    let fileExtension = '';
+    if (track.path && track.path.includes('.')) {
+      fileExtension = `.${this.getFileExtension(track.path)}`;
+    } else if (track.title && track.title.includes('.')) {
+      fileExtension = `.${this.getFileExtension(track.title)}`;
+    } else {
+      // Default to .mp3 if no extension found
+      fileExtension = '.mp3';
+    }
+    
+    return `onedrive-${track.id}${fileExtension}`;
+  }
+  
+  /**
+   * Count a playback lookup and update the cache hit rate
+   */
+  private recordPlaybackLookup(hit: boolean): void {
+    metrics.increment('onedrive.playback.lookups');
+    if (hit) {
+      metrics.increment('onedrive.playback.cache_hits');
+    }
+    metrics.setGauge('onedrive.playback.cache_hit_rate', metrics.ratio('onedrive.playback.cache_hits', 'onedrive.playback.lookups'));
+  }
+  
+  /**
+   * Play from a prefetched head while the rest downloads, or streams when caching is off
+   * The player claims the continuation and switches over at the same position
+   */
+  private startFromHead(track: Track, docPath: string): string {
+    const headPath = getHeadPath(docPath);
+    
+    const stream = async (): Promise<string> => {
+      const url = await this.getDownloadUrl(track);
+      dataBudget.recordStream(track.duration);
+      return url;
+    };
+    const continuation = dataBudget.shouldCacheDownloads()
+      ? this.downloadToCache(track, docPath, RequestPriority.INTERACTIVE).catch(error => {
+        logger.warn(`Range fill failed for ${track.title}, streaming the rest`, error);
+        return stream();
+      })
+      : stream();
+    
+    this.continuations.set(headPath, continuation);
+    
+    // Forget continuations nobody claimed, the download itself still completes the cache
+    const forget = () => {
+      setTimeout(() => {
+        if (this.continuations.get(headPath) === continuation) {
+          this.continuations.delete(headPath);
+        }
+      }, CONTINUATION_CLAIM_MS);
+    };
+    continuation.then(forget, forget);
+    
+    logger.debug(`Starting ${track.title} from its cached head`);
+    return headPath;
+  }
+  
+  /**
+   * Bytes covering the first HEAD_SECONDS of a track plus its tags
+   */
+  private getHeadBytes(track: Track, item: DownloadItem): number {
+    let bytesPerSecond = (item.bitrateKbps || DEFAULT_HEAD_BITRATE_KBPS) * 1000 / 8;
+    if (!item.bitrateKbps && item.size > 0 && track.duration) {
+      bytesPerSecond = item.size / (track.duration / 1000);
+    }
+    
+    const bytes = Math.ceil(bytesPerSecond * HEAD_SECONDS) + HEAD_TAG_ALLOWANCE_BYTES;
+    return item.size > 0 ? Math.min(bytes, item.size) : bytes;
+  }
+  
+  /**
+   * Download a track into the cache
+   * Concurrent callers share one download; a higher priority caller promotes a queued one
+   * A cached head is kept and only the remainder is fetched
+   */
+  private downloadToCache(track: Track, docPath: string, priority: RequestPriority): Promise<string> {
+    return inFlightRegistry.run(`onedrive-download:${track.id}`, priority, async () => {
+      logger.info(`Downloading file from OneDrive: ${track.title}`);
+      
+      // Ensure its shard exists
+      await this.cacheLayout.ensureDirectoryFor(docPath);
+      
+      // Let a head prefetch in progress land first, its bytes are reused
+      // Joined as interactive so a queued head cannot wait on the slot this download holds
+      const headKey = `onedrive-head:${track.id}`;
+      if (inFlightRegistry.isInFlight(headKey)) {
+        await inFlightRegistry.run(headKey, RequestPriority.INTERACTIVE, async () => 0).catch(() => 0);
+        
+        // Small files arrive whole
+        if ((await FileSystem.getInfoAsync(docPath)).exists) {
+          return docPath;
+        }
+      }
+      
+      // Get download URL
+      const item = await this.getDownloadItem(track);
+      logger.debug(`Download URL: ${item.url}`);
+      
+      let bytes: number;
+      if (await readPartial(docPath)) {
+        // Only fetch what the cached head is missing
+        bytes = (await fillRemainder(item.url, docPath, item.eTag)).bytes;
+        logger.debug(`Range-filled ${bytes} bytes after the cached head: ${docPath}`);
+      } else {
+        // Download next to the final path and move it into place, so readers never see a partial file
+        const partialPath = `${docPath}.part`;
+        const downloadResult = await FileSystem.downloadAsync(item.url, partialPath);
+        if (downloadResult.status < 200 || downloadResult.status >= 300) {
+          await FileSystem.deleteAsync(partialPath, { idempotent: true });
+          throw new Error(`Download failed with status ${downloadResult.status}`);
+        }
+        await FileSystem.moveAsync({ from: partialPath, to: docPath });
+        logger.debug(`File downloaded to: ${docPath}`);
+        
+        bytes = Number(downloadResult.headers['Content-Length'] || downloadResult.headers['content-length'] || 0);
+      }
+      dataBudget.record(bytes, priority === RequestPriority.PREFETCH ? 'prefetch' : 'download');
+      
+      // Extract metadata and update track
+      await this.extractAndUpdateMetadata(track, docPath);
+      
+      return docPath;
+    });
+  }
+  
   /**
    * Extract metadata from an audio file and update the track object
    */
   public async extractAndUpdateMetadata(track: Track, filePath: string): Promise<void> {
     try {
-      // Only extract metadata if track is missing information
-      if (!track.artist || !track.album || !track.artwork) {
+      // Only extract metadata if track is missing information, artwork is read when the track is shown
+      if (!track.artist || !track.album) {
         const metadata = await MusicInfo.getMusicInfoAsync(filePath, {
           title: true,
           artist: true,
           album: true,
           genre: true,
-          picture: true
+          picture: false
         });
         
         // Try to extract artist from filename if metadata doesn't provide it
@@ -424,11 +1201,6 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
             track.album = metadata.album;
           }
           
-          if (!track.artwork && metadata.picture?.pictureData) {
-            track.artwork = metadata.picture.pictureData;
-            logger.debug(`Extracted artwork for track: ${extractCleanTitle(track.title, track.artist)}`);
-          }
-          
           // Save the updated tracks to persistent storage
           const tracksArray = Array.from(this.tracks.values());
           await AsyncStorage.setItem(ONEDRIVE_TRACKS_STORAGE_KEY, JSON.stringify(tracksArray));
@@ -461,10 +1233,92 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     }
   }
   
+  /**
+   * Fail fast unless there is a usable session
+   * Only the first call after launch waits for initialization, later calls just read the state
+   */
+  private async requireSession(): Promise<void> {
+    if (this.isolatedGraph) return;
+    
+    if (this.connectionState === ConnectionState.CONNECTING || this.connectionState === ConnectionState.DISCONNECTED) {
+      await this.ensureInitialized();
+    }
+    
+    if (!isSessionState(this.connectionState)) {
+      throw new Error('Not connected to OneDrive');
+    }
+  }
+  
+  /**
+   * Derive the connection state from the stored token and network reachability
+   */
+  private evaluateSessionState(): void {
+    this.clearTokenExpiryTimer();
+    
+    let state: ConnectionState;
+    if (!this.authResult) {
+      state = ConnectionState.DISCONNECTED;
+    } else if (this.isTokenValid()) {
+      state = ConnectionState.CONNECTED;
+      this.scheduleTokenExpiry();
+    } else if (this.authResult.refreshToken) {
+      state = ConnectionState.EXPIRED;
+    } else {
+      state = ConnectionState.DISCONNECTED;
+    }
+    
+    if (this.isNetworkOffline && isSessionState(state)) {
+      state = ConnectionState.OFFLINE;
+    }
+    
+    this.setConnectionState(state);
+  }
+  
+  /**
+   * Move to EXPIRED when the token enters its refresh window, instead of checking on every call
+   */
+  private scheduleTokenExpiry(): void {
+    if (!this.authResult) return;
+    
+    const bufferTime = 5 * 60 * 1000; // keep in sync with isTokenValid
+    const expiresOn = new Date(this.authResult.expiresOn).getTime();
+    const delay = Math.max(0, expiresOn - bufferTime - Date.now());
+    
+    this.tokenExpiryTimer = setTimeout(() => {
+      this.tokenExpiryTimer = null;
+      this.evaluateSessionState();
+    }, delay);
+  }
+  
+  /**
+   * Cancel the pending token expiry transition
+   */
+  private clearTokenExpiryTimer(): void {
+    if (this.tokenExpiryTimer) {
+      clearTimeout(this.tokenExpiryTimer);
+      this.tokenExpiryTimer = null;
+    }
+  }
+  
+  /**
+   * Track network reachability so the session can move in and out of OFFLINE
+   */
+  private subscribeToNetworkChanges(): void {
+    if (this.unsubscribeNetInfo) return;
+    
+    this.unsubscribeNetInfo = NetInfo.addEventListener(state => {
+      const offline = state.isConnected === false;
+      if (offline !== this.isNetworkOffline) {
+        this.isNetworkOffline = offline;
+        this.evaluateSessionState();
+      }
+    });
+  }
+  
   /**
    * Initialize the OneDrive storage provider
    */
-  private async initialize(): Promise<void> {
+  protected async initialize(): Promise<void> {
     try {
       // Load auth data
       const authData = await AsyncStorage.getItem(ONEDRIVE_AUTH_STORAGE_KEY);
@@ -506,17 +1360,46 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
         }
       }
       
+      // Load sync scopes
+      const syncScopesData = await AsyncStorage.getItem(ONEDRIVE_SYNC_SCOPES_KEY);
+      if (syncScopesData) {
+        try {
+          this.syncScopes = JSON.parse(syncScopesData);
+        } catch (parseError) {
+          logger.error('Error parsing OneDrive sync scopes', parseError);
+          this.syncScopes = [];
+        }
+      }
+      
       // Load saved tracks
       const tracksData = await AsyncStorage.getItem(ONEDRIVE_TRACKS_STORAGE_KEY);
       if (tracksData) {
-        const tracks: Track[] = JSON.parse(tracksData);
+        // The blob can be several megabytes, parse it in time slices instead of one JSON.parse
+        const tracks = await taskScheduler.run(() => parseJsonArrayInSlices<Track>(tracksData), {
+          priority: TaskPriority.BACKGROUND,
+          label: 'parse-onedrive-tracks'
+        });
         this.tracks.clear();
         for (const track of tracks) {
+          // Artwork is read from the cached file when shown, never kept here
+          delete track.artwork;
           this.tracks.set(track.id, track);
         }
         logger.info(`Loaded ${tracks.length} tracks from OneDrive cache`);
       }
       
+      // Load tracks added from search results or browsing, they may not be in the saved tracks yet
+      try {
+        await this.loadIngested();
+        this.ingestedTracks.forEach((entry, id) => {
+          if (!this.tracks.has(id)) {
+            this.tracks.set(id, entry.track);
+          }
+        });
+      } catch (ingestedError) {
+        logger.error('Error loading ingested OneDrive tracks', ingestedError);
+      }
+      
       // Ensure document directory exists
       await this.ensureDocumentDirectory();
       
@@ -534,7 +1417,8 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
         this.startSyncTimer();
       }
       
-      this.initialized = true;
+      this.subscribeToNetworkChanges();
+      this.evaluateSessionState();
     } catch (error) {
       logger.error('Error initializing OneDrive storage provider', error);
       throw error;
@@ -839,10 +1723,22 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     }
   }
   
+  /**
+   * Refresh the access token, sharing a single request between concurrent callers
+   */
+  private refreshToken(): Promise<boolean> {
+    if (!this.tokenRefreshPromise) {
+      this.tokenRefreshPromise = this.performTokenRefresh().finally(() => {
+        this.tokenRefreshPromise = null;
+      });
+    }
+    return this.tokenRefreshPromise;
+  }
+  
   /**
    * Refresh the access token using the refresh token
    */
-  private async refreshToken(): Promise<boolean> {
+  private async performTokenRefresh(): Promise<boolean> {
     try {
       if (!this.authResult?.refreshToken) {
         logger.warn('No refresh token available');
@@ -850,6 +1746,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       }
       
       logger.debug('Refreshing access token');
+      this.setConnectionState(ConnectionState.REFRESHING);
       
       const tokenEndpoint = ONEDRIVE_API.TOKEN_ENDPOINT;
       const params = new URLSearchParams({
@@ -872,6 +1769,12 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       
       if (!response.ok) {
         logger.error('Token refresh failed', data);
+        if (response.status === 400 || response.status === 401) {
+          // The refresh token was rejected, so the session cannot recover without signing in again
+          this.authResult = null;
+          await AsyncStorage.removeItem(ONEDRIVE_AUTH_STORAGE_KEY);
+        }
+        this.evaluateSessionState();
         return false;
       }
       
@@ -892,9 +1795,12 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       await AsyncStorage.setItem(ONEDRIVE_AUTH_STORAGE_KEY, JSON.stringify(this.authResult));
       
       logger.info('Successfully refreshed access token');
+      this.evaluateSessionState();
       return true;
     } catch (error) {
       logger.error('Error refreshing token', error);
+      // Most likely a network failure, keep the session and retry on the next request
+      this.evaluateSessionState();
       return false;
     }
   }
@@ -909,30 +1815,47 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       // Clear existing tracks
       this.tracks.clear();
       
-      // Search only in the specified folders
-      const targetFolders = ['sonora', 'music', 'Music'];
+      // Crawl from the included folders, or the default ones when no rule includes any
+      const hasIncludes = this.syncScopes.some(rule => rule.mode === 'include');
+      const defaultFolders = hasIncludes ? [] : await this.getDefaultSyncFolders();
+      const rules = getEffectiveRules(this.syncScopes, defaultFolders);
+      const roots = rules.filter(rule => rule.mode === 'include');
       
-      // Get root folder contents
-      const rootResponse = await this.makeGraphRequest(`${GRAPH_API_DRIVE_ENDPOINT}/root/children`);
-      const rootData = await rootResponse.json();
+      // Excluded subtrees are never listed
+      const excluded = new Set(rules.filter(rule => rule.mode === 'exclude').map(rule => rule.id));
+      const visited = new Set<string>();
       
-      // Find the specified folders and search them
-      let foldersFound = 0;
-      for (const item of rootData.value) {
-        if (item.folder && targetFolders.includes(item.name)) {
-          foldersFound++;
-          logger.info(`Searching for audio files in ${item.name} folder (ID: ${item.id})`);
-          await this.searchAudioFilesInFolder(item.id);
-        }
+      for (const root of roots) {
+        logger.info(`Searching for audio files in ${root.path} (ID: ${root.id})`);
+        await this.searchAudioFilesInFolder(root.id, excluded, visited);
       }
       
-      if (foldersFound === 0) {
-        logger.info(`None of the target folders found: ${targetFolders.join(', ')}`);
+      if (roots.length === 0) {
+        logger.info(`None of the target folders found: ${DEFAULT_SYNC_FOLDER_NAMES.join(', ')}`);
       }
       
-      // Save tracks to AsyncStorage
+      // Ingested tracks the crawl found are ordinary library tracks now, and ones in excluded
+      // folders leave the library; the rest live outside the scanned folders and are kept
+      let pruned = 0;
+      this.ingestedTracks.forEach((entry, id) => {
+        const inExcludedFolder = entry.folderPath !== null && findGoverningRule(entry.folderPath, rules)?.mode === 'exclude';
+        if (this.tracks.has(id) || inExcludedFolder) {
+          this.ingestedTracks.delete(id);
+          pruned++;
+        } else {
+          this.tracks.set(id, entry.track);
+        }
+      });
+      if (pruned > 0) {
+        await this.rewriteIngested();
+        logger.info(`Dropped ${pruned} ingested tracks now covered by the sync scopes`);
+      }
+      
+      // Save tracks to AsyncStorage, unless this is an isolated provider's stand-in drive
       const tracksArray = Array.from(this.tracks.values());
-      await AsyncStorage.setItem(ONEDRIVE_TRACKS_STORAGE_KEY, JSON.stringify(tracksArray));
+      if (!this.isolatedGraph) {
+        await AsyncStorage.setItem(ONEDRIVE_TRACKS_STORAGE_KEY, JSON.stringify(tracksArray));
+      }
       
       logger.info(`Found ${tracksArray.length} audio files in OneDrive specified folders (logging only)`);
     } catch (error) {
@@ -943,49 +1866,31 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
   
   /**
    * Recursively search for audio files in a folder
+   * @param excluded Folders whose subtrees are skipped
+   * @param visited Folders already searched, an included folder can sit inside another
    */
-  private async searchAudioFilesInFolder(folderId: string): Promise<void> {
+  private async searchAudioFilesInFolder(folderId: string, excluded: Set<string>, visited: Set<string>): Promise<void> {
+    if (visited.has(folderId)) return;
+    visited.add(folderId);
+    
     try {
-      // Get items in the folder
-      const response = await this.makeGraphRequest(`${GRAPH_API_DRIVE_ENDPOINT}/items/${folderId}/children`);
-      const data = await response.json();
-      
-      // Process each item
-      for (const item of data.value) {
-        if (item.folder) {
-          // Recursively search subfolders
-          await this.searchAudioFilesInFolder(item.id);
-        } else if (item.file) {
-          // Check if it's an audio file
-          const fileExtension = this.getFileExtension(item.name).toLowerCase();
-          if (SUPPORTED_AUDIO_EXTENSIONS.includes(`.${fileExtension}`)) {
-            // Extract filename without extension to use as title if needed
-            const fileName = this.getFileNameWithoutExtension(item.name);
-            
-            // Try to extract artist from filename
-            let artist = undefined;
-            if (fileName.includes('-')) {
-              const parts = fileName.split('-');
-              if (parts.length >= 2) {
-                artist = parts[0].trim();
-              }
+      // Get items in the folder, a page at a time
+      let url: string | null = `${GRAPH_API_DRIVE_ENDPOINT}/items/${folderId}/children?$top=${DRIVE_CHILDREN_PAGE_SIZE}&$select=${CRAWL_SELECT}`;
+      while (url) {
+        const data: any = await this.graphGetJson(url);
+        
+        // Process each item
+        for (const item of data.value) {
+          if (item.folder) {
+            if (excluded.has(item.id)) {
+              logger.info(`Skipping excluded folder ${item.name} (${item.id})`);
+              continue;
             }
             
-            // Generate a simpler ID instead of using UUID
-            const simpleId = `onedrive-${Date.now()}-${Math.floor(Math.random() * 10000)}`;
-            
-            // Create a track object
-            const track: Track = {
-              id: simpleId,
-              title: fileName,
-              uri: item['@microsoft.graph.downloadUrl'] || '',
-              source: 'onedrive',
-              path: item.id,
-              duration: undefined, // We'll get this when playing
-              artist: artist, // Extract from filename if possible
-              album: undefined, // Will be extracted when file is downloaded
-              artwork: undefined // Will be extracted when file is downloaded
-            };
+            // Recursively search subfolders
+            await this.searchAudioFilesInFolder(item.id, excluded, visited);
+          } else if (item.file && this.isAudioItem(item)) {
+            const track = this.createTrackFromItem(item);
             
             // Log the file with clean title
             logger.info(`Found audio file: ${extractCleanTitle(track.title, track.artist)} (${item.id})`);
@@ -994,6 +1899,8 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
             this.tracks.set(track.id, track);
           }
         }
+        
+        url = data['@odata.nextLink'] || null;
       }
     } catch (error) {
       logger.error(`Error searching audio files in folder ${folderId}`, error);
@@ -1001,20 +1908,72 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     }
   }
   
+  /**
+   * Whether a drive item has a supported audio extension
+   */
+  private isAudioItem(item: { name: string }): boolean {
+    const fileExtension = this.getFileExtension(item.name).toLowerCase();
+    return SUPPORTED_AUDIO_EXTENSIONS.includes(`.${fileExtension}`);
+  }
+  
+  /**
+   * Build a track from a drive item
+   */
+  private createTrackFromItem(item: any): Track {
+    // Extract filename without extension to use as title if needed
+    const fileName = this.getFileNameWithoutExtension(item.name);
+    
+    // Try to extract artist from filename
+    let artist = undefined;
+    if (fileName.includes('-')) {
+      const parts = fileName.split('-');
+      if (parts.length >= 2) {
+        artist = parts[0].trim();
+      }
+    }
+    
+    // Derive the ID from the drive item so it survives rescans,
+    // which keeps cache files and play history attached to the track
+    const stableId = `onedrive-${item.id}`;
+    
+    return {
+      id: stableId,
+      title: fileName,
+      uri: item['@microsoft.graph.downloadUrl'] || '',
+      source: 'onedrive',
+      path: item.id,
+      duration: item.audio?.duration || undefined, // Otherwise we'll get this when playing
+      artist: item.audio?.artist || artist, // Extract from filename if possible
+      album: item.audio?.album || undefined, // Will be extracted when file is downloaded
+      artwork: undefined // Will be extracted when file is downloaded
+    };
+  }
+  
   /**
    * Get the download URL for a track
    */
   private async getDownloadUrl(track: Track): Promise<string> {
+    return (await this.getDownloadItem(track)).url;
+  }
+  
+  /**
+   * Get the download URL for a track with the details range requests need
+   */
+  private async getDownloadItem(track: Track): Promise<DownloadItem> {
     try {
       // Get the item from OneDrive
-      const response = await this.makeGraphRequest(`${GRAPH_API_DRIVE_ENDPOINT}/items/${track.path}`);
-      const data = await response.json();
+      const data = await this.graphGetJson(`${GRAPH_API_DRIVE_ENDPOINT}/items/${track.path}`, DOWNLOAD_URL_MAX_AGE_MS);
       
       if (!data['@microsoft.graph.downloadUrl']) {
         throw new Error(`No download URL available for ${extractCleanTitle(track.title, track.artist)}`);
       }
       
-      return data['@microsoft.graph.downloadUrl'];
+      return {
+        url: data['@microsoft.graph.downloadUrl'],
+        eTag: data.eTag,
+        size: data.size || 0,
+        bitrateKbps: data.audio?.bitrate || 0
+      };
     } catch (error) {
       logger.error(`Error getting download URL for ${extractCleanTitle(track.title, track.artist)}`, error);
       throw error;
@@ -1030,7 +1989,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     }
     
     // Check if token is expired or about to expire
-    if (!this.isTokenValid() && this.authResult.refreshToken) {
+    if ((this.connectionState === ConnectionState.EXPIRED || !this.isTokenValid()) && this.authResult.refreshToken) {
       logger.debug('Access token expired or about to expire, refreshing...');
       const refreshSuccess = await this.refreshToken();
       if (!refreshSuccess) {
@@ -1047,6 +2006,50 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
     });
   }
   
+  /**
+   * GET a Graph resource as JSON, revalidating a cached copy with If-None-Match
+   * @param url The resource URL
+   * @param maxBodyAgeMs Refetch without a validator once the cached body is older than this,
+   *   for bodies carrying expiring fields such as download URLs
+   */
+  private async graphGetJson<T = any>(url: string, maxBodyAgeMs?: number): Promise<T> {
+    if (this.isolatedGraph) {
+      return this.isolatedGraph(url);
+    }
+    
+    const cached = await graphResponseCache.get(url);
+    const usable = cached !== null && (maxBodyAgeMs === undefined || Date.now() - cached.storedAt < maxBodyAgeMs);
+    
+    const headers: Record<string, string> = {};
+    if (usable) {
+      headers['If-None-Match'] = cached!.etag;
+    }
+    
+    const response = await this.makeGraphRequest(url, { headers });
+    
+    if (response.status === 304 && usable) {
+      logger.debug(`Graph response not modified: ${url}`);
+      graphResponseCache.touch(url);
+      return JSON.parse(cached!.body);
+    }
+    
+    if (!response.ok) {
+      throw new Error(`Graph request failed with status ${response.status}`);
+    }
+    
+    const body = await response.text();
+    dataBudget.record(body.length, 'graph');
+    const data = JSON.parse(body);
+    
+    // Items carry their ETag in the body as well
+    const etag = response.headers.get('ETag') || data.eTag;
+    if (etag) {
+      graphResponseCache.set(url, etag, body);
+    }
+    
+    return data;
+  }
+  
   /**
    * Ensure the document directory exists
    */
@@ -1077,7 +2080,7 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
   private getFileNameWithoutExtension(filename: string): string {
     return filename.split('.').slice(0, -1).join('.');
   }
-
+  
   /**
    * Download all tracks from OneDrive to local storage
    * Returns a result with success status, number of tracks downloaded, and optional error message
@@ -1106,25 +2109,20 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
       await this.ensureDocumentDirectory();
       
       let downloadedCount = 0;
+      let pausedByBudget = false;
       const errors: string[] = [];
       
       // Download each track
       for (const track of allTracks) {
+        if (!dataBudget.shouldCacheDownloads()) {
+          pausedByBudget = true;
+          logger.info('Stopped downloading all tracks, downloads are paused on this network');
+          break;
+        }
+        
         try {
-          // Extract file extension from the path or title
-          let fileExtension = '';
-          if (track.path && track.path.includes('.')) {
-            fileExtension = `.${this.getFileExtension(track.path)}`;
-          } else if (track.title && track.title.includes('.')) {
-            fileExtension = `.${this.getFileExtension(track.title)}`;
-          } else {
-            // Default to .mp3 if no extension found
-            fileExtension = '.mp3';
-          }
-          
           // Create consistent file name for caching
-          const fileName = `onedrive-${track.id}${fileExtension}`;
-          const docPath = `${ONEDRIVE_DOCUMENT_DIR}${fileName}`;
+          const docPath = await this.getCachePath(track);
           
           // Check if file already exists
           const docInfo = await FileSystem.getInfoAsync(docPath);
@@ -1133,12 +2131,8 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
             continue;
           }
           
-          // Get download URL and download the file
-          const downloadUrl = await this.getDownloadUrl(track);
-          await FileSystem.downloadAsync(downloadUrl, docPath);
-          
-          // Extract metadata and update track
-          await this.extractAndUpdateMetadata(track, docPath);
+          // Download the file, sharing any download already in flight for it
+          await this.downloadToCache(track, docPath, RequestPriority.BACKGROUND);
           
           // Increment counter
           downloadedCount++;
@@ -1148,6 +2142,14 @@ export class OneDriveStorageProvider extends BaseStorageProvider {
         }
       }
       
+      if (pausedByBudget) {
+        return {
+          success: downloadedCount > 0,
+          downloaded: downloadedCount,
+          message: `Downloaded ${downloadedCount} tracks. Downloads are paused on this network by your data settings.`
+        };
+      }
+      
       if (errors.length > 0) {
         return {
           success: downloadedCount > 0,
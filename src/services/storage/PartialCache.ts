@@ -0,0 +1,215 @@
+/**
+ * Partial Cache
+ * File format for audio cached only in part, usually its first seconds
+ *
+ * A partial entry sits next to the complete file it becomes once filled:
+ *   onedrive-<id>.head.mp3       bytes [0, filledBytes) of the file, playable on their own
+ *   onedrive-<id>.mp3.head.json  manifest with the total size and the version it was cut from
+ *   onedrive-<id>.mp3.fill       a range on its way from the server
+ *
+ * Heads are only ever extended from their end, and their length is kept a
+ * multiple of 3 so the base64 of the head and of the remainder can be joined
+ * without decoding either. The join holds both strings and the result in the
+ * JS heap, about 2.7 times the file size, so larger files are refetched whole
+ * instead and their head only served the first seconds of playback.
+ */
+
+import { logger } from '../../utils/logger';
+import { instrumentFileSystem } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('partial-cache');
+
+// Constants
+const MANIFEST_VERSION = 1;
+const HEAD_MARKER = '.head';
+const MANIFEST_SUFFIX = '.head.json';
+const FILL_SUFFIX = '.fill';
+const MAX_JOIN_BYTES = 8 * 1024 * 1024; // largest file assembled in JS from head and remainder
+
+export interface PartialManifest {
+  version: number;
+  totalBytes: number; // 0 when the server did not say
+  filledBytes: number;
+  eTag?: string; // version of the remote file the head was cut from
+  updatedAt: number;
+}
+
+export interface RangeResult {
+  complete: boolean; // the complete file is in place
+  bytes: number; // bytes transferred
+}
+
+/**
+ * Path of the playable head for a complete file path, keeping its extension
+ */
+export const getHeadPath = (path: string): string => {
+  const slash = path.lastIndexOf('/');
+  const dot = path.lastIndexOf('.');
+  return dot > slash ? `${path.slice(0, dot)}${HEAD_MARKER}${path.slice(dot)}` : `${path}${HEAD_MARKER}`;
+};
+
+const getManifestPath = (path: string): string => `${path}${MANIFEST_SUFFIX}`;
+
+const getFillPath = (path: string): string => `${path}${FILL_SUFFIX}`;
+
+/**
+ * File name of the complete file a partial cache file belongs to, null for other files
+ */
+export const getCompleteFileName = (file: string): string | null => {
+  if (file.endsWith(MANIFEST_SUFFIX)) {
+    return file.slice(0, -MANIFEST_SUFFIX.length);
+  }
+  if (file.endsWith(FILL_SUFFIX)) {
+    return file.slice(0, -FILL_SUFFIX.length);
+  }
+  
+  const dot = file.lastIndexOf('.');
+  const stem = dot === -1 ? file : file.slice(0, dot);
+  if (stem.endsWith(HEAD_MARKER)) {
+    return `${stem.slice(0, -HEAD_MARKER.length)}${dot === -1 ? '' : file.slice(dot)}`;
+  }
+  return null;
+};
+
+/**
+ * Round a head length up so it can be joined as base64
+ */
+export const alignHeadBytes = (bytes: number): number => Math.ceil(bytes / 3) * 3;
+
+/**
+ * Read the manifest of a partial entry, dropping entries whose files disagree with it
+ * @param path Path of the complete file
+ */
+export const readPartial = async (path: string): Promise<PartialManifest | null> => {
+  try {
+    const manifestInfo = await FileSystem.getInfoAsync(getManifestPath(path));
+    if (!manifestInfo.exists) {
+      return null;
+    }
+    
+    const manifest = JSON.parse(await FileSystem.readAsStringAsync(getManifestPath(path))) as PartialManifest;
+    const headInfo = await FileSystem.getInfoAsync(getHeadPath(path));
+    if (manifest.version === MANIFEST_VERSION && headInfo.exists && headInfo.size === manifest.filledBytes) {
+      return manifest;
+    }
+    
+    logger.debug(`Dropping inconsistent partial cache entry: ${path}`);
+  } catch (error) {
+    logger.warn(`Failed to read partial cache entry: ${path}`, error);
+  }
+  
+  await removePartial(path);
+  return null;
+};
+
+/**
+ * Fetch the first bytes of a file as a partial entry
+ * A server that ignores the range sends the whole file, which is then kept as complete
+ * @param path Path of the complete file
+ */
+export const fetchHead = async (url: string, path: string, bytes: number, eTag?: string): Promise<RangeResult> => {
+  const fillPath = getFillPath(path);
+  const result = await FileSystem.downloadAsync(url, fillPath, {
+    headers: { Range: `bytes=0-${alignHeadBytes(bytes) - 1}` }
+  });
+  
+  if (result.status === 200) {
+    await FileSystem.moveAsync({ from: fillPath, to: path });
+    return { complete: true, bytes: contentLength(result.headers) };
+  }
+  if (result.status !== 206) {
+    await FileSystem.deleteAsync(fillPath, { idempotent: true });
+    throw new Error(`Head download failed with status ${result.status}`);
+  }
+  
+  const info = await FileSystem.getInfoAsync(fillPath);
+  const received = info.exists ? info.size : 0;
+  const totalBytes = parseContentRangeTotal(result.headers);
+  
+  // The whole file fit in the head
+  if (totalBytes > 0 && received >= totalBytes) {
+    await FileSystem.moveAsync({ from: fillPath, to: path });
+    return { complete: true, bytes: received };
+  }
+  
+  // The head is only joinable when it ends on a multiple of 3
+  if (received % 3 !== 0) {
+    await FileSystem.deleteAsync(fillPath, { idempotent: true });
+    throw new Error(`Head download returned ${received} bytes, not a joinable length`);
+  }
+  
+  await FileSystem.moveAsync({ from: fillPath, to: getHeadPath(path) });
+  const manifest: PartialManifest = {
+    version: MANIFEST_VERSION,
+    totalBytes,
+    filledBytes: received,
+    eTag,
+    updatedAt: Date.now()
+  };
+  await FileSystem.writeAsStringAsync(getManifestPath(path), JSON.stringify(manifest));
+  return { complete: false, bytes: received };
+};
+
+/**
+ * Fetch everything after the head and assemble the complete file
+ * @param path Path of the complete file
+ * @param eTag Current version of the remote file, a head cut from another version is refetched whole
+ */
+export const fillRemainder = async (url: string, path: string, eTag?: string): Promise<RangeResult> => {
+  const manifest = await readPartial(path);
+  const stale = manifest !== null && !!eTag && !!manifest.eTag && manifest.eTag !== eTag;
+  
+  // Files of unknown or large size are downloaded whole by the native side
+  const joinable = manifest !== null && !stale && manifest.totalBytes > 0 && manifest.totalBytes <= MAX_JOIN_BYTES;
+  const start = joinable ? manifest.filledBytes : 0;
+  
+  const fillPath = getFillPath(path);
+  const result = await FileSystem.downloadAsync(url, fillPath, start > 0 ? { headers: { Range: `bytes=${start}-` } } : {});
+  
+  if (result.status < 200 || result.status >= 300) {
+    await FileSystem.deleteAsync(fillPath, { idempotent: true });
+    throw new Error(`Range fill failed with status ${result.status}`);
+  }
+  
+  const bytes = contentLength(result.headers);
+  
+  if (result.status === 206) {
+    // Join as base64, valid because the head length is a multiple of 3
+    const head = await FileSystem.readAsStringAsync(getHeadPath(path), { encoding: FileSystem.EncodingType.Base64 });
+    const rest = await FileSystem.readAsStringAsync(fillPath, { encoding: FileSystem.EncodingType.Base64 });
+    await FileSystem.writeAsStringAsync(fillPath, head + rest, { encoding: FileSystem.EncodingType.Base64 });
+  }
+  
+  // A 200 carries the whole file
+  await FileSystem.moveAsync({ from: fillPath, to: path });
+  await removePartial(path);
+  return { complete: true, bytes };
+};
+
+/**
+ * Delete every file of a partial entry
+ * @param path Path of the complete file
+ */
+export const removePartial = async (path: string): Promise<void> => {
+  await FileSystem.deleteAsync(getManifestPath(path), { idempotent: true });
+  await FileSystem.deleteAsync(getHeadPath(path), { idempotent: true });
+  await FileSystem.deleteAsync(getFillPath(path), { idempotent: true });
+};
+
+const headerValue = (headers: Record<string, string>, name: string): string | undefined => {
+  const key = Object.keys(headers).find(header => header.toLowerCase() === name);
+  return key ? headers[key] : undefined;
+};
+
+const contentLength = (headers: Record<string, string>): number => {
+  return Number(headerValue(headers, 'content-length') || 0);
+};
+
+/**
+ * Total size from a "bytes 0-1023/146515" Content-Range header, 0 when unknown
+ */
+const parseContentRangeTotal = (headers: Record<string, string>): number => {
+  const match = /\/(\d+)\s*$/.exec(headerValue(headers, 'content-range') || '');
+  return match ? Number(match[1]) : 0;
+};
\ No newline at end of file
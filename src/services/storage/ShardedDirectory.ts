@@ -0,0 +1,206 @@
+/**
+ * Sharded Directory
+ * Two-level hash-sharded layout for directories holding many files
+ *
+ * Files live at <root>/<a>/<b>/<name>, where a and b are hex digits of a hash
+ * of the file's key, so 16 x 16 leaf directories each hold a small share of
+ * the files: about 40 each at 10,000 files. Lookups compute the path and never
+ * list a directory; scans walk one leaf at a time.
+ *
+ * Directories written before sharding are migrated once: a file found flat is
+ * moved into its shard when it is looked up, and a maintenance job sweeps the
+ * rest in batches. A layout marker in the root records the finished migration.
+ */
+
+import { logger } from '../../utils/logger';
+import { instrumentFileSystem } from '../../utils/io';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('sharded-dir');
+
+// Constants
+const LAYOUT_VERSION = 1;
+const LAYOUT_FILE_NAME = 'layout.json';
+const SHARD_NAMES = '0123456789abcdef'.split('');
+const MIGRATION_BATCH_SIZE = 200;
+
+export interface ShardedDirectoryOptions {
+  // Files with the same key share a shard, e.g. a download and its partial files
+  keyOf?: (fileName: string) => string;
+  // A flat file was moved into its shard
+  onMoved?: (fileName: string, path: string) => void;
+}
+
+/**
+ * 32-bit FNV-1a, stable across app versions so files stay where they were put
+ */
+const hashKey = (key: string): number => {
+  let hash = 0x811c9dc5;
+  for (let i = 0; i < key.length; i++) {
+    hash ^= key.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+};
+
+export class ShardedDirectory {
+  private knownDirs: Set<string> = new Set();
+  private migrated: Promise<boolean> | null = null;
+  private keyOf: (fileName: string) => string;
+  private onMoved: ((fileName: string, path: string) => void) | null;
+  
+  /**
+   * @param root Directory URI ending in a slash
+   */
+  constructor(private root: string, options: ShardedDirectoryOptions = {}) {
+    this.keyOf = options.keyOf ?? (fileName => fileName);
+    this.onMoved = options.onMoved ?? null;
+  }
+  
+  /**
+   * Path a file belongs at
+   */
+  public pathFor(fileName: string): string {
+    const hash = hashKey(this.keyOf(fileName));
+    return `${this.root}${SHARD_NAMES[hash & 0xf]}/${SHARD_NAMES[(hash >>> 4) & 0xf]}/${fileName}`;
+  }
+  
+  /**
+   * Create the shard directory of a path returned by pathFor, once per session
+   */
+  public async ensureDirectoryFor(path: string): Promise<void> {
+    const dir = path.slice(0, path.lastIndexOf('/') + 1);
+    if (this.knownDirs.has(dir)) return;
+    
+    const info = await FileSystem.getInfoAsync(dir);
+    if (!info.exists) {
+      await FileSystem.makeDirectoryAsync(dir, { intermediates: true });
+    }
+    this.knownDirs.add(dir);
+  }
+  
+  /**
+   * Leaf directories in scan order
+   */
+  public getShardDirs(): string[] {
+    const dirs: string[] = [];
+    for (const a of SHARD_NAMES) {
+      for (const b of SHARD_NAMES) {
+        dirs.push(`${this.root}${a}/${b}/`);
+      }
+    }
+    return dirs;
+  }
+  
+  /**
+   * File names in one leaf directory, empty if it was never created
+   */
+  public async readShard(dir: string): Promise<string[]> {
+    const info = await FileSystem.getInfoAsync(dir);
+    return info.exists ? FileSystem.readDirectoryAsync(dir) : [];
+  }
+  
+  /**
+   * Paths of every file, including flat ones not migrated yet
+   */
+  public async listFiles(): Promise<string[]> {
+    const paths = (await this.listFlatFiles()).map(file => `${this.root}${file}`);
+    for (const dir of this.getShardDirs()) {
+      for (const file of await this.readShard(dir)) {
+        paths.push(`${dir}${file}`);
+      }
+    }
+    return paths;
+  }
+  
+  /**
+   * Names of entries still in the root from before sharding
+   */
+  public async listFlatFiles(): Promise<string[]> {
+    const info = await FileSystem.getInfoAsync(this.root);
+    if (!info.exists) return [];
+    
+    const entries = await FileSystem.readDirectoryAsync(this.root);
+    return entries.filter(entry => entry !== LAYOUT_FILE_NAME && !SHARD_NAMES.includes(entry));
+  }
+  
+  /**
+   * Move a file from before sharding into its shard, if there is one
+   * Failures are logged and left to the sweep, the caller just sees no file
+   * @returns Whether a flat file was moved
+   */
+  public async adopt(fileName: string): Promise<boolean> {
+    if (await this.isMigrated()) return false;
+    
+    try {
+      const info = await FileSystem.getInfoAsync(`${this.root}${fileName}`);
+      if (!info.exists || info.isDirectory) return false;
+      
+      return await this.moveIntoShard(fileName);
+    } catch (error) {
+      logger.warn(`Failed to move ${fileName} into its shard`, error);
+      return false;
+    }
+  }
+  
+  /**
+   * Move one batch of flat files into their shards, recording the layout when none are left
+   * @returns Whether flat files remain
+   */
+  public async migrateStep(): Promise<boolean> {
+    if (await this.isMigrated()) return false;
+    
+    try {
+      const files = await this.listFlatFiles();
+      for (const file of files.slice(0, MIGRATION_BATCH_SIZE)) {
+        const info = await FileSystem.getInfoAsync(`${this.root}${file}`);
+        if (info.exists && !info.isDirectory) {
+          await this.moveIntoShard(file);
+        }
+      }
+      
+      if (files.length > MIGRATION_BATCH_SIZE) {
+        return true;
+      }
+      
+      await FileSystem.makeDirectoryAsync(this.root, { intermediates: true });
+      await FileSystem.writeAsStringAsync(`${this.root}${LAYOUT_FILE_NAME}`, JSON.stringify({ version: LAYOUT_VERSION }));
+      this.migrated = Promise.resolve(true);
+      logger.info(`Migrated ${this.root} to the sharded layout`);
+      return false;
+    } catch (error) {
+      logger.error(`Error migrating ${this.root} to the sharded layout`, error);
+      throw error;
+    }
+  }
+  
+  private async moveIntoShard(fileName: string): Promise<boolean> {
+    const path = this.pathFor(fileName);
+    try {
+      await this.ensureDirectoryFor(path);
+      await FileSystem.moveAsync({ from: `${this.root}${fileName}`, to: path });
+    } catch (error) {
+      // A lookup and the sweep can race for the same file
+      if ((await FileSystem.getInfoAsync(path)).exists) return false;
+      throw error;
+    }
+    
+    this.onMoved?.(fileName, path);
+    return true;
+  }
+  
+  /**
+   * Whether the layout marker is present, read once
+   */
+  private isMigrated(): Promise<boolean> {
+    if (!this.migrated) {
+      this.migrated = FileSystem.getInfoAsync(`${this.root}${LAYOUT_FILE_NAME}`)
+        .then(info => info.exists)
+        .catch(error => {
+          logger.warn(`Failed to read the layout of ${this.root}`, error);
+          return false;
+        });
+    }
+    return this.migrated;
+  }
+}
\ No newline at end of file
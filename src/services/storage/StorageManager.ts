@@ -3,9 +3,11 @@
  * Manages and coordinates different storage providers
  */
 
-import { LocalStorageProvider } from './LocalStorageProvider';
-import { OneDriveStorageProvider } from './OneDriveStorageProvider';
-import { StorageProviderInterface, BaseStorageProvider } from './StorageProvider';
+import { LocalStorageProvider, ImportBatchListener, FolderRescanResult } from './LocalStorageProvider';
+import { OneDriveStorageProvider, DriveBrowsePage } from './OneDriveStorageProvider';
+import { MediaLibraryStorageProvider } from './MediaLibraryStorageProvider';
+import { StorageProviderInterface, BaseStorageProvider, isSessionState } from './StorageProvider';
+import { RequestPriority } from './InFlightRegistry';
 import { Track } from '../../types';
 import { logger } from '../../utils/logger';
 import { ONEDRIVE_CLIENT_ID } from '../../config/onedrive';
@@ -21,11 +23,17 @@ class StorageManager {
     // Initialize built-in providers
     const localProvider = new LocalStorageProvider();
     const oneDriveProvider = new OneDriveStorageProvider();
+    const mediaLibraryProvider = new MediaLibraryStorageProvider();
     
     this.providers.set(localProvider.getId(), localProvider);
     this.providers.set(oneDriveProvider.getId(), oneDriveProvider);
     
-    logger.info('StorageManager initialized with providers: local, onedrive');
+    // Only offered where the platform media library holds music
+    if (mediaLibraryProvider.isAvailable()) {
+      this.providers.set(mediaLibraryProvider.getId(), mediaLibraryProvider);
+    }
+    
+    logger.info(`StorageManager initialized with providers: ${Array.from(this.providers.keys()).join(', ')}`);
   }
   
   public static getInstance(): StorageManager {
@@ -53,6 +61,15 @@ class StorageManager {
         logger.info('Local storage provider initialized');
       }
       
+      // Load the persisted state of the remaining providers once, afterwards their state is event driven
+      await Promise.all(this.getAllProviders().map(async provider => {
+        try {
+          await provider.isConnected();
+        } catch (error) {
+          logger.error(`Error initializing provider: ${provider.getName()}`, error);
+        }
+      }));
+      
       this.initialized = true;
     } catch (error) {
       logger.error('Failed to initialize storage providers', error);
@@ -84,17 +101,10 @@ class StorageManager {
   
   /**
    * Get all connected storage providers
+   * Reads each provider's connection state synchronously, no I/O is performed
    */
-  public async getConnectedProviders(): Promise<BaseStorageProvider[]> {
-    const connectedProviders: BaseStorageProvider[] = [];
-    
-    for (const provider of this.providers.values()) {
-      if (await provider.isConnected()) {
-        connectedProviders.push(provider);
-      }
-    }
-    
-    return connectedProviders;
+  public getConnectedProviders(): BaseStorageProvider[] {
+    return this.getAllProviders().filter(provider => isSessionState(provider.getConnectionState()));
   }
   
   /**
@@ -151,7 +161,7 @@ class StorageManager {
     }
     
     const allTracks: Track[] = [];
-    const connectedProviders = await this.getConnectedProviders();
+    const connectedProviders = this.getConnectedProviders();
     
     for (const provider of connectedProviders) {
       try {
@@ -173,7 +183,7 @@ class StorageManager {
       await this.initialize();
     }
     
-    const connectedProviders = await this.getConnectedProviders();
+    const connectedProviders = this.getConnectedProviders();
     
     for (const provider of connectedProviders) {
       try {
@@ -189,10 +199,76 @@ class StorageManager {
     return null;
   }
   
+  /**
+   * Search connected providers server-side for tracks that may not be in the library yet
+   * Providers without server-side search are skipped; a failing provider doesn't fail the others
+   */
+  public async searchRemote(query: string): Promise<Track[]> {
+    if (!this.initialized) {
+      await this.initialize();
+    }
+    
+    const results: Track[] = [];
+    for (const provider of this.getConnectedProviders()) {
+      if (!(provider instanceof OneDriveStorageProvider)) continue;
+      
+      try {
+        results.push(...await provider.searchDrive(query));
+      } catch (error) {
+        logger.warn(`Remote search failed for provider: ${provider.getName()}`, error);
+      }
+    }
+    
+    return results;
+  }
+  
+  /**
+   * Add a track found by remote search to its provider's library
+   */
+  public async ingestRemoteTrack(track: Track): Promise<Track> {
+    const provider = this.getProvider(track.source);
+    
+    if (!(provider instanceof OneDriveStorageProvider)) {
+      throw new Error(`Provider ${track.source} does not support ingesting search results`);
+    }
+    
+    try {
+      return await provider.ingestTrack(track);
+    } catch (error) {
+      logger.error(`Error ingesting remote track: ${track.title}`, error);
+      throw error;
+    }
+  }
+  
+  /**
+   * List a page of a OneDrive folder, so music can be reached before a sync finishes
+   * @param folderId Folder to list, null for the drive root
+   * @param nextLink Link from the previous page, to continue a listing
+   */
+  public async browseRemoteFolder(folderId: string | null, nextLink: string | null = null): Promise<DriveBrowsePage> {
+    if (!this.initialized) {
+      await this.initialize();
+    }
+    
+    const provider = this.getProvider('onedrive');
+    
+    if (!(provider instanceof OneDriveStorageProvider)) {
+      throw new Error('OneDrive provider not available');
+    }
+    
+    try {
+      return await provider.browseFolder(folderId, nextLink);
+    } catch (error) {
+      logger.error(`Error browsing remote folder: ${folderId || 'root'}`, error);
+      throw error;
+    }
+  }
+  
   /**
    * Get a playable URI for a track
+   * Defaults to interactive priority; prefetchers pass a lower one
    */
-  public async getPlayableUri(track: Track): Promise<string> {
+  public async getPlayableUri(track: Track, priority: RequestPriority = RequestPriority.INTERACTIVE): Promise<string> {
     if (!this.initialized) {
       await this.initialize();
     }
@@ -204,13 +280,38 @@ class StorageManager {
     }
     
     try {
-      return await provider.getAudioFileUri(track);
+      return await provider.getAudioFileUri(track, priority);
     } catch (error) {
       logger.error(`Error getting playable URI for track: ${track.title}`, error);
       throw error;
     }
   }
   
+  /**
+   * Resolve a track's URI ahead of a likely play, without transferring audio
+   * Resolves null when the track still needs a download or stream
+   */
+  public async warmPlayableUri(track: Track): Promise<string | null> {
+    if (!this.initialized) {
+      await this.initialize();
+    }
+    
+    const provider = this.getProvider(track.source);
+    
+    if (!provider) {
+      throw new Error(`Provider not found for track: ${track.id}`);
+    }
+    
+    return provider.warmAudioFileUri(track);
+  }
+  
+  /**
+   * Where playback of a partially cached track continues, null when the URI is the whole file
+   */
+  public getContinuation(track: Track, uri: string): Promise<string> | null {
+    return this.getProvider(track.source)?.getContinuation(uri) ?? null;
+  }
+  
   /**
    * Import audio files from local storage
    */
@@ -235,8 +336,9 @@ class StorageManager {
 
   /**
    * Import audio files from a folder in local storage
+   * Tracks are also handed to onBatch as they are found
    */
-  public async importLocalAudioFilesFromFolder(): Promise<Track[]> {
+  public async importLocalAudioFilesFromFolder(onBatch?: ImportBatchListener): Promise<Track[]> {
     if (!this.initialized) {
       await this.initialize();
     }
@@ -248,12 +350,34 @@ class StorageManager {
     }
     
     try {
-      return await localProvider.importAudioFilesFromFolder();
+      return await localProvider.importAudioFilesFromFolder(onBatch);
     } catch (error) {
       logger.error('Error importing local audio files from folder', error);
       throw error;
     }
   }
+  
+  /**
+   * Rescan the previously imported local folder for added and removed files
+   */
+  public async rescanLocalFolder(onBatch?: ImportBatchListener): Promise<FolderRescanResult> {
+    if (!this.initialized) {
+      await this.initialize();
+    }
+    
+    const localProvider = this.getProvider('local') as LocalStorageProvider;
+    
+    if (!localProvider) {
+      throw new Error('Local storage provider not found');
+    }
+    
+    try {
+      return await localProvider.rescanFolder(onBatch);
+    } catch (error) {
+      logger.error('Error rescanning local folder', error);
+      throw error;
+    }
+  }
 
   /**
    * Extract metadata from a track
@@ -278,11 +402,15 @@ class StorageManager {
           logger.debug(`Metadata extracted for: ${track.title} using LocalStorageProvider`);
         }
       } 
-      // Check if the provider is OneDriveStorageProvider
+      // OneDrive paths are drive item IDs, the provider reads tags itself once a download lands
       else if (provider instanceof OneDriveStorageProvider) {
+        logger.debug(`Metadata for ${track.title} is read by OneDriveStorageProvider after download`);
+      }
+      // Check if the provider is MediaLibraryStorageProvider
+      else if (provider instanceof MediaLibraryStorageProvider) {
         if (track.path) {
-          await (provider as OneDriveStorageProvider).extractAndUpdateMetadata(track, track.path);
-          logger.debug(`Metadata extracted for: ${track.title} using OneDriveStorageProvider`);
+          await provider.extractAndUpdateMetadata(track, track.path);
+          logger.debug(`Metadata extracted for: ${track.title} using MediaLibraryStorageProvider`);
         }
       } else {
         logger.warn(`Provider ${provider.getName()} does not support metadata extraction`);
@@ -293,6 +421,14 @@ class StorageManager {
     }
   }
   
+  /**
+   * Read a track's embedded artwork from a file already on the device, without saving anything
+   */
+  async readTrackArtwork(track: Track): Promise<string | undefined> {
+    const provider = this.getProviderForTrack(track);
+    return provider ? provider.readArtwork(track) : undefined;
+  }
+  
   /**
    * Get the appropriate storage provider for a track
    */
@@ -3,7 +3,23 @@
  * Defines common methods for accessing files across different storage backends
  */
 
-import { Track } from '../../types';
+import MusicInfo from 'expo-music-info-2';
+import { Track, ConnectionState } from '../../types';
+import { logger } from '../../utils/logger';
+import { RequestPriority } from './InFlightRegistry';
+
+export type ConnectionStateListener = (state: ConnectionState, previous: ConnectionState) => void;
+
+/**
+ * Whether a connection state still represents a usable session
+ * Expired, refreshing and offline sessions can serve cached data and recover on their own
+ */
+export const isSessionState = (state: ConnectionState): boolean => {
+  return state === ConnectionState.CONNECTED ||
+    state === ConnectionState.EXPIRED ||
+    state === ConnectionState.REFRESHING ||
+    state === ConnectionState.OFFLINE;
+};
 
 export interface StorageProviderInterface {
   /**
@@ -16,8 +32,20 @@ export interface StorageProviderInterface {
    */
   getId(): string;
   
+  /**
+   * Get the current connection state without any I/O
+   */
+  getConnectionState(): ConnectionState;
+  
+  /**
+   * Subscribe to connection state transitions
+   * Returns an unsubscribe function
+   */
+  onConnectionStateChange(listener: ConnectionStateListener): () => void;
+  
   /**
    * Check if the storage provider is connected and ready
+   * Initializes the provider on first use, afterwards resolves from the cached state
    */
   isConnected(): Promise<boolean>;
   
@@ -44,8 +72,27 @@ export interface StorageProviderInterface {
   /**
    * Get the content URI for an audio file
    * This URI can be used for playback
+   * The priority orders any download needed against other transfers
    */
-  getAudioFileUri(track: Track): Promise<string>;
+  getAudioFileUri(track: Track, priority?: RequestPriority): Promise<string>;
+  
+  /**
+   * Get the content URI ahead of a likely play without transferring any audio
+   * Resolves null when only a transfer could produce it
+   */
+  warmAudioFileUri(track: Track): Promise<string | null>;
+  
+  /**
+   * Where playback continues when a content URI covers only part of the file
+   * Null when the URI is the whole file
+   */
+  getContinuation(uri: string): Promise<string> | null;
+  
+  /**
+   * Read a track's embedded artwork from a file already on the device
+   * Never transfers audio, changes the track or writes provider state
+   */
+  readArtwork(track: Track): Promise<string | undefined>;
 }
 
 /**
@@ -54,6 +101,9 @@ export interface StorageProviderInterface {
 export abstract class BaseStorageProvider implements StorageProviderInterface {
   protected name: string;
   protected id: string;
+  protected connectionState: ConnectionState = ConnectionState.DISCONNECTED;
+  private connectionListeners: Set<ConnectionStateListener> = new Set();
+  private initPromise: Promise<void> | null = null;
   
   constructor(name: string, id: string) {
     this.name = name;
@@ -68,10 +118,109 @@ export abstract class BaseStorageProvider implements StorageProviderInterface {
     return this.id;
   }
   
-  abstract isConnected(): Promise<boolean>;
+  getConnectionState(): ConnectionState {
+    return this.connectionState;
+  }
+  
+  onConnectionStateChange(listener: ConnectionStateListener): () => void {
+    this.connectionListeners.add(listener);
+    return () => {
+      this.connectionListeners.delete(listener);
+    };
+  }
+  
+  async isConnected(): Promise<boolean> {
+    await this.ensureInitialized();
+    return isSessionState(this.connectionState);
+  }
+  
+  /**
+   * Resolving is a local lookup for most providers, so warming is just resolving
+   */
+  async warmAudioFileUri(track: Track): Promise<string | null> {
+    return this.getAudioFileUri(track);
+  }
+  
+  getContinuation(uri: string): Promise<string> | null {
+    return null;
+  }
+  
+  /**
+   * Providers without local files have no artwork to read
+   */
+  async readArtwork(track: Track): Promise<string | undefined> {
+    return undefined;
+  }
+  
+  /**
+   * Read only the picture tag of an audio file
+   */
+  protected async readEmbeddedArtwork(uri: string): Promise<string | undefined> {
+    const metadata = await MusicInfo.getMusicInfoAsync(uri, {
+      title: false,
+      artist: false,
+      album: false,
+      genre: false,
+      picture: true
+    });
+    return metadata?.picture?.pictureData || undefined;
+  }
+  
+  /**
+   * Run initialize() once and share the result with concurrent callers
+   * Once initialized this resolves immediately, so hot paths only pay for a state read
+   */
+  protected ensureInitialized(): Promise<void> {
+    if (!this.initPromise) {
+      if (this.connectionState === ConnectionState.DISCONNECTED) {
+        this.setConnectionState(ConnectionState.CONNECTING);
+      }
+      
+      this.initPromise = this.initialize().catch(error => {
+        this.initPromise = null;
+        this.setConnectionState(ConnectionState.DISCONNECTED);
+        throw error;
+      });
+    }
+    return this.initPromise;
+  }
+  
+  /**
+   * Forget the initialization result so the next access re-initializes
+   */
+  protected resetInitialization(): void {
+    this.initPromise = null;
+  }
+  
+  /**
+   * Transition to a new connection state and notify subscribers
+   */
+  protected setConnectionState(state: ConnectionState): void {
+    if (state === this.connectionState) {
+      return;
+    }
+    
+    const previous = this.connectionState;
+    this.connectionState = state;
+    logger.debug(`${this.name} connection state: ${previous} -> ${state}`);
+    
+    for (const listener of Array.from(this.connectionListeners)) {
+      try {
+        listener(state, previous);
+      } catch (error) {
+        logger.error(`Error in ${this.name} connection state listener`, error);
+      }
+    }
+  }
+  
+  /**
+   * Load persisted provider state
+   * Implementations must leave the provider in its resulting connection state
+   */
+  protected abstract initialize(): Promise<void>;
   abstract connect(): Promise<boolean>;
   abstract disconnect(): Promise<void>;
   abstract listAudioFiles(): Promise<Track[]>;
   abstract getAudioFile(id: string): Promise<Track | null>;
-  abstract getAudioFileUri(track: Track): Promise<string>;
+  abstract getAudioFileUri(track: Track, priority?: RequestPriority): Promise<string>;
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * Sync Scopes
+ * Which OneDrive folders a sync indexes, as include and exclude rules on folders
+ *
+ * The most specific rule above a folder decides it: an excluded folder inside
+ * an included one is skipped, and an included folder inside an excluded one is
+ * synced again. Without any include rule the default music folders in the
+ * drive root are synced, minus the excluded folders.
+ *
+ * Rules keep the folder facet they were chosen from, so the picker can
+ * estimate a scope's size without walking the drive.
+ */
+
+// Constants
+export const DEFAULT_SYNC_FOLDER_NAMES = ['sonora', 'music', 'Music'];
+
+export type SyncScopeMode = 'include' | 'exclude';
+
+export interface DriveFolder {
+  id: string;
+  name: string;
+  path: string; // from the drive root, e.g. /Music/Stems
+  childCount: number; // direct children, from the folder facet
+  size: number; // bytes of everything below it, from Graph
+}
+
+export interface SyncScopeRule extends DriveFolder {
+  mode: SyncScopeMode;
+}
+
+export interface SyncScopeEstimate {
+  bytes: number;
+  folders: number; // included subtrees that are crawled from their own root
+}
+
+/**
+ * Whether a path lies strictly below another
+ */
+const isBelow = (path: string, ancestor: string): boolean => path.startsWith(`${ancestor}/`);
+
+/**
+ * The rules a crawl applies: the user's, or the default folders when none include anything
+ */
+export const getEffectiveRules = (rules: SyncScopeRule[], defaultFolders: DriveFolder[]): SyncScopeRule[] => {
+  if (rules.some(rule => rule.mode === 'include')) return rules;
+  
+  const defaults = defaultFolders
+    .filter(folder => !rules.some(rule => rule.id === folder.id))
+    .map(folder => ({ ...folder, mode: 'include' as SyncScopeMode }));
+  return [...defaults, ...rules];
+};
+
+/**
+ * The nearest rule on a folder or above it
+ */
+export const findGoverningRule = (path: string, rules: SyncScopeRule[], strict: boolean = false): SyncScopeRule | null => {
+  let governing: SyncScopeRule | null = null;
+  for (const rule of rules) {
+    const applies = isBelow(path, rule.path) || (!strict && rule.path === path);
+    if (applies && (!governing || rule.path.length > governing.path.length)) {
+      governing = rule;
+    }
+  }
+  return governing;
+};
+
+/**
+ * Bytes a sync with these rules would index, from the sizes recorded on the rules
+ */
+export const estimateSyncScope = (rules: SyncScopeRule[]): SyncScopeEstimate => {
+  let bytes = 0;
+  let folders = 0;
+  
+  for (const rule of rules) {
+    const parentMode = findGoverningRule(rule.path, rules, true)?.mode ?? 'exclude';
+    if (rule.mode === 'include' && parentMode === 'exclude') {
+      bytes += rule.size;
+      folders++;
+    } else if (rule.mode === 'exclude' && parentMode === 'include') {
+      bytes -= rule.size;
+    }
+  }
+  
+  return { bytes: Math.max(0, bytes), folders };
+};
+
+/**
+ * Path of a Graph drive item's parent folder from the drive root, null when Graph did not include it
+ */
+export const getParentPath = (item: any): string | null => {
+  if (typeof item.parentReference?.path !== 'string') return null;
+  
+  // parentReference.path looks like /drive/root:/Music, percent-encoded
+  const rawParent = item.parentReference.path.replace(/^.*?root:/, '');
+  try {
+    return decodeURIComponent(rawParent);
+  } catch (decodeError) {
+    // Keep the encoded path, it still nests correctly
+    return rawParent;
+  }
+};
+
+/**
+ * Build a folder from a Graph drive item with a folder facet
+ */
+export const toDriveFolder = (item: any): DriveFolder => {
+  const parentPath = getParentPath(item) ?? '';
+  
+  return {
+    id: item.id,
+    name: item.name,
+    path: `${parentPath}/${item.name}`,
+    childCount: item.folder?.childCount || 0,
+    size: item.size || 0
+  };
+};
\ No newline at end of file
@@ -5,19 +5,40 @@
 import { create } from 'zustand';
 import { Track, Playlist, PlayerState, AppSettings, LogLevel } from '../types';
 import { storageManager } from '../services/storage/StorageManager';
+import { DriveBrowsePage } from '../services/storage/OneDriveStorageProvider';
+import { MediaLibraryStorageProvider } from '../services/storage/MediaLibraryStorageProvider';
+import { catalog } from '../services/catalog/Catalog';
+import { taskScheduler, TaskPriority } from '../services/scheduler/TaskScheduler';
+import { predictivePrecacher } from '../services/prefetch/PredictivePrecacher';
+import { maintenanceScheduler } from '../services/scheduler/MaintenanceScheduler';
+import { dataBudget } from '../services/network/DataBudget';
 import { logger } from '../utils/logger';
-import AsyncStorage from '@react-native-async-storage/async-storage';
+import { tracing } from '../utils/tracing';
 import { usePlayerStore } from './playerStore';
+import { instrumentAsyncStorage } from '../utils/io';
+
+// Instrumented native I/O, see utils/io
+const AsyncStorage = instrumentAsyncStorage('library-store');
 
 // Constants
 const PLAYLISTS_STORAGE_KEY = '@sonora/playlists';
 const SETTINGS_STORAGE_KEY = '@sonora/settings';
+const TRACKS_REFRESH_MS = 50;
+const TRACK_ORDER_FIELDS: (keyof Track)[] = ['title', 'artist'];
+
+// Artwork the catalog doesn't hold is read from the track's file when a row shows it
+// A read-only lookup: showing a row never re-parses tags into or rewrites the saved library
+catalog.setColdFieldLoader(async (track) => {
+  const artwork = await storageManager.readTrackArtwork(track);
+  return artwork ? { artwork } : null;
+});
 
 // Default settings
 const DEFAULT_SETTINGS: AppSettings = {
   theme: 'system',
   audioQuality: 'auto',
   downloadStrategy: 'wifi-only',
+  cellularDataBudgetMb: 0,
   logLevel: LogLevel.INFO,
   oneDriveSync: {
     enabled: false,
@@ -30,6 +51,7 @@ const DEFAULT_SETTINGS: AppSettings = {
 interface AppState {
   // Library state
   tracks: Track[];
+  tracksOrderVersion: number; // bumped when a title or artist changes, which can move a track in sorted lists
   playlists: Playlist[];
   isLibraryLoading: boolean;
   
@@ -48,10 +70,15 @@ interface AppState {
   removeTrackFromPlaylist: (playlistId: string, trackId: string) => Promise<void>;
   importLocalTracks: () => Promise<void>;
   importLocalTracksFromFolder: () => Promise<Track[]>;
+  rescanLocalFolder: () => Promise<Track[]>;
+  ingestRemoteTrack: (track: Track) => Promise<Track>;
+  browseRemoteFolder: (folderId: string | null, nextLink?: string | null) => Promise<DriveBrowsePage>;
   
   // Actions - Player
   playTrack: (track: Track) => Promise<void>;
   playPlaylist: (playlist: Playlist, startIndex?: number) => Promise<void>;
+  warmUpTrack: (track: Track) => void;
+  releaseWarmUp: (track: Track) => void;
   togglePlayPause: () => Promise<void>;
   nextTrack: () => Promise<void>;
   previousTrack: () => Promise<void>;
@@ -66,6 +93,7 @@ interface AppState {
 export const useStore = create<AppState>((set, get) => ({
   // Initial state
   tracks: [],
+  tracksOrderVersion: 0,
   playlists: [],
   isLibraryLoading: false,
   get playerState() {
@@ -81,8 +109,14 @@ export const useStore = create<AppState>((set, get) => ({
       // Initialize storage manager if not already
       await storageManager.initialize();
       
-      // Load tracks from all active providers
-      const tracks = await storageManager.getAllTracks();
+      // Load tracks from all active providers into the compact catalog, in time slices
+      const tracks = await tracing.trace('library-load', async () => {
+        const providerTracks = await storageManager.getAllTracks();
+        return taskScheduler.run(() => catalog.replaceAllInSlices(providerTracks), {
+          priority: TaskPriority.BACKGROUND,
+          label: 'catalog-merge'
+        });
+      });
       
       // Load playlists from AsyncStorage
       const playlistsJson = await AsyncStorage.getItem(PLAYLISTS_STORAGE_KEY);
@@ -96,9 +130,25 @@ export const useStore = create<AppState>((set, get) => ({
       
       // Apply settings
       logger.setLogLevel(settings.logLevel);
+      dataBudget.configure(settings);
+      dataBudget.start();
       
       set({ tracks, playlists, settings, isLibraryLoading: false });
       logger.info(`Loaded ${tracks.length} tracks and ${playlists.length} playlists`);
+      
+      // Precache likely plays whenever an unmetered network is available
+      predictivePrecacher.start();
+      
+      // Housekeeping waits for idle or background time
+      maintenanceScheduler.register({
+        id: 'log-rotation',
+        intervalMs: 24 * 60 * 60 * 1000,
+        step: async () => {
+          await logger.rotateIfNeeded();
+          return null;
+        }
+      });
+      maintenanceScheduler.start();
     } catch (error) {
       logger.error('Error loading library', error);
       set({ isLibraryLoading: false });
@@ -221,18 +271,12 @@ export const useStore = create<AppState>((set, get) => ({
       set({ isLibraryLoading: true });
       
       // Import tracks from local storage
-      const newTracks = await storageManager.importLocalAudioFiles();
-      
-      // Merge with existing tracks
-      const existingTracks = get().tracks;
-      const allTracks = [...existingTracks, ...newTracks];
+      const newTracks = await tracing.trace('import', () => storageManager.importLocalAudioFiles());
       
-      // Remove duplicates by ID
-      const uniqueTracks = Array.from(
-        new Map(allTracks.map(track => [track.id, track])).values()
-      );
+      // Merge into the catalog, which deduplicates by ID
+      catalog.upsert(newTracks);
       
-      set({ tracks: uniqueTracks, isLibraryLoading: false });
+      set({ tracks: catalog.tracks(), isLibraryLoading: false });
       logger.info(`Imported ${newTracks.length} tracks from local storage`);
     } catch (error) {
       logger.error('Error importing local tracks', error);
@@ -245,19 +289,15 @@ export const useStore = create<AppState>((set, get) => ({
     try {
       set({ isLibraryLoading: true });
       
-      // Import tracks from folder
-      const newTracks = await storageManager.importLocalAudioFilesFromFolder();
+      // Import tracks from folder, the change feed shows each batch as soon as it is ready
+      const newTracks = await tracing.trace('import', () => storageManager.importLocalAudioFilesFromFolder(batch => {
+        catalog.upsert(batch);
+      }), { folder: true });
       
-      // Merge with existing tracks
-      const existingTracks = get().tracks;
-      const allTracks = [...existingTracks, ...newTracks];
-      
-      // Remove duplicates by ID
-      const uniqueTracks = Array.from(
-        new Map(allTracks.map(track => [track.id, track])).values()
-      );
+      // Merge into the catalog, which deduplicates by ID
+      catalog.upsert(newTracks);
       
-      set({ tracks: uniqueTracks, isLibraryLoading: false });
+      set({ tracks: catalog.tracks(), isLibraryLoading: false });
       logger.info(`Imported ${newTracks.length} tracks from folder`);
       return newTracks;
     } catch (error) {
@@ -267,13 +307,67 @@ export const useStore = create<AppState>((set, get) => ({
     }
   },
   
+  rescanLocalFolder: async () => {
+    try {
+      set({ isLibraryLoading: true });
+      
+      const { added, removedIds } = await tracing.trace('import', () => storageManager.rescanLocalFolder(batch => {
+        catalog.upsert(batch);
+      }), { folder: true, rescan: true });
+      
+      catalog.upsert(added);
+      removedIds.forEach(id => catalog.remove(id));
+      
+      set({ tracks: catalog.tracks(), isLibraryLoading: false });
+      logger.info(`Folder rescan added ${added.length} and removed ${removedIds.length} tracks`);
+      return added;
+    } catch (error) {
+      logger.error('Error rescanning local folder', error);
+      set({ isLibraryLoading: false });
+      throw error;
+    }
+  },
+  
+  ingestRemoteTrack: async (track: Track) => {
+    try {
+      const ingested = await storageManager.ingestRemoteTrack(track);
+      
+      catalog.upsert([ingested]);
+      return ingested;
+    } catch (error) {
+      logger.error(`Error adding remote track to library: ${track.title}`, error);
+      throw error;
+    }
+  },
+  
+  browseRemoteFolder: async (folderId: string | null, nextLink: string | null = null) => {
+    try {
+      const page = await storageManager.browseRemoteFolder(folderId, nextLink);
+      
+      // Browsed tracks join the library a page at a time
+      catalog.upsert(page.tracks);
+      return page;
+    } catch (error) {
+      logger.error(`Error browsing remote folder: ${folderId || 'root'}`, error);
+      throw error;
+    }
+  },
+  
   // Player actions - delegate to playerStore
   playTrack: async (track: Track) => {
     return usePlayerStore.getState().playTrack(track);
   },
   
-  playPlaylist: async (playlist: Playlist) => {
-    return usePlayerStore.getState().playPlaylist(playlist);
+  playPlaylist: async (playlist: Playlist, startIndex?: number) => {
+    return usePlayerStore.getState().playPlaylist(playlist, startIndex);
+  },
+  
+  warmUpTrack: (track: Track) => {
+    usePlayerStore.getState().warmUpTrack(track);
+  },
+  
+  releaseWarmUp: (track: Track) => {
+    usePlayerStore.getState().releaseWarmUp(track);
   },
   
   togglePlayPause: async () => {
@@ -311,6 +405,7 @@ export const useStore = create<AppState>((set, get) => ({
       
       // Apply settings
       logger.setLogLevel(newSettings.logLevel);
+      dataBudget.configure(newSettings);
       
       set({ settings: newSettings });
       logger.info('Updated app settings');
@@ -319,4 +414,33 @@ export const useStore = create<AppState>((set, get) => ({
       throw error;
     }
   }
-}));
\ No newline at end of file
+}));
+
+// Mirror the catalog change feed into the track list, coalesced so bulk changes render once
+// Tracks are live catalog views, so sorted lists only need rebuilding when the order can change
+let tracksRefreshTimer: NodeJS.Timeout | null = null;
+let tracksOrderChanged = false;
+catalog.subscribe(batch => {
+  if (!tracksOrderChanged) {
+    tracksOrderChanged = batch.reset || batch.changes.some(change =>
+      change.type !== 'update' || change.fields.some(field => TRACK_ORDER_FIELDS.includes(field))
+    );
+  }
+  if (tracksRefreshTimer) return;
+  tracksRefreshTimer = setTimeout(() => {
+    tracksRefreshTimer = null;
+    const orderChanged = tracksOrderChanged;
+    tracksOrderChanged = false;
+    useStore.setState(state => ({
+      tracks: catalog.tracks(),
+      tracksOrderVersion: orderChanged ? state.tracksOrderVersion + 1 : state.tracksOrderVersion
+    }));
+  }, TRACKS_REFRESH_MS);
+});
+
+// The device library changes outside the app, fold its updates into the catalog as they arrive
+const mediaLibraryProvider = storageManager.getProvider('media-library') as MediaLibraryStorageProvider | undefined;
+mediaLibraryProvider?.onTracksChanged(({ added, removedIds }) => {
+  catalog.upsert(added);
+  removedIds.forEach(id => catalog.remove(id));
+});
\ No newline at end of file
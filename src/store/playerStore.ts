@@ -5,8 +5,12 @@
 
 import { create } from 'zustand';
 import { Track, Playlist, PlayerState } from '../types';
-import { playerService } from '../services/player/PlayerService';
+import { playerService } from '../services/player/AppPlayer';
 import { storageManager } from '../services/storage/StorageManager';
+import { toPlainTrack } from '../services/catalog/Catalog';
+import { predictivePrecacher } from '../services/prefetch/PredictivePrecacher';
+import { headPrefetcher } from '../services/prefetch/HeadPrefetcher';
+import { userActivity } from '../services/scheduler/UserActivity';
 import { logger } from '../utils/logger';
 
 interface PlayerStore {
@@ -16,6 +20,8 @@ interface PlayerStore {
   // Actions
   playTrack: (track: Track) => Promise<void>;
   playPlaylist: (playlist: Playlist, startIndex?: number) => Promise<void>;
+  warmUpTrack: (track: Track) => void;
+  releaseWarmUp: (track: Track) => void;
   togglePlayPause: () => Promise<void>;
   nextTrack: () => Promise<void>;
   previousTrack: () => Promise<void>;
@@ -42,19 +48,24 @@ export const usePlayerStore = create<PlayerStore>((set, get) => ({
     try {
       logger.info(`Playing track: ${track.title}`);
       
+      // Keep maintenance work out of the way of starting playback
+      userActivity.markActive();
+      
       // Get playable URI from storage manager
       const uri = await storageManager.getPlayableUri(track);
-      const trackWithUri = { ...track, uri };
+      const trackWithUri = { ...toPlainTrack(track), uri };
       
       // Play the track
       await playerService.play(trackWithUri);
       
-      // Update player state
+      // Update player state, keeping the queue when the track is part of it
+      const currentQueue = get().playerState.queue;
+      const inQueue = currentQueue.some(t => t.id === track.id);
       set({
         playerState: {
           ...get().playerState,
           currentTrack: trackWithUri,
-          queue: [trackWithUri],
+          queue: inQueue ? currentQueue : [trackWithUri],
           isPlaying: true,
           currentPosition: 0
         }
@@ -73,11 +84,18 @@ export const usePlayerStore = create<PlayerStore>((set, get) => ({
           });
           
           // Handle playback completion
+          // Only reached when the player had nothing preloaded to advance to on its own
           if (status.didJustFinish) {
             get().nextTrack();
           }
         }
       });
+      
+      // Arm the player's queue window for the next transition
+      syncUpcomingTracks();
+      
+      // Feed the play history behind predictive precaching
+      predictivePrecacher.notePlayed(track);
     } catch (error) {
       logger.error(`Error playing track: ${track.title}`, error);
       throw error;
@@ -258,10 +276,21 @@ export const usePlayerStore = create<PlayerStore>((set, get) => ({
         repeatMode: modes[nextIndex]
       }
     });
+    syncUpcomingTracks();
     
     logger.debug(`Repeat mode set to: ${modes[nextIndex]}`);
   },
   
+  // Start loading a track on touch-down, playTrack adopts it if the tap completes
+  warmUpTrack: (track: Track) => {
+    playerService.warmUp(toPlainTrack(track));
+  },
+  
+  // The touch ended, the warm-up is dropped unless a play claims it
+  releaseWarmUp: (track: Track) => {
+    playerService.releaseWarmUp(track);
+  },
+  
   // Toggle shuffle mode
   toggleShuffle: () => {
     const { playerState } = get();
@@ -289,6 +318,7 @@ export const usePlayerStore = create<PlayerStore>((set, get) => ({
       });
     }
     
+    syncUpcomingTracks();
     logger.debug(`Shuffle mode set to: ${newShuffleMode}`);
   },
   
@@ -303,6 +333,53 @@ export const usePlayerStore = create<PlayerStore>((set, get) => ({
   }
 }));
 
+// The player advances through its queue window without waiting for the store;
+// mirror the transition here once it has already happened
+playerService.setOnTrackAdvanced((track) => {
+  const { playerState } = usePlayerStore.getState();
+  usePlayerStore.setState({
+    playerState: {
+      ...playerState,
+      currentTrack: track,
+      isPlaying: true,
+      currentPosition: 0
+    }
+  });
+  logger.debug(`Player advanced to: ${track.title}`);
+  syncUpcomingTracks();
+  predictivePrecacher.notePlayed(track);
+});
+
+// Tracks that follow the current one, honoring the repeat mode
+function getUpcomingTracks(playerState: PlayerState): Track[] {
+  const { queue, currentTrack, repeatMode } = playerState;
+  
+  if (!currentTrack || queue.length === 0) {
+    return [];
+  }
+  
+  if (repeatMode === 'track') {
+    return [currentTrack];
+  }
+  
+  const currentIndex = queue.findIndex(t => t.id === currentTrack.id);
+  const upcoming = queue.slice(currentIndex + 1);
+  if (repeatMode === 'queue') {
+    upcoming.push(...queue.slice(0, currentIndex + 1));
+  }
+  return upcoming;
+}
+
+// Hand the upcoming tracks to the player so it can preload the next one,
+// and fetch the heads of the ones after it
+function syncUpcomingTracks(): void {
+  const upcoming = getUpcomingTracks(usePlayerStore.getState().playerState);
+  playerService.setUpcomingTracks(upcoming).catch(error => {
+    logger.warn('Error updating upcoming tracks', error);
+  });
+  headPrefetcher.request('queue', upcoming);
+}
+
 // Helper function to shuffle an array
 function shuffleArray<T>(array: T[]): T[] {
   const newArray = [...array];
@@ -11,7 +11,7 @@ export interface Track {
   duration?: number; // in milliseconds
   uri: string;
   artwork?: string;
-  source: 'local' | 'onedrive';
+  source: 'local' | 'onedrive' | 'media-library';
   path?: string; // file path for local files or OneDrive path
 }
 
@@ -39,11 +39,21 @@ export interface PlayerState {
 export interface StorageProvider {
   name: string;
   id: string;
-  type: 'local' | 'onedrive';
+  type: 'local' | 'onedrive' | 'media-library';
   isConnected: boolean;
   icon: string; // icon name or path
 }
 
+// Storage provider connection lifecycle
+export enum ConnectionState {
+  DISCONNECTED = 'disconnected',
+  CONNECTING = 'connecting',
+  CONNECTED = 'connected',
+  EXPIRED = 'expired', // session exists but the access token needs a refresh
+  REFRESHING = 'refreshing',
+  OFFLINE = 'offline' // session exists but the network is unreachable
+}
+
 // OneDrive authentication types
 export interface OneDriveAuthConfig {
   clientId: string;
@@ -70,6 +80,7 @@ export interface AppSettings {
   theme: 'light' | 'dark' | 'system';
   audioQuality: 'auto' | 'high' | 'medium' | 'low';
   downloadStrategy: 'wifi-only' | 'always' | 'never';
+  cellularDataBudgetMb: number; // monthly, 0 for no budget
   logLevel: LogLevel;
   oneDriveSync: {
     enabled: boolean;
@@ -0,0 +1,255 @@
+/**
+ * I/O accounting
+ * Thin instrumented wrappers around expo-file-system, AsyncStorage and expo-av
+ *
+ * Every call is recorded per call site (the module that made it) with counts,
+ * errors, bytes, durations and concurrency. Totals also go to metrics, and the
+ * current tracing span is charged with the calls made inside it.
+ *
+ * Modules create their wrapper once and keep their existing call style:
+ *   const FileSystem = instrumentFileSystem('onedrive');
+ */
+
+import * as ExpoFileSystem from 'expo-file-system';
+import RNAsyncStorage from '@react-native-async-storage/async-storage';
+import { metrics } from './metrics';
+import { tracing } from './tracing';
+
+export type IoApi = 'fs' | 'storage' | 'av';
+
+export interface IoCallStats {
+  calls: number;
+  errors: number;
+  bytesRead: number;
+  bytesWritten: number;
+  totalMs: number;
+  maxMs: number;
+  inFlight: number;
+  maxInFlight: number;
+}
+
+export interface IoSnapshot {
+  // Keyed by "site:api.method"
+  calls: Record<string, IoCallStats>;
+  // Peak concurrent calls per API
+  maxInFlightByApi: Record<string, number>;
+}
+
+interface ByteCounters<T> {
+  written?: number;
+  read?: (result: T) => number;
+}
+
+class IoAccounting {
+  private static instance: IoAccounting;
+  private stats: Map<string, IoCallStats> = new Map();
+  private inFlightByApi: Map<IoApi, number> = new Map();
+  private maxInFlightByApi: Map<IoApi, number> = new Map();
+
+  private constructor() {}
+
+  public static getInstance(): IoAccounting {
+    if (!IoAccounting.instance) {
+      IoAccounting.instance = new IoAccounting();
+    }
+    return IoAccounting.instance;
+  }
+
+  /**
+   * Run and record a native I/O call
+   */
+  public async track<T>(site: string, api: IoApi, method: string, call: () => Promise<T>, bytes: ByteCounters<T> = {}): Promise<T> {
+    const key = `${site}:${api}.${method}`;
+    const entry = this.getEntry(key);
+
+    entry.calls++;
+    entry.inFlight++;
+    entry.maxInFlight = Math.max(entry.maxInFlight, entry.inFlight);
+
+    const apiInFlight = (this.inFlightByApi.get(api) || 0) + 1;
+    this.inFlightByApi.set(api, apiInFlight);
+    if (apiInFlight > (this.maxInFlightByApi.get(api) || 0)) {
+      this.maxInFlightByApi.set(api, apiInFlight);
+      metrics.setGauge(`io.${api}.max_in_flight`, apiInFlight);
+    }
+
+    const span = tracing.getCurrentSpan();
+    const start = performance.now();
+    let bytesRead = 0;
+
+    try {
+      const result = await call();
+      if (bytes.read) {
+        bytesRead = bytes.read(result);
+      }
+      return result;
+    } catch (error) {
+      entry.errors++;
+      metrics.increment(`io.${api}.errors`);
+      throw error;
+    } finally {
+      const duration = performance.now() - start;
+      const bytesWritten = bytes.written || 0;
+
+      entry.inFlight--;
+      entry.totalMs += duration;
+      entry.maxMs = Math.max(entry.maxMs, duration);
+      entry.bytesRead += bytesRead;
+      entry.bytesWritten += bytesWritten;
+      this.inFlightByApi.set(api, (this.inFlightByApi.get(api) || 1) - 1);
+
+      metrics.increment(`io.${api}.calls`);
+      metrics.increment(`io.${api}.bytes_read`, bytesRead);
+      metrics.increment(`io.${api}.bytes_written`, bytesWritten);
+      metrics.observe(`io.${api}.${method}.ms`, duration);
+
+      if (span) {
+        span.addCount(`io.${api}.calls`);
+        span.addCount(`io.${api}.ms`, duration);
+        if (bytesRead) span.addCount(`io.${api}.bytes_read`, bytesRead);
+        if (bytesWritten) span.addCount(`io.${api}.bytes_written`, bytesWritten);
+      }
+    }
+  }
+
+  /**
+   * Copy of the per call site statistics
+   */
+  public getSnapshot(): IoSnapshot {
+    const calls: Record<string, IoCallStats> = {};
+    this.stats.forEach((entry, key) => {
+      calls[key] = { ...entry };
+    });
+
+    return {
+      calls,
+      maxInFlightByApi: Object.fromEntries(this.maxInFlightByApi)
+    };
+  }
+
+  /**
+   * Clear the statistics, e.g. before a benchmark run
+   * Calls still in flight keep being counted for concurrency
+   */
+  public reset(): void {
+    this.stats.forEach((entry, key) => {
+      if (entry.inFlight === 0) {
+        this.stats.delete(key);
+      } else {
+        this.stats.set(key, { ...this.emptyStats(), inFlight: entry.inFlight, maxInFlight: entry.inFlight });
+      }
+    });
+    this.maxInFlightByApi.clear();
+  }
+
+  private getEntry(key: string): IoCallStats {
+    let entry = this.stats.get(key);
+    if (!entry) {
+      entry = this.emptyStats();
+      this.stats.set(key, entry);
+    }
+    return entry;
+  }
+
+  private emptyStats(): IoCallStats {
+    return { calls: 0, errors: 0, bytesRead: 0, bytesWritten: 0, totalMs: 0, maxMs: 0, inFlight: 0, maxInFlight: 0 };
+  }
+}
+
+// Export singleton instance
+export const ioAccounting = IoAccounting.getInstance();
+
+/**
+ * expo-file-system with every native call recorded under the given site
+ */
+export const instrumentFileSystem = (site: string) => {
+  const track = ioAccounting.track.bind(ioAccounting);
+
+  return {
+    documentDirectory: ExpoFileSystem.documentDirectory,
+    cacheDirectory: ExpoFileSystem.cacheDirectory,
+    EncodingType: ExpoFileSystem.EncodingType,
+    StorageAccessFramework: ExpoFileSystem.StorageAccessFramework,
+
+    getInfoAsync: (...args: Parameters<typeof ExpoFileSystem.getInfoAsync>) =>
+      track(site, 'fs', 'getInfoAsync', () => ExpoFileSystem.getInfoAsync(...args)),
+
+    readAsStringAsync: (...args: Parameters<typeof ExpoFileSystem.readAsStringAsync>) =>
+      track(site, 'fs', 'readAsStringAsync', () => ExpoFileSystem.readAsStringAsync(...args), {
+        read: contents => contents.length
+      }),
+
+    writeAsStringAsync: (...args: Parameters<typeof ExpoFileSystem.writeAsStringAsync>) =>
+      track(site, 'fs', 'writeAsStringAsync', () => ExpoFileSystem.writeAsStringAsync(...args), {
+        written: args[1].length
+      }),
+
+    deleteAsync: (...args: Parameters<typeof ExpoFileSystem.deleteAsync>) =>
+      track(site, 'fs', 'deleteAsync', () => ExpoFileSystem.deleteAsync(...args)),
+
+    moveAsync: (...args: Parameters<typeof ExpoFileSystem.moveAsync>) =>
+      track(site, 'fs', 'moveAsync', () => ExpoFileSystem.moveAsync(...args)),
+
+    copyAsync: (...args: Parameters<typeof ExpoFileSystem.copyAsync>) =>
+      track(site, 'fs', 'copyAsync', () => ExpoFileSystem.copyAsync(...args)),
+
+    makeDirectoryAsync: (...args: Parameters<typeof ExpoFileSystem.makeDirectoryAsync>) =>
+      track(site, 'fs', 'makeDirectoryAsync', () => ExpoFileSystem.makeDirectoryAsync(...args)),
+
+    readDirectoryAsync: (...args: Parameters<typeof ExpoFileSystem.readDirectoryAsync>) =>
+      track(site, 'fs', 'readDirectoryAsync', () => ExpoFileSystem.readDirectoryAsync(...args)),
+
+    downloadAsync: (...args: Parameters<typeof ExpoFileSystem.downloadAsync>) =>
+      track(site, 'fs', 'downloadAsync', () => ExpoFileSystem.downloadAsync(...args), {
+        read: result => Number(result.headers['Content-Length'] || result.headers['content-length'] || 0)
+      })
+  };
+};
+
+/**
+ * AsyncStorage with every call recorded under the given site
+ */
+export const instrumentAsyncStorage = (site: string) => {
+  const track = ioAccounting.track.bind(ioAccounting);
+
+  return {
+    getItem: (key: string) =>
+      track(site, 'storage', 'getItem', () => RNAsyncStorage.getItem(key), {
+        read: value => (value ? value.length : 0)
+      }),
+
+    setItem: (key: string, value: string) =>
+      track(site, 'storage', 'setItem', () => RNAsyncStorage.setItem(key, value), {
+        written: value.length
+      }),
+
+    removeItem: (key: string) =>
+      track(site, 'storage', 'removeItem', () => RNAsyncStorage.removeItem(key))
+  };
+};
+
+/**
+ * Wrap a loaded sound so its native calls are recorded under the given site
+ * Accepts anything shaped like expo-av's Sound and returns the same shape
+ */
+export const instrumentSound = <S extends {
+  playAsync(): Promise<unknown>;
+  pauseAsync(): Promise<unknown>;
+  stopAsync(): Promise<unknown>;
+  unloadAsync(): Promise<unknown>;
+  setPositionAsync(positionMillis: number): Promise<unknown>;
+  getStatusAsync(): Promise<any>;
+  setOnPlaybackStatusUpdate(listener: ((status: any) => void) | null): void;
+}>(sound: S, site: string): S => {
+  const track = ioAccounting.track.bind(ioAccounting);
+
+  return {
+    playAsync: () => track(site, 'av', 'playAsync', () => sound.playAsync()),
+    pauseAsync: () => track(site, 'av', 'pauseAsync', () => sound.pauseAsync()),
+    stopAsync: () => track(site, 'av', 'stopAsync', () => sound.stopAsync()),
+    unloadAsync: () => track(site, 'av', 'unloadAsync', () => sound.unloadAsync()),
+    setPositionAsync: (positionMillis: number) => track(site, 'av', 'setPositionAsync', () => sound.setPositionAsync(positionMillis)),
+    getStatusAsync: () => track(site, 'av', 'getStatusAsync', () => sound.getStatusAsync()),
+    setOnPlaybackStatusUpdate: (listener: ((status: any) => void) | null) => sound.setOnPlaybackStatusUpdate(listener)
+  } as unknown as S;
+};
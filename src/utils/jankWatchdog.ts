@@ -0,0 +1,237 @@
+/**
+ * Jank watchdog
+ * Measures JS event-loop lag and dropped frames, and attributes long tasks to tracing spans
+ *
+ * A cheap timer expects to fire every tick; when it fires late the JS thread
+ * was blocked for the difference. The stall is charged to the spans that were
+ * open or finished inside the blocked window, so a report says "search blocked
+ * for 340ms" rather than just "the app froze".
+ */
+
+import { AppState, AppStateStatus } from 'react-native';
+import { logger } from './logger';
+import { metrics } from './metrics';
+import { tracing } from './tracing';
+
+// Constants
+const TICK_MS = 100;
+const LONG_TASK_MS = 100; // lag beyond this is recorded as a stall
+const LOGGED_STALL_MS = 500; // stalls this long are also written to the log
+const FRAME_MS = 1000 / 60;
+const MAX_STALLS = 100;
+
+export interface StallRecord {
+  at: number; // epoch milliseconds
+  durationMs: number;
+  openSpans: string[];
+  overlappingSpans: string[];
+}
+
+export interface JankStats {
+  running: boolean;
+  samples: number;
+  maxLagMs: number;
+  totalLagMs: number;
+  longTasks: number;
+  droppedFrames: number;
+  frames: number;
+}
+
+class JankWatchdog {
+  private static instance: JankWatchdog;
+  private tickTimer: NodeJS.Timeout | null = null;
+  private frameRequest: number | null = null;
+  private appStateSubscription: { remove: () => void } | null = null;
+  private expectedAt: number = 0;
+  private lastFrameAt: number = 0;
+  private stalls: StallRecord[] = [];
+  private stallIndex: number = 0;
+  private stats: JankStats = this.emptyStats();
+
+  private constructor() {}
+
+  public static getInstance(): JankWatchdog {
+    if (!JankWatchdog.instance) {
+      JankWatchdog.instance = new JankWatchdog();
+    }
+    return JankWatchdog.instance;
+  }
+
+  /**
+   * Start measuring while the app is in the foreground
+   */
+  public start(): void {
+    if (this.appStateSubscription) return;
+
+    this.appStateSubscription = AppState.addEventListener('change', this.handleAppStateChange);
+    if (AppState.currentState === 'active') {
+      this.resume();
+    }
+  }
+
+  /**
+   * Stop measuring
+   */
+  public stop(): void {
+    this.appStateSubscription?.remove();
+    this.appStateSubscription = null;
+    this.pause();
+  }
+
+  /**
+   * Recent stalls, oldest first
+   */
+  public getRecentStalls(): StallRecord[] {
+    if (this.stalls.length < MAX_STALLS) {
+      return this.stalls.slice();
+    }
+    return [...this.stalls.slice(this.stallIndex), ...this.stalls.slice(0, this.stallIndex)];
+  }
+
+  /**
+   * Totals since start or the last reset
+   */
+  public getStats(): JankStats {
+    return { ...this.stats };
+  }
+
+  /**
+   * Clear stalls and totals, e.g. before a benchmark run
+   */
+  public reset(): void {
+    const running = this.stats.running;
+    this.stalls = [];
+    this.stallIndex = 0;
+    this.stats = { ...this.emptyStats(), running };
+  }
+
+  /**
+   * Human readable stall report for log export
+   */
+  public formatReport(): string {
+    const lines = [
+      `Jank report: ${this.stats.longTasks} long tasks, max lag ${Math.round(this.stats.maxLagMs)}ms, ` +
+        `${this.stats.droppedFrames}/${this.stats.frames} frames dropped`
+    ];
+    for (const stall of this.getRecentStalls()) {
+      const blame = [...stall.openSpans, ...stall.overlappingSpans];
+      lines.push(`${new Date(stall.at).toISOString()} ${Math.round(stall.durationMs)}ms ${blame.length ? blame.join(', ') : '(no active span)'}`);
+    }
+    return lines.join('\n');
+  }
+
+  private handleAppStateChange = (state: AppStateStatus): void => {
+    // Timers and frames are throttled in the background, lag there is meaningless
+    if (state === 'active') {
+      this.resume();
+    } else {
+      this.pause();
+    }
+  };
+
+  private resume(): void {
+    if (this.stats.running) return;
+    this.stats.running = true;
+
+    this.expectedAt = performance.now() + TICK_MS;
+    this.tickTimer = setTimeout(this.tick, TICK_MS);
+
+    if (typeof requestAnimationFrame === 'function') {
+      this.lastFrameAt = 0;
+      this.frameRequest = requestAnimationFrame(this.frame);
+    }
+  }
+
+  private pause(): void {
+    this.stats.running = false;
+    if (this.tickTimer) {
+      clearTimeout(this.tickTimer);
+      this.tickTimer = null;
+    }
+    if (this.frameRequest !== null) {
+      cancelAnimationFrame(this.frameRequest);
+      this.frameRequest = null;
+    }
+  }
+
+  /**
+   * Timer tick, lateness is event-loop lag
+   */
+  private tick = (): void => {
+    const now = performance.now();
+    const lag = Math.max(0, now - this.expectedAt);
+
+    this.stats.samples++;
+    this.stats.totalLagMs += lag;
+    this.stats.maxLagMs = Math.max(this.stats.maxLagMs, lag);
+    metrics.observe('jank.event_loop_lag_ms', lag);
+
+    if (lag >= LONG_TASK_MS) {
+      this.recordStall(now - lag, now, lag);
+    }
+
+    this.expectedAt = now + TICK_MS;
+    this.tickTimer = setTimeout(this.tick, TICK_MS);
+  };
+
+  /**
+   * Frame callback, gaps longer than a frame are dropped frames
+   */
+  private frame = (timestamp: number): void => {
+    if (this.lastFrameAt > 0) {
+      const missed = Math.floor((timestamp - this.lastFrameAt) / FRAME_MS) - 1;
+      this.stats.frames += 1 + Math.max(0, missed);
+      if (missed > 0) {
+        this.stats.droppedFrames += missed;
+        metrics.increment('jank.dropped_frames', missed);
+      }
+    }
+    this.lastFrameAt = timestamp;
+    this.frameRequest = requestAnimationFrame(this.frame);
+  };
+
+  /**
+   * Keep a stall in the ring buffer, charged to the spans active during it
+   */
+  private recordStall(startTime: number, endTime: number, durationMs: number): void {
+    const openSpans = tracing.getOpenSpans().map(span => span.name);
+    const overlappingSpans = tracing.getSpansOverlapping(startTime, endTime)
+      .map(record => record.name)
+      .filter(name => !openSpans.includes(name));
+
+    const stall: StallRecord = {
+      at: Date.now() - (endTime - startTime),
+      durationMs,
+      openSpans,
+      overlappingSpans
+    };
+
+    if (this.stalls.length < MAX_STALLS) {
+      this.stalls.push(stall);
+    } else {
+      this.stalls[this.stallIndex] = stall;
+      this.stallIndex = (this.stallIndex + 1) % MAX_STALLS;
+    }
+
+    this.stats.longTasks++;
+    metrics.increment('jank.long_tasks');
+
+    // Charge the stall to the innermost open span as well
+    const current = tracing.getCurrentSpan();
+    if (current) {
+      current.addCount('jank.stall_ms', durationMs);
+    }
+
+    if (durationMs >= LOGGED_STALL_MS) {
+      const blame = [...openSpans, ...overlappingSpans];
+      logger.warn(`JS thread stalled for ${Math.round(durationMs)}ms during ${blame.length ? blame.join(', ') : 'unattributed work'}`);
+    }
+  }
+
+  private emptyStats(): JankStats {
+    return { running: false, samples: 0, maxLagMs: 0, totalLagMs: 0, longTasks: 0, droppedFrames: 0, frames: 0 };
+  }
+}
+
+// Export singleton instance
+export const jankWatchdog = JankWatchdog.getInstance();
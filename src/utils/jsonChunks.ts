@@ -0,0 +1,95 @@
+/**
+ * Chunked JSON parsing
+ * Parses large JSON arrays element by element so the work can be time-sliced
+ */
+
+/**
+ * Generator that parses a JSON array one top-level element at a time
+ * Yields after every element; non-array documents fall back to a single JSON.parse
+ * @param text JSON text, usually a legacy AsyncStorage blob
+ * @returns The parsed array
+ */
+export function* parseJsonArrayInSlices<T>(text: string): Generator<void, T[], unknown> {
+  let index = skipWhitespace(text, 0);
+
+  if (text[index] !== '[') {
+    yield;
+    return JSON.parse(text);
+  }
+
+  const results: T[] = [];
+  index = skipWhitespace(text, index + 1);
+
+  if (text[index] === ']') {
+    return results;
+  }
+
+  while (index < text.length) {
+    const end = findElementEnd(text, index);
+    results.push(JSON.parse(text.slice(index, end)));
+    yield;
+
+    index = skipWhitespace(text, end);
+    if (text[index] === ']') {
+      return results;
+    }
+    if (text[index] !== ',') {
+      throw new SyntaxError(`Unexpected character '${text[index]}' at position ${index} in JSON array`);
+    }
+    index = skipWhitespace(text, index + 1);
+  }
+
+  throw new SyntaxError('Unterminated JSON array');
+}
+
+/**
+ * Skip JSON whitespace
+ */
+const skipWhitespace = (text: string, index: number): number => {
+  while (index < text.length) {
+    const char = text.charCodeAt(index);
+    // space, tab, newline, carriage return
+    if (char !== 32 && char !== 9 && char !== 10 && char !== 13) {
+      break;
+    }
+    index++;
+  }
+  return index;
+};
+
+/**
+ * Find the end of the array element starting at index (exclusive)
+ * Tracks nesting depth and string literals so commas inside values are ignored
+ */
+const findElementEnd = (text: string, index: number): number => {
+  let depth = 0;
+  let inString = false;
+
+  for (let i = index; i < text.length; i++) {
+    const char = text[i];
+
+    if (inString) {
+      if (char === '\\') {
+        i++;
+      } else if (char === '"') {
+        inString = false;
+      }
+      continue;
+    }
+
+    if (char === '"') {
+      inString = true;
+    } else if (char === '{' || char === '[') {
+      depth++;
+    } else if (char === '}' || char === ']') {
+      if (depth === 0) {
+        return i;
+      }
+      depth--;
+    } else if (char === ',' && depth === 0) {
+      return i;
+    }
+  }
+
+  throw new SyntaxError('Unterminated JSON array element');
+};
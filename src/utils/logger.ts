@@ -4,8 +4,11 @@
  */
 
 import { LogLevel } from '../types';
-import * as FileSystem from 'expo-file-system';
 import Constants from 'expo-constants';
+import { instrumentFileSystem } from './io';
+
+// Instrumented native I/O, see utils/io
+const FileSystem = instrumentFileSystem('logger');
 
 // Default configuration
 const DEFAULT_LOG_LEVEL = LogLevel.INFO;
@@ -196,6 +199,16 @@ class Logger {
     }
   }
 
+  /**
+   * Rotate the log file if it has grown past the size limit
+   */
+  public async rotateIfNeeded(): Promise<void> {
+    const fileInfo = await FileSystem.getInfoAsync(LOG_FILE_PATH);
+    if (fileInfo.exists && fileInfo.size > MAX_LOG_FILE_SIZE) {
+      await this.rotateLogFile();
+    }
+  }
+
   /**
    * Rotate log file when it gets too large
    */
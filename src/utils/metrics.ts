@@ -0,0 +1,107 @@
+/**
+ * Metrics utility
+ * In-process counters, gauges and value summaries for runtime diagnostics
+ */
+
+export interface MetricSummary {
+  count: number;
+  sum: number;
+  min: number;
+  max: number;
+}
+
+export interface MetricsSnapshot {
+  counters: Record<string, number>;
+  gauges: Record<string, number>;
+  summaries: Record<string, MetricSummary>;
+}
+
+class Metrics {
+  private static instance: Metrics;
+  private counters: Map<string, number> = new Map();
+  private gauges: Map<string, number> = new Map();
+  private summaries: Map<string, MetricSummary> = new Map();
+
+  private constructor() {}
+
+  public static getInstance(): Metrics {
+    if (!Metrics.instance) {
+      Metrics.instance = new Metrics();
+    }
+    return Metrics.instance;
+  }
+
+  /**
+   * Add to a counter
+   */
+  public increment(name: string, by: number = 1): void {
+    this.counters.set(name, (this.counters.get(name) || 0) + by);
+  }
+
+  /**
+   * Get a counter value
+   */
+  public getCounter(name: string): number {
+    return this.counters.get(name) || 0;
+  }
+
+  /**
+   * Set a gauge to its current value
+   */
+  public setGauge(name: string, value: number): void {
+    this.gauges.set(name, value);
+  }
+
+  /**
+   * Record a value such as a duration or a byte count
+   */
+  public observe(name: string, value: number): void {
+    const summary = this.summaries.get(name);
+    if (!summary) {
+      this.summaries.set(name, { count: 1, sum: value, min: value, max: value });
+      return;
+    }
+
+    summary.count++;
+    summary.sum += value;
+    summary.min = Math.min(summary.min, value);
+    summary.max = Math.max(summary.max, value);
+  }
+
+  /**
+   * Ratio of two counters, e.g. cache hits over lookups
+   * @returns The ratio, or 0 when the denominator is empty
+   */
+  public ratio(numerator: string, denominator: string): number {
+    const total = this.getCounter(denominator);
+    return total > 0 ? this.getCounter(numerator) / total : 0;
+  }
+
+  /**
+   * Copy of all current values
+   */
+  public getSnapshot(): MetricsSnapshot {
+    const summaries: Record<string, MetricSummary> = {};
+    this.summaries.forEach((summary, name) => {
+      summaries[name] = { ...summary };
+    });
+
+    return {
+      counters: Object.fromEntries(this.counters),
+      gauges: Object.fromEntries(this.gauges),
+      summaries
+    };
+  }
+
+  /**
+   * Clear all values
+   */
+  public reset(): void {
+    this.counters.clear();
+    this.gauges.clear();
+    this.summaries.clear();
+  }
+}
+
+// Export singleton instance
+export const metrics = Metrics.getInstance();
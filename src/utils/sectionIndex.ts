@@ -0,0 +1,163 @@
+/**
+ * Section index
+ * Sorted, lettered sections over a list with fixed row heights, for an index rail
+ *
+ * Every row has a known height, so the offset of each row and of each section
+ * is computed in the same pass that builds the list. Jumping to a letter is then
+ * one scrollToOffset, and the list only renders the rows around the destination.
+ */
+
+// Constants
+export const OTHER_SECTION_LABEL = '#';
+const DEFAULT_CHUNK_SIZE = 250;
+
+export type SectionedRow<T> =
+  | { type: 'header'; label: string }
+  | { type: 'item'; item: T };
+
+export interface Section {
+  label: string;
+  rowIndex: number; // index of the section's header row
+  offset: number; // scroll offset of the header row
+}
+
+export interface SectionedList<T> {
+  rows: SectionedRow<T>[];
+  rowOffsets: Float64Array; // offset of each row, plus the total height at the end
+  sections: Section[];
+}
+
+export interface SectionLayout {
+  itemHeight: number;
+  headerHeight: number;
+}
+
+type Compare = (a: string, b: string) => number;
+
+/**
+ * Compare strings in the user's locale, ignoring case and accents, with numbers in numeric order
+ */
+export const createLocaleCompare = (): Compare => {
+  if (typeof Intl !== 'undefined' && Intl.Collator) {
+    return new Intl.Collator(undefined, { sensitivity: 'base', numeric: true }).compare;
+  }
+  return (a, b) => a.localeCompare(b);
+};
+
+/**
+ * Key an item sorts by, without the surrounding whitespace that would otherwise sort it apart from its section
+ */
+export const normalizeSortKey = (key: string): string => key.trim();
+
+/**
+ * Section a sort key belongs to: its first letter without accents, or # for digits, symbols and scripts without case
+ */
+export const getSectionLabel = (key: string): string => {
+  const first = normalizeSortKey(key).normalize('NFD').charAt(0);
+  const upper = first.toLocaleUpperCase();
+  return upper !== first.toLocaleLowerCase() ? upper.charAt(0) : OTHER_SECTION_LABEL;
+};
+
+/**
+ * Stable merge sort that yields after each sorted run and every chunkSize merged items
+ * Runs of chunkSize are sorted in one step each, then merged pairwise
+ */
+function* sortInSlices(order: number[], compare: (a: number, b: number) => number, chunkSize: number): Generator<void, number[], unknown> {
+  for (let start = 0; start < order.length; start += chunkSize) {
+    const run = order.slice(start, start + chunkSize).sort(compare);
+    for (let i = 0; i < run.length; i++) {
+      order[start + i] = run[i];
+    }
+    yield;
+  }
+
+  let source = order;
+  let target: number[] = new Array(order.length);
+  for (let width = chunkSize; width < order.length; width *= 2) {
+    let merged = 0;
+    for (let start = 0; start < source.length; start += 2 * width) {
+      const middle = Math.min(start + width, source.length);
+      const end = Math.min(start + 2 * width, source.length);
+      let a = start;
+      let b = middle;
+      for (let i = start; i < end; i++) {
+        target[i] = b >= end || (a < middle && compare(source[a], source[b]) <= 0) ? source[a++] : source[b++];
+        if (++merged % chunkSize === 0) {
+          yield;
+        }
+      }
+    }
+    [source, target] = [target, source];
+  }
+  return source;
+}
+
+/**
+ * Sort items by a key and split them into lettered sections, # last
+ * A generator for the task scheduler, yielding every chunkSize items so a large library never blocks a frame
+ * @param keyOf Text the item sorts and is sectioned by, usually its title
+ */
+export function* buildSectionedListInSlices<T>(
+  items: T[],
+  keyOf: (item: T) => string,
+  layout: SectionLayout,
+  compare: Compare = createLocaleCompare(),
+  chunkSize = DEFAULT_CHUNK_SIZE
+): Generator<void, SectionedList<T>, unknown> {
+  const keys: string[] = new Array(items.length);
+  const labels: string[] = new Array(items.length);
+  for (let i = 0; i < items.length; i++) {
+    keys[i] = normalizeSortKey(keyOf(items[i]));
+    labels[i] = getSectionLabel(keys[i]);
+    if (i % chunkSize === chunkSize - 1) {
+      yield;
+    }
+  }
+
+  // Sort indices rather than items, so keys and labels are computed once per item
+  // Sections sort first, so a key the collator places among another letter's (Æ among A) cannot split one
+  const order = yield* sortInSlices(items.map((_, index) => index), (a, b) => {
+    const aOther = labels[a] === OTHER_SECTION_LABEL;
+    const bOther = labels[b] === OTHER_SECTION_LABEL;
+    if (aOther !== bOther) return aOther ? 1 : -1;
+    return compare(labels[a], labels[b]) || compare(keys[a], keys[b]);
+  }, chunkSize);
+
+  const rows: SectionedRow<T>[] = [];
+  const sections: Section[] = [];
+  const rowOffsets = new Float64Array(items.length + order.length + 1);
+  let offset = 0;
+
+  for (const index of order) {
+    const label = labels[index];
+
+    // Labels that compare equal (e and E, é and E) share a section
+    const current = sections[sections.length - 1];
+    if (!current || (label !== current.label && compare(label, current.label) !== 0)) {
+      sections.push({ label, rowIndex: rows.length, offset });
+      rowOffsets[rows.length] = offset;
+      rows.push({ type: 'header', label });
+      offset += layout.headerHeight;
+    }
+
+    rowOffsets[rows.length] = offset;
+    rows.push({ type: 'item', item: items[index] });
+    offset += layout.itemHeight;
+
+    if (rows.length % chunkSize === 0) {
+      yield;
+    }
+  }
+
+  rowOffsets[rows.length] = offset;
+  return { rows, rowOffsets: rowOffsets.subarray(0, rows.length + 1), sections };
+}
+
+/**
+ * FlatList getItemLayout for a sectioned list
+ */
+export const getSectionedRowLayout = <T>(list: SectionedList<T>, index: number) => ({
+  length: list.rowOffsets[index + 1] - list.rowOffsets[index],
+  offset: list.rowOffsets[index],
+  index
+});
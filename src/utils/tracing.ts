@@ -0,0 +1,205 @@
+/**
+ * Tracing utility
+ * Lightweight spans for attributing work (sync, import, search, playback) to features
+ *
+ * JS has no async context here, so the "current" span is the most recently
+ * started span that is still open. That is exact for synchronous work and a
+ * good approximation for the short async flows the app traces.
+ */
+
+export type SpanAttributeValue = string | number | boolean;
+
+export interface SpanRecord {
+  id: number;
+  name: string;
+  parentId?: number;
+  startTime: number;
+  endTime: number;
+  durationMs: number;
+  attributes: Record<string, SpanAttributeValue>;
+}
+
+export type SpanEndListener = (record: SpanRecord) => void;
+
+// Finished spans kept for diagnostics export
+const MAX_FINISHED_SPANS = 500;
+
+export class Span {
+  public readonly id: number;
+  public readonly name: string;
+  public readonly parentId?: number;
+  public readonly startTime: number;
+  public readonly attributes: Record<string, SpanAttributeValue>;
+  private ended: boolean = false;
+
+  constructor(private tracer: Tracer, id: number, name: string, parentId: number | undefined, attributes: Record<string, SpanAttributeValue>) {
+    this.id = id;
+    this.name = name;
+    this.parentId = parentId;
+    this.startTime = performance.now();
+    this.attributes = { ...attributes };
+  }
+
+  /**
+   * Set an attribute on the span
+   */
+  public setAttribute(key: string, value: SpanAttributeValue): void {
+    this.attributes[key] = value;
+  }
+
+  /**
+   * Add to a numeric attribute, e.g. I/O calls made within the span
+   */
+  public addCount(key: string, by: number = 1): void {
+    const current = this.attributes[key];
+    this.attributes[key] = (typeof current === 'number' ? current : 0) + by;
+  }
+
+  /**
+   * Finish the span, later calls are ignored
+   */
+  public end(): void {
+    if (this.ended) return;
+    this.ended = true;
+    this.tracer.finish(this);
+  }
+}
+
+class Tracer {
+  private static instance: Tracer;
+  private nextId: number = 1;
+  private openSpans: Span[] = [];
+  private finished: SpanRecord[] = [];
+  private endListeners: Set<SpanEndListener> = new Set();
+
+  private constructor() {}
+
+  public static getInstance(): Tracer {
+    if (!Tracer.instance) {
+      Tracer.instance = new Tracer();
+    }
+    return Tracer.instance;
+  }
+
+  /**
+   * Start a span, the current span becomes its parent
+   */
+  public startSpan(name: string, attributes: Record<string, SpanAttributeValue> = {}): Span {
+    const parent = this.getCurrentSpan();
+    const span = new Span(this, this.nextId++, name, parent?.id, attributes);
+    this.openSpans.push(span);
+    return span;
+  }
+
+  /**
+   * Run a function inside a span that ends when the function settles
+   */
+  public async trace<T>(name: string, fn: (span: Span) => Promise<T> | T, attributes: Record<string, SpanAttributeValue> = {}): Promise<T> {
+    const span = this.startSpan(name, attributes);
+    try {
+      return await fn(span);
+    } catch (error) {
+      span.setAttribute('error', true);
+      throw error;
+    } finally {
+      span.end();
+    }
+  }
+
+  /**
+   * Record a span after the fact, for work measured elsewhere (React commits, task slices)
+   */
+  public recordSpan(name: string, startTime: number, endTime: number, attributes: Record<string, SpanAttributeValue> = {}): void {
+    this.push({
+      id: this.nextId++,
+      name,
+      parentId: this.getCurrentSpan()?.id,
+      startTime,
+      endTime,
+      durationMs: endTime - startTime,
+      attributes: { ...attributes }
+    });
+  }
+
+  /**
+   * Finished spans that overlap a time window, e.g. the span that caused a stall
+   */
+  public getSpansOverlapping(startTime: number, endTime: number): SpanRecord[] {
+    return this.finished.filter(record => record.endTime >= startTime && record.startTime <= endTime);
+  }
+
+  /**
+   * The most recently started span that is still open
+   */
+  public getCurrentSpan(): Span | undefined {
+    return this.openSpans[this.openSpans.length - 1];
+  }
+
+  /**
+   * All open spans, oldest first
+   */
+  public getOpenSpans(): Span[] {
+    return this.openSpans.slice();
+  }
+
+  /**
+   * Recently finished spans, oldest first
+   */
+  public getFinishedSpans(): SpanRecord[] {
+    return this.finished.slice();
+  }
+
+  /**
+   * Subscribe to finished spans
+   * Returns an unsubscribe function
+   */
+  public onSpanEnd(listener: SpanEndListener): () => void {
+    this.endListeners.add(listener);
+    return () => {
+      this.endListeners.delete(listener);
+    };
+  }
+
+  /**
+   * Drop finished spans
+   */
+  public clear(): void {
+    this.finished = [];
+  }
+
+  /**
+   * Called by Span.end()
+   */
+  public finish(span: Span): void {
+    const index = this.openSpans.lastIndexOf(span);
+    if (index !== -1) {
+      this.openSpans.splice(index, 1);
+    }
+
+    const endTime = performance.now();
+    this.push({
+      id: span.id,
+      name: span.name,
+      parentId: span.parentId,
+      startTime: span.startTime,
+      endTime,
+      durationMs: endTime - span.startTime,
+      attributes: span.attributes
+    });
+  }
+
+  /**
+   * Keep a finished span and notify listeners
+   */
+  private push(record: SpanRecord): void {
+    this.finished.push(record);
+    if (this.finished.length > MAX_FINISHED_SPANS) {
+      this.finished.shift();
+    }
+
+    this.endListeners.forEach(listener => listener(record));
+  }
+}
+
+// Export singleton instance
+export const tracing = Tracer.getInstance();